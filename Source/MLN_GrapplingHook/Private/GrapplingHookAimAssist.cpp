@@ -0,0 +1,197 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookAimAssist.h"
+
+FGrapplingHookAimAssist::FGrapplingHookAimAssist()
+	: BuiltConeDegrees(-1.f)
+	, BuiltRings(-1)
+	, BuiltRaysPerRing(-1)
+	, SweepStart(FVector::ZeroVector)
+	, SweepDirection(FVector::ForwardVector)
+	, SweepMaxDistance(0.f)
+	, bSweepTraceComplex(false)
+	, SweepTime(0.0)
+	, SweepId(0)
+	, SweepFirstRing(0)
+	, SweepRing(0)
+	, PendingRays(0)
+	, bSweepStarted(false)
+	, bSelection(false)
+	, bSelectionPossibleValidHit(false)
+{
+}
+void FGrapplingHookAimAssist::BuildPattern(const float ConeDegrees, const int32 Rings, const int32 RaysPerRing)
+{
+	const float Cone = FMath::Clamp(ConeDegrees, 0.f, 89.f);
+	const int32 NumRings = Cone > 0.f ? FMath::Clamp(Rings, 0, MaxRings) : 0;
+	const int32 NumRaysPerRing = FMath::Clamp(RaysPerRing, 1, MaxRaysPerRing);
+	if (Cone == BuiltConeDegrees && NumRings == BuiltRings && NumRaysPerRing == BuiltRaysPerRing)
+	{
+		return;
+	}
+	BuiltConeDegrees = Cone;
+	BuiltRings = NumRings;
+	BuiltRaysPerRing = NumRaysPerRing;
+
+	Rays.Reset();
+	RingStarts.Reset();
+	RingStarts.Add(0);
+	FGrapplingHookAimRay Center;
+	Center.LocalDirection = FVector::ForwardVector;
+	Center.Ring = 0;
+	Rays.Add(Center);
+	for (int32 Ring = 1; Ring <= NumRings; ++Ring)
+	{
+		RingStarts.Add(Rays.Num());
+		const float Angle = FMath::DegreesToRadians(Cone * Ring / NumRings);
+		//Odd rings are rotated by half a step so that the rays of consecutive rings do not line up
+		const float Phase = (Ring & 1) ? PI / NumRaysPerRing : 0.f;
+		for (int32 Ray = 0; Ray < NumRaysPerRing; ++Ray)
+		{
+			const float Roll = Phase + (2.f * PI * Ray) / NumRaysPerRing;
+			FGrapplingHookAimRay RingRay;
+			RingRay.LocalDirection = FVector(FMath::Cos(Angle), FMath::Sin(Angle) * FMath::Cos(Roll), FMath::Sin(Angle) * FMath::Sin(Roll));
+			RingRay.Ring = Ring;
+			Rays.Add(RingRay);
+		}
+	}
+	RingStarts.Add(Rays.Num());
+
+	Hits.Reset();
+	Hits.SetNum(Rays.Num());
+	RayHits.Reset();
+	RayHits.SetNumZeroed(Rays.Num());
+	//Rays of the pending sweep changed, its results can not be matched anymore
+	++SweepId;
+	PendingRays = 0;
+	bSweepStarted = false;
+}
+int32 FGrapplingHookAimAssist::GetNumRays() const
+{
+	return Rays.Num();
+}
+int32 FGrapplingHookAimAssist::GetNumRings() const
+{
+	return FMath::Max(RingStarts.Num() - 1, 0);
+}
+int32 FGrapplingHookAimAssist::GetRingStart(const int32 Ring) const
+{
+	return RingStarts.IsValidIndex(Ring) ? RingStarts[Ring] : Rays.Num();
+}
+FVector FGrapplingHookAimAssist::GetRayDirection(const int32 RayIndex, const FMatrix& AimFrame) const
+{
+	return AimFrame.TransformVector(Rays[RayIndex].LocalDirection);
+}
+FMatrix FGrapplingHookAimAssist::MakeAimFrame(const FVector& Direction)
+{
+	return FRotationMatrix::MakeFromX(Direction.GetSafeNormal(SMALL_NUMBER, FVector::ForwardVector));
+}
+bool FGrapplingHookAimAssist::CanReuse(const FVector& Start, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, const double Time, const float ReuseDistance, const float ReuseDegrees, const float ReuseTime) const
+{
+	if (!bSweepStarted || MaxDistance != SweepMaxDistance || bTraceComplex != bSweepTraceComplex || Time - SweepTime > ReuseTime)
+	{
+		return false;
+	}
+	if (FVector::DistSquared(Start, SweepStart) > FMath::Square(ReuseDistance))
+	{
+		return false;
+	}
+	return FVector::DotProduct(Direction.GetSafeNormal(), SweepDirection) >= FMath::Cos(FMath::DegreesToRadians(ReuseDegrees));
+}
+void FGrapplingHookAimAssist::BeginSweep(const FVector& Start, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, const double Time, const bool bRingByRing)
+{
+	++SweepId;
+	SweepStart = Start;
+	SweepDirection = Direction.GetSafeNormal(SMALL_NUMBER, FVector::ForwardVector);
+	SweepMaxDistance = MaxDistance;
+	bSweepTraceComplex = bTraceComplex;
+	SweepTime = Time;
+	SweepFirstRing = 0;
+	SweepRing = bRingByRing ? 0 : FMath::Max(GetNumRings() - 1, 0);
+	PendingRays = GetRingStart(SweepRing + 1) - GetRingStart(0);
+	bSweepStarted = true;
+	for (int32 RayIndex = 0; RayIndex < RayHits.Num(); ++RayIndex)
+	{
+		RayHits[RayIndex] = false;
+	}
+}
+bool FGrapplingHookAimAssist::BeginNextRing()
+{
+	if (!bSweepStarted || PendingRays > 0 || SweepRing + 1 >= GetNumRings())
+	{
+		return false;
+	}
+	++SweepRing;
+	SweepFirstRing = SweepRing;
+	PendingRays = GetRingStart(SweepRing + 1) - GetRingStart(SweepRing);
+	return true;
+}
+int32 FGrapplingHookAimAssist::GetSweepFirstRing() const
+{
+	return SweepFirstRing;
+}
+int32 FGrapplingHookAimAssist::GetSweepRing() const
+{
+	return SweepRing;
+}
+uint32 FGrapplingHookAimAssist::GetTraceUserData(const int32 RayIndex) const
+{
+	return (static_cast<uint32>(SweepId) << 16) | static_cast<uint32>(RayIndex);
+}
+bool FGrapplingHookAimAssist::StoreTraceResult(const uint32 UserData, const FHitResult* const Hit)
+{
+	const int32 RayIndex = static_cast<int32>(UserData & 0xFFFF);
+	if ((UserData >> 16) != SweepId || PendingRays <= 0 || !Rays.IsValidIndex(RayIndex) || Rays[RayIndex].Ring < SweepFirstRing || Rays[RayIndex].Ring > SweepRing)
+	{
+		return false;
+	}
+	RayHits[RayIndex] = Hit != nullptr;
+	if (Hit)
+	{
+		Hits[RayIndex] = *Hit;
+	}
+	return --PendingRays == 0;
+}
+const FHitResult* FGrapplingHookAimAssist::GetRayHit(const int32 RayIndex) const
+{
+	if (!RayHits.IsValidIndex(RayIndex) || !RayHits[RayIndex])
+	{
+		return nullptr;
+	}
+	const int32 Ring = Rays[RayIndex].Ring;
+	return Ring < SweepFirstRing || (Ring <= SweepRing && PendingRays == 0) ? &Hits[RayIndex] : nullptr;
+}
+const FVector& FGrapplingHookAimAssist::GetSweepStart() const
+{
+	return SweepStart;
+}
+const FVector& FGrapplingHookAimAssist::GetSweepDirection() const
+{
+	return SweepDirection;
+}
+float FGrapplingHookAimAssist::GetSweepMaxDistance() const
+{
+	return SweepMaxDistance;
+}
+bool FGrapplingHookAimAssist::IsSweepTraceComplex() const
+{
+	return bSweepTraceComplex;
+}
+void FGrapplingHookAimAssist::SetSelection(const FHitResult* const Hit, const bool bPossibleValidHit)
+{
+	bSelection = Hit != nullptr;
+	bSelectionPossibleValidHit = bSelection && bPossibleValidHit;
+	if (Hit)
+	{
+		SelectedHit = *Hit;
+	}
+}
+bool FGrapplingHookAimAssist::GetSelection(FHitResult& OutHit, bool& bOutPossibleValidHit) const
+{
+	bOutPossibleValidHit = bSelectionPossibleValidHit;
+	if (bSelection)
+	{
+		OutHit = SelectedHit;
+	}
+	return bSelection;
+}
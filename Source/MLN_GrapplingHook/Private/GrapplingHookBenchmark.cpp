@@ -0,0 +1,508 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookBenchmark.h"
+#include "GrapplingHookComponent.h"
+#include "GrapplingHookWorldData.h"
+#include "MLN_GrapplingHook.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "../Plugins/Runtime/CableComponent/Source/CableComponent/Classes/CableComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Containers/Ticker.h"
+#include "Misc/App.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/EngineVersion.h"
+#include "UObject/UObjectGlobals.h"
+
+/* Frames scripted after the spawn of every step before the measures start
+*/
+static const int32 GrapplingHookBenchmarkWarmupFrames = 30;
+/* Frames of a scripted launch -> swing/pull -> stop -> retract/cooldown cycle
+*/
+static const int32 GrapplingHookBenchmarkCycleFrames = 120;
+/* Frame of the cycle when the grapple is stopped
+*/
+static const int32 GrapplingHookBenchmarkStopFrame = 90;
+/* Distance between two grapplers of the benchmark grid
+*/
+static const float GrapplingHookBenchmarkSpacing = 400.f;
+/* Height of the ceiling used as swing and launch target
+*/
+static const float GrapplingHookBenchmarkCeilingHeight = 800.f;
+
+/*
+* State of the running benchmark
+*/
+class FGrapplingHookBenchmarkRun
+{
+public:
+	FGrapplingHookBenchmarkRun()
+		: FramesPerStep(0)
+		, bQuitWhenDone(false)
+		, StepIndex(0)
+		, InitialWorkers(0)
+		, Frame(0)
+		, LastFrameTime(0.0)
+		, PhysicsStartTime(0.0)
+		, PhysicsEndTime(0.0)
+		, Cube(nullptr)
+	{
+	}
+
+	TWeakObjectPtr<UWorld> World;
+	TArray<int32> Counts;
+	/* Values of GrapplingHook.UpdateWorkers measured for every count
+	*/
+	TArray<int32> Workers;
+	int32 FramesPerStep;
+	bool bQuitWhenDone;
+	FString Session;
+	int32 StepIndex;
+	/* Value of GrapplingHook.UpdateWorkers before the run, restored when it stops
+	*/
+	int32 InitialWorkers;
+	int32 Frame;
+	double LastFrameTime;
+	double PhysicsStartTime;
+	double PhysicsEndTime;
+	FGrapplingHookBenchmarkTickFunction PhysicsStartTick;
+	FGrapplingHookBenchmarkTickFunction PhysicsEndTick;
+	UStaticMesh* Cube;
+	/* Floor and ceiling, kept for the whole run
+	*/
+	TArray<TWeakObjectPtr<AActor>> Environment;
+	/* Characters and pull targets of the current step
+	*/
+	TArray<TWeakObjectPtr<AActor>> StepActors;
+	TArray<TWeakObjectPtr<UGrapplingHookComponent>> Grapplers;
+	TArray<FGrapplingHookBenchmarkStep> Steps;
+
+	/* Spawns the floor and the ceiling large enough for the biggest step
+	*/
+	void SpawnEnvironment();
+	/* Spawns the grapplers of the current step
+	*/
+	void SpawnStep(const int32 Count);
+	/* Destroys the grapplers of the current step
+	*/
+	void DestroyStep();
+	/* Scripts the grapple inputs of all grapplers for the current frame
+	*/
+	void ScriptInputs(FGrapplingHookBenchmarkStep* const Step);
+	/* Returns the number of steps of the run (every count with every worker value)
+	*/
+	int32 GetNumSteps() const;
+	/* Returns the grapplers per row of the grid
+	*/
+	int32 GetGridSize() const;
+	AStaticMeshActor* SpawnCube(const FVector& Location, const FVector& Scale, const bool bSimulatePhysics);
+};
+
+static TUniquePtr<FGrapplingHookBenchmarkRun> GrapplingHookBenchmarkRun;
+static FDelegateHandle GrapplingHookBenchmarkTickerHandle;
+
+static IConsoleVariable* GetGrapplingHookUpdateWorkers()
+{
+	return IConsoleManager::Get().FindConsoleVariable(TEXT("GrapplingHook.UpdateWorkers"));
+}
+static void ParseGrapplingHookBenchmarkList(const FString& Text, const int32 MinValue, TArray<int32>& OutValues)
+{
+	TArray<FString> Values;
+	Text.ParseIntoArray(Values, TEXT(","));
+	for (const FString& Value : Values)
+	{
+		const int32 Number = FCString::Atoi(*Value);
+		if (Number >= MinValue)
+		{
+			OutValues.Add(Number);
+		}
+	}
+}
+
+static void OnGrapplingHookBenchmarkCommand(const TArray<FString>& Args, UWorld* World)
+{
+	if (Args.Num() > 0 && Args[0].Equals(TEXT("Stop"), ESearchCase::IgnoreCase))
+	{
+		FGrapplingHookBenchmark::Stop();
+		return;
+	}
+
+	TArray<int32> Counts;
+	ParseGrapplingHookBenchmarkList(Args.Num() > 0 ? Args[0] : FString(TEXT("10,50,100,250,500,1000")), 1, Counts);
+	const int32 FramesPerStep = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 300;
+	const bool bQuitWhenDone = Args.Num() > 2 && FCString::Atoi(*Args[2]) != 0;
+	TArray<int32> Workers;
+	if (Args.Num() > 3)
+	{
+		ParseGrapplingHookBenchmarkList(Args[3], 0, Workers);
+	}
+	FGrapplingHookBenchmark::Start(World, Counts, FramesPerStep, bQuitWhenDone, Workers);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GrapplingHookBenchmarkCommand(
+	TEXT("GrapplingHook.Benchmark"),
+	TEXT("Runs the grappling hook scalability benchmark: GrapplingHook.Benchmark [Counts=10,50,100,250,500,1000] [FramesPerStep=300] [QuitWhenDone=0] [Workers=current GrapplingHook.UpdateWorkers, e.g. 1,2,4,8,16], or GrapplingHook.Benchmark Stop. Results are written to Saved/GrapplingHook/"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&OnGrapplingHookBenchmarkCommand));
+
+void FGrapplingHookBenchmarkTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (OutTime)
+	{
+		*OutTime = FPlatformTime::Seconds();
+	}
+}
+FString FGrapplingHookBenchmarkTickFunction::DiagnosticMessage()
+{
+	return TEXT("FGrapplingHookBenchmarkTickFunction");
+}
+
+FGrapplingHookBenchmarkStep::FGrapplingHookBenchmarkStep()
+{
+	Grapplers = 0;
+	Workers = 0;
+	Frames = 0;
+	SpawnMs = 0.0;
+	FrameMsSum = 0.0;
+	FrameMsMax = 0.0;
+	GameThreadMsSum = 0.0;
+	GameThreadMsMax = 0.0;
+	PhysicsMsSum = 0.0;
+	PhysicsMsMax = 0.0;
+	ComputeMsSum = 0.0;
+	ComputeMsMax = 0.0;
+	MemoryStart = 0;
+	MemoryEnd = 0;
+	GCMs = 0.0;
+	Launches = 0;
+	Stops = 0;
+}
+
+int32 FGrapplingHookBenchmarkRun::GetNumSteps() const
+{
+	return Counts.Num() * Workers.Num();
+}
+int32 FGrapplingHookBenchmarkRun::GetGridSize() const
+{
+	int32 MaxCount = 1;
+	for (const int32 Count : Counts)
+	{
+		MaxCount = FMath::Max(MaxCount, Count);
+	}
+	return FMath::CeilToInt(FMath::Sqrt(static_cast<float>(MaxCount)));
+}
+AStaticMeshActor* FGrapplingHookBenchmarkRun::SpawnCube(const FVector& Location, const FVector& Scale, const bool bSimulatePhysics)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AStaticMeshActor* const Actor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator, SpawnParams);
+	if (Actor)
+	{
+		UStaticMeshComponent* const Mesh = Actor->GetStaticMeshComponent();
+		Mesh->SetMobility(EComponentMobility::Movable);
+		Mesh->SetStaticMesh(Cube);
+		Mesh->SetWorldScale3D(Scale);
+		Mesh->SetSimulatePhysics(bSimulatePhysics);
+	}
+	return Actor;
+}
+void FGrapplingHookBenchmarkRun::SpawnEnvironment()
+{
+	//Engine cube, 100 units wide
+	const float Size = (GetGridSize() + 2) * GrapplingHookBenchmarkSpacing;
+	const FVector Center(Size * 0.5f - GrapplingHookBenchmarkSpacing, Size * 0.5f - GrapplingHookBenchmarkSpacing, 0.f);
+	const FVector Scale(Size / 100.f, Size / 100.f, 1.f);
+	Environment.Add(SpawnCube(Center - FVector(0.f, 0.f, 50.f), Scale, false));
+	Environment.Add(SpawnCube(Center + FVector(0.f, 0.f, GrapplingHookBenchmarkCeilingHeight + 50.f), Scale, false));
+}
+void FGrapplingHookBenchmarkRun::SpawnStep(const int32 Count)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	const int32 GridSize = GetGridSize();
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FVector Location((Index % GridSize) * GrapplingHookBenchmarkSpacing, (Index / GridSize) * GrapplingHookBenchmarkSpacing, 100.f);
+		ACharacter* const Character = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+		if (!Character)
+		{
+			continue;
+		}
+		StepActors.Add(Character);
+		//Spawned characters have no controller, their movement would not run without it
+		Character->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+
+		//One grappler out of four aims at a light physics cube in front of it (pull), the others at the ceiling (swing/launch)
+		const bool bPull = (Index % 4) == 0;
+		if (bPull)
+		{
+			StepActors.Add(SpawnCube(Location + FVector(250.f, 0.f, -50.f), FVector(0.3f), true));
+		}
+
+		UCableComponent* const Cable = NewObject<UCableComponent>(Character, TEXT("BenchmarkCable"));
+		Cable->SetupAttachment(Character->GetCapsuleComponent());
+		Cable->SetRelativeRotation(FRotator(bPull ? -30.f : 60.f, 0.f, 0.f));
+		Cable->RegisterComponent();
+
+		//Registered on an actor that already begun play: the component begins play and initializes from its owner here
+		UGrapplingHookComponent* const Grappler = NewObject<UGrapplingHookComponent>(Character, TEXT("BenchmarkGrappler"));
+		Grappler->bDeferInitialization = false;
+		Grappler->RegisterComponent();
+		Grapplers.Add(Grappler);
+	}
+}
+void FGrapplingHookBenchmarkRun::DestroyStep()
+{
+	for (const TWeakObjectPtr<AActor>& Actor : StepActors)
+	{
+		if (Actor.IsValid())
+		{
+			Actor->Destroy();
+		}
+	}
+	StepActors.Reset();
+	Grapplers.Reset();
+}
+void FGrapplingHookBenchmarkRun::ScriptInputs(FGrapplingHookBenchmarkStep* const Step)
+{
+	for (int32 Index = 0; Index < Grapplers.Num(); ++Index)
+	{
+		UGrapplingHookComponent* const Grappler = Grapplers[Index].Get();
+		if (!Grappler)
+		{
+			continue;
+		}
+		//Cycles are staggered so that all the states are present in every frame
+		const int32 CycleFrame = (Frame + Index * 13) % GrapplingHookBenchmarkCycleFrames;
+		if (CycleFrame == 0)
+		{
+			Grappler->LaunchGrapple();
+			if (Step)
+			{
+				++Step->Launches;
+			}
+		}
+		else if (CycleFrame < GrapplingHookBenchmarkStopFrame)
+		{
+			Grappler->AddSwingingForce(FVector(1000.f, 0.f, 0.f), true);
+		}
+		else if (CycleFrame == GrapplingHookBenchmarkStopFrame)
+		{
+			Grappler->StopGrapple();
+			if (Step)
+			{
+				++Step->Stops;
+			}
+		}
+	}
+}
+
+void FGrapplingHookBenchmark::Start(UWorld* const World, const TArray<int32>& Counts, const int32 FramesPerStep, const bool bQuitWhenDone, const TArray<int32>& Workers)
+{
+	Stop();
+	if (!World || !World->PersistentLevel || Counts.Num() == 0 || FramesPerStep <= 0)
+	{
+		UE_LOG(LogGrapplingHook, Warning, TEXT("GrapplingHook.Benchmark: a game world, at least one grappler count and a positive frame count are required"));
+		return;
+	}
+	UStaticMesh* const Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!Cube)
+	{
+		UE_LOG(LogGrapplingHook, Warning, TEXT("GrapplingHook.Benchmark: /Engine/BasicShapes/Cube could not be loaded"));
+		return;
+	}
+
+	GrapplingHookBenchmarkRun = MakeUnique<FGrapplingHookBenchmarkRun>();
+	FGrapplingHookBenchmarkRun& Run = *GrapplingHookBenchmarkRun;
+	Run.World = World;
+	Run.Counts = Counts;
+	IConsoleVariable* const UpdateWorkers = GetGrapplingHookUpdateWorkers();
+	Run.InitialWorkers = UpdateWorkers ? UpdateWorkers->GetInt() : 0;
+	Run.Workers = Workers;
+	if (Run.Workers.Num() == 0)
+	{
+		Run.Workers.Add(Run.InitialWorkers);
+	}
+	Run.FramesPerStep = FramesPerStep;
+	Run.bQuitWhenDone = bQuitWhenDone;
+	Run.Session = FDateTime::Now().ToString();
+	Run.Cube = Cube;
+	Run.Steps.Reserve(Run.GetNumSteps());
+
+	//Physics time: from the start of the simulation to the end of its completion wait
+	Run.PhysicsStartTick.OutTime = &Run.PhysicsStartTime;
+	Run.PhysicsStartTick.bCanEverTick = true;
+	Run.PhysicsStartTick.bTickEvenWhenPaused = false;
+	Run.PhysicsStartTick.TickGroup = ETickingGroup::TG_StartPhysics;
+	Run.PhysicsStartTick.RegisterTickFunction(World->PersistentLevel);
+	Run.PhysicsStartTick.AddPrerequisite(World, World->StartPhysicsTickFunction);
+	Run.PhysicsEndTick.OutTime = &Run.PhysicsEndTime;
+	Run.PhysicsEndTick.bCanEverTick = true;
+	Run.PhysicsEndTick.bTickEvenWhenPaused = false;
+	Run.PhysicsEndTick.TickGroup = ETickingGroup::TG_EndPhysics;
+	Run.PhysicsEndTick.RegisterTickFunction(World->PersistentLevel);
+	Run.PhysicsEndTick.AddPrerequisite(World, World->EndPhysicsTickFunction);
+
+	Run.SpawnEnvironment();
+	GrapplingHookBenchmarkTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FGrapplingHookBenchmark::OnTicker));
+	UE_LOG(LogGrapplingHook, Log, TEXT("GrapplingHook.Benchmark: started, %d steps of %d frames"), Run.GetNumSteps(), FramesPerStep);
+}
+void FGrapplingHookBenchmark::Stop()
+{
+	if (!GrapplingHookBenchmarkRun.IsValid())
+	{
+		return;
+	}
+	FTicker::GetCoreTicker().RemoveTicker(GrapplingHookBenchmarkTickerHandle);
+
+	FGrapplingHookBenchmarkRun& Run = *GrapplingHookBenchmarkRun;
+	if (Run.Steps.Num() > 0)
+	{
+		Write(Run);
+	}
+	Run.DestroyStep();
+	for (const TWeakObjectPtr<AActor>& Actor : Run.Environment)
+	{
+		if (Actor.IsValid())
+		{
+			Actor->Destroy();
+		}
+	}
+	if (Run.PhysicsStartTick.IsTickFunctionRegistered())
+	{
+		Run.PhysicsStartTick.UnRegisterTickFunction();
+	}
+	if (Run.PhysicsEndTick.IsTickFunctionRegistered())
+	{
+		Run.PhysicsEndTick.UnRegisterTickFunction();
+	}
+	if (IConsoleVariable* const UpdateWorkers = GetGrapplingHookUpdateWorkers())
+	{
+		UpdateWorkers->Set(Run.InitialWorkers);
+	}
+	const bool bQuit = Run.bQuitWhenDone;
+	GrapplingHookBenchmarkRun.Reset();
+	if (bQuit)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+bool FGrapplingHookBenchmark::IsRunning()
+{
+	return GrapplingHookBenchmarkRun.IsValid();
+}
+bool FGrapplingHookBenchmark::OnTicker(float DeltaTime)
+{
+	FGrapplingHookBenchmarkRun& Run = *GrapplingHookBenchmarkRun;
+	if (!Run.World.IsValid())
+	{
+		//World torn down (map change, PIE end), the steps already measured are written
+		Stop();
+		return false;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Run.Frame == 0)
+	{
+		FGrapplingHookBenchmarkStep& NewStep = Run.Steps[Run.Steps.AddDefaulted()];
+		NewStep.Grapplers = Run.Counts[Run.StepIndex / Run.Workers.Num()];
+		NewStep.Workers = Run.Workers[Run.StepIndex % Run.Workers.Num()];
+		if (IConsoleVariable* const UpdateWorkers = GetGrapplingHookUpdateWorkers())
+		{
+			UpdateWorkers->Set(NewStep.Workers);
+		}
+		Run.SpawnStep(NewStep.Grapplers);
+		NewStep.SpawnMs = (FPlatformTime::Seconds() - Now) * 1000.0;
+	}
+
+	FGrapplingHookBenchmarkStep& Step = Run.Steps.Last();
+	const bool bMeasured = Run.Frame > GrapplingHookBenchmarkWarmupFrames;
+	if (Run.Frame == GrapplingHookBenchmarkWarmupFrames)
+	{
+		Step.MemoryStart = FPlatformMemory::GetStats().UsedPhysical;
+	}
+	if (bMeasured)
+	{
+		//Measures of the frame that just ended
+		const double FrameMs = (Now - Run.LastFrameTime) * 1000.0;
+		const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+		const double PhysicsMs = Run.PhysicsEndTime > Run.PhysicsStartTime ? (Run.PhysicsEndTime - Run.PhysicsStartTime) * 1000.0 : 0.0;
+		const FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Find(Run.World.Get());
+		const double ComputeMs = WorldData ? WorldData->GetLastComputeSeconds() * 1000.0 : 0.0;
+		++Step.Frames;
+		Step.FrameMsSum += FrameMs;
+		Step.FrameMsMax = FMath::Max(Step.FrameMsMax, FrameMs);
+		Step.GameThreadMsSum += GameThreadMs;
+		Step.GameThreadMsMax = FMath::Max(Step.GameThreadMsMax, GameThreadMs);
+		Step.PhysicsMsSum += PhysicsMs;
+		Step.PhysicsMsMax = FMath::Max(Step.PhysicsMsMax, PhysicsMs);
+		Step.ComputeMsSum += ComputeMs;
+		Step.ComputeMsMax = FMath::Max(Step.ComputeMsMax, ComputeMs);
+	}
+	Run.LastFrameTime = Now;
+
+	if (Step.Frames < Run.FramesPerStep)
+	{
+		Run.ScriptInputs(bMeasured ? &Step : nullptr);
+		++Run.Frame;
+		return true;
+	}
+
+	Step.MemoryEnd = FPlatformMemory::GetStats().UsedPhysical;
+	Run.DestroyStep();
+	const double GCStart = FPlatformTime::Seconds();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	Step.GCMs = (FPlatformTime::Seconds() - GCStart) * 1000.0;
+	UE_LOG(LogGrapplingHook, Log, TEXT("GrapplingHook.Benchmark: %d grapplers, %d workers, frame %.2f ms (max %.2f), game thread %.2f ms, physics %.2f ms, compute %.3f ms, GC %.2f ms"),
+		Step.Grapplers, Step.Workers, Step.FrameMsSum / Step.Frames, Step.FrameMsMax, Step.GameThreadMsSum / Step.Frames, Step.PhysicsMsSum / Step.Frames, Step.ComputeMsSum / Step.Frames, Step.GCMs);
+
+	Run.Frame = 0;
+	++Run.StepIndex;
+	if (Run.StepIndex >= Run.GetNumSteps())
+	{
+		Stop();
+		return false;
+	}
+	return true;
+}
+void FGrapplingHookBenchmark::Write(const FGrapplingHookBenchmarkRun& Run)
+{
+	static const double MB = 1024.0 * 1024.0;
+
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(TEXT("\t\"Session\": \"%s\",\n"), *Run.Session);
+	Json += FString::Printf(TEXT("\t\"Build\": \"%s\",\n"), FApp::GetBuildVersion());
+	Json += FString::Printf(TEXT("\t\"Engine\": \"%s\",\n"), *FEngineVersion::Current().ToString());
+	Json += FString::Printf(TEXT("\t\"Configuration\": \"%s\",\n"), EBuildConfigurations::ToString(FApp::GetBuildConfiguration()));
+	Json += FString::Printf(TEXT("\t\"FramesPerStep\": %d,\n"), Run.FramesPerStep);
+	Json += FString::Printf(TEXT("\t\"Cores\": %d,\n"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	Json += TEXT("\t\"Steps\": [\n");
+	for (int32 Index = 0; Index < Run.Steps.Num(); ++Index)
+	{
+		const FGrapplingHookBenchmarkStep& Step = Run.Steps[Index];
+		const double Frames = FMath::Max(Step.Frames, 1);
+		const double MemoryDelta = static_cast<double>(Step.MemoryEnd) - static_cast<double>(Step.MemoryStart);
+		Json += TEXT("\t\t{ ");
+		Json += FString::Printf(TEXT("\"Grapplers\": %d, \"Workers\": %d, \"Frames\": %d, \"SpawnMs\": %.3f, "), Step.Grapplers, Step.Workers, Step.Frames, Step.SpawnMs);
+		Json += FString::Printf(TEXT("\"FrameMsAvg\": %.3f, \"FrameMsMax\": %.3f, "), Step.FrameMsSum / Frames, Step.FrameMsMax);
+		Json += FString::Printf(TEXT("\"GameThreadMsAvg\": %.3f, \"GameThreadMsMax\": %.3f, "), Step.GameThreadMsSum / Frames, Step.GameThreadMsMax);
+		Json += FString::Printf(TEXT("\"PhysicsMsAvg\": %.3f, \"PhysicsMsMax\": %.3f, "), Step.PhysicsMsSum / Frames, Step.PhysicsMsMax);
+		Json += FString::Printf(TEXT("\"ComputeMsAvg\": %.3f, \"ComputeMsMax\": %.3f, "), Step.ComputeMsSum / Frames, Step.ComputeMsMax);
+		Json += FString::Printf(TEXT("\"UsedMemoryMB\": %.3f, \"MemoryGrowthMB\": %.3f, "), Step.MemoryEnd / MB, MemoryDelta / MB);
+		Json += FString::Printf(TEXT("\"GCMs\": %.3f, \"Launches\": %d, \"Stops\": %d }"), Step.GCMs, Step.Launches, Step.Stops);
+		Json += Index + 1 < Run.Steps.Num() ? TEXT(",\n") : TEXT("\n");
+	}
+	Json += TEXT("\t]\n}\n");
+
+	const FString Path = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GrapplingHook"), FString::Printf(TEXT("Benchmark_%s.json"), *Run.Session));
+	FFileHelper::SaveStringToFile(Json, *Path);
+	UE_LOG(LogGrapplingHook, Log, TEXT("GrapplingHook.Benchmark: results written to %s"), *Path);
+}
@@ -0,0 +1,61 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookClassLoader.h"
+#include "ProjectileHook.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+
+TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> FGrapplingHookClassLoader::Handles;
+
+bool FGrapplingHookClassLoader::Request(const TSoftClassPtr<AProjectileHook>& HookClass)
+{
+	if (HookClass.IsNull())
+	{
+		return false;
+	}
+	const FSoftObjectPath Path = HookClass.ToSoftObjectPath();
+	const TSharedPtr<FStreamableHandle>* const Existing = Handles.Find(Path);
+	if ((!Existing || IsFailedLoad(*Existing)) && UAssetManager::IsValid())
+	{
+		//A failed load is released and requested again (the class may have been added or fixed since then)
+		if (Existing && Existing->IsValid())
+		{
+			(*Existing)->ReleaseHandle();
+		}
+		//Added before the request, the delegate may be executed immediately if the class is already in memory
+		Handles.Add(Path);
+		const TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Path, FStreamableDelegate::CreateStatic(&FGrapplingHookClassLoader::OnClassLoaded, Path));
+		if (Handle.IsValid())
+		{
+			Handles.Add(Path, Handle);
+		}
+		else
+		{
+			Handles.Remove(Path);
+		}
+	}
+	return HookClass.Get() != nullptr;
+}
+void FGrapplingHookClassLoader::ReleaseAll()
+{
+	for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& Pair : Handles)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->ReleaseHandle();
+		}
+	}
+	Handles.Empty();
+}
+bool FGrapplingHookClassLoader::IsFailedLoad(const TSharedPtr<FStreamableHandle>& Handle)
+{
+	return Handle.IsValid() && (Handle->WasCanceled() || (Handle->HasLoadCompleted() && !Handle->GetLoadedAsset()));
+}
+void FGrapplingHookClassLoader::OnClassLoaded(const FSoftObjectPath Path)
+{
+	UClass* const LoadedClass = Cast<UClass>(Path.ResolveObject());
+	if (LoadedClass)
+	{
+		LoadedClass->GetDefaultObject();
+	}
+}
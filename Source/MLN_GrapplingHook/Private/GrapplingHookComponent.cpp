@@ -2,22 +2,306 @@
 
 #include "GrapplingHookComponent.h"
 #include "ProjectileHook.h"
-#include "TimerManager.h"
+#include "GrapplingHookWorldData.h"
+#include "GrapplingHookStateTable.h"
+#include "GrapplingHookClassLoader.h"
+#include "GrapplingHookTelemetry.h"
+#include "GrapplingHookSnapshot.h"
 #include "Engine/World.h"
 #include "Components/AudioComponent.h"
 #include "GameFramework/Character.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SphereComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
 #include "Perception/AISense_Hearing.h"
 #include "PhysicsEngine/PhysicsHandleComponent.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
+#include "PhysicsEngine/PhysicsSettings.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "../Plugins/Runtime/CableComponent/Source/CableComponent/Classes/CableComponent.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Curves/CurveFloat.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "UObject/UObjectIterator.h"
+#include "HAL/IConsoleManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "MLN_GrapplingHook.h"
 
 float UGrapplingHookComponent::RadToDeg = 180.f / PI;
 float UGrapplingHookComponent::DegToRad = PI / 180.f;
 float UGrapplingHookComponent::MinTimerValue = 0.f;
 
+static TAutoConsoleVariable<int32> CVarGrapplingHookDeterministicLogHash(
+	TEXT("GrapplingHook.Deterministic.LogHash"),
+	0,
+	TEXT("If not 0 every grappling hook component in deterministic mode logs its state hash at the end of every simulation frame, diff the logs of two machines to find the first desynced frame"));
+
+/* Activation masks with a state machine table specialized at compile time
+*/
+static const uint8 GrapplingHookMaskAll = static_cast<uint8>(EGrapplingHookActivation::GA_All);
+static const uint8 GrapplingHookMaskLaunchOnly = static_cast<uint8>(EGrapplingHookActivation::GA_Launch);
+static const uint8 GrapplingHookMaskSwingRetractCooldown = static_cast<uint8>(EGrapplingHookActivation::GA_Swing) | static_cast<uint8>(EGrapplingHookActivation::GA_Retracting) | static_cast<uint8>(EGrapplingHookActivation::GA_Cooldown);
+
+/* Message of every EGrapplingHookError, in enum order
+*/
+static const TCHAR* const GrapplingHookErrorMessages[] =
+{
+	TEXT("The spawn of the AProjectileHook did not succeed because no Cable reference was set"),
+	TEXT("The spawn of the AProjectileHook did not succeed because no World was found"),
+	TEXT("The spawn of the AProjectileHook did not succeed"),
+	TEXT("The spawn of the AProjectileHook did not succeed (Failed Cast to AProjectileHook)"),
+	TEXT("The Swing activation failed due to missing core elements (Owner, Owner movement component,Capsule, Cable, SwingConstraint)"),
+	TEXT("The Swing update failed due to missing core elements (Owner, Capsule, Cable)"),
+	TEXT("The Retract update failed due to missing core elements (Owner, Capsule, Cable)"),
+	TEXT("The Launch update failed due to missing core elements (Owner, Cable)"),
+	TEXT("The Pull update failed due to missing core elements (PullHandle, Cable)"),
+	TEXT("The Pull Activation failed due to missing core elements (PullHandle, Cable)"),
+	TEXT("The update failed due to missing core elements (Owner, Cable, Hook)"),
+	TEXT("The Tug update failed due to missing core elements (Owner, Owner movement component, GrappledObject)"),
+	TEXT("The spawn of the AProjectileHook did not succeed because HookClass is not set or is still loading"),
+	TEXT("The tick was disabled and the hooks were reset after too many consecutive update core failures"),
+};
+static_assert(ARRAY_COUNT(GrapplingHookErrorMessages) == static_cast<int32>(EGrapplingHookError::GE_MAX), "Every EGrapplingHookError needs a message");
+
+FGrapplingHookErrorRecord::FGrapplingHookErrorRecord()
+{
+	LastBroadcastTime = -MAX_dbl;
+	PendingCount = 0;
+}
+FGrapplingHookStateTable::FGrapplingHookStateTable()
+{
+	for (int32 State = 0; State < NumStates; ++State)
+	{
+		Update[State] = nullptr;
+		Exit[State] = nullptr;
+		Cooldown[State] = nullptr;
+		bInterruptible[State] = false;
+		bEnabled[State] = true;
+	}
+	UpdateHooks = nullptr;
+	ExitHook = nullptr;
+	Enter = nullptr;
+	Activation = 0;
+	bSpecialized = false;
+	bExtending = false;
+	bRetracting = false;
+	bCooldown = false;
+}
+
+FGrapplingHookInstance::FGrapplingHookInstance()
+{
+	Hook = nullptr;
+	Cable = nullptr;
+	GrappledObject = nullptr;
+	Anchor.Reset();
+	AnchorRelativeLocation = FVector::ZeroVector;
+	AnchorLocation = FVector::ZeroVector;
+	RetractStartLocation = FVector::ZeroVector;
+	RetractClock = 0;
+	RetractClockRate = FGrapplingHookRetractClock::GetRate(0.f);
+	RopeLength = 0.f;
+	bDeterministicPulled = false;
+	CooldownTimerHandle.Invalidate();
+	CurrentState = EGrapplingHookState::GS_Ready;
+	PreRetractingState = CurrentState;
+	bActivatedSwing = false;
+	StateEnterTime = 0.0;
+	bLazyCable = false;
+	RopeCollisionCursor = 0;
+	bRopeRouted = false;
+	bRopeRouteMainPass = true;
+	bRopeRouteCastShadow = true;
+}
+FGrapplingHookRopeContact::FGrapplingHookRopeContact()
+{
+	SpanStart = FVector::ZeroVector;
+	SpanEnd = FVector::ZeroVector;
+	Location = FVector::ZeroVector;
+	Normal = FVector::ZeroVector;
+	bContact = false;
+	bSwept = false;
+}
+FGrapplingHookUpdateParams::FGrapplingHookUpdateParams()
+{
+	LaunchSpeed = 0.f;
+	LaunchOffsetZ = 0.f;
+	BreakDistance = 0.f;
+	RetractDistanceTollerance = 0.f;
+	PullDistanceTollerance = 0.f;
+	PullDistanceInterrupt = 0.f;
+	RetractEasing = nullptr;
+	bDeterministic = false;
+}
+FGrapplingHookUpdateResult::FGrapplingHookUpdateResult()
+{
+	LaunchVelocity = FVector::ZeroVector;
+	RetractLocation = FVector::ZeroVector;
+	RetractRotation = FQuat::Identity;
+	PullTargetLocation = FVector::ZeroVector;
+	RetractClock = 0;
+	GrappleLength = 0.f;
+	DeltaTime = 0.f;
+	Frame = MAX_uint64;
+	State = EGrapplingHookState::GS_Ready;
+	bValidStart = false;
+	bValidEnd = false;
+	bBreak = false;
+	bRetractOver = false;
+	bPullOver = false;
+}
+FGrapplingHookUpdateInput::FGrapplingHookUpdateInput()
+{
+	StartLocation = FVector::ZeroVector;
+	EndLocation = FVector::ZeroVector;
+	CableForward = FVector::ForwardVector;
+	OwnerLocation = FVector::ZeroVector;
+	HookLocation = FVector::ZeroVector;
+	RetractStartLocation = FVector::ZeroVector;
+	RetractClock = 0;
+	RetractClockRate = FGrapplingHookRetractClock::GetRate(0.f);
+	PulledObjectDistance = MAX_flt;
+	DeltaTime = 0.f;
+	Frame = 0;
+	ParamsIndex = INDEX_NONE;
+	HookIndex = INDEX_NONE;
+	State = EGrapplingHookState::GS_Ready;
+	bValidStart = false;
+	bValidEnd = false;
+}
+FQuat FGrapplingHookUpdateInput::GetLookAtQuat(const FVector& Start, const FVector& Target)
+{
+	//Same rotation as FindLookAtRotation (no roll), built from the half angle cosines of yaw and pitch instead of trigonometric functions
+	const FVector Direction = Target - Start;
+	const float PlanarSquared = FMath::Square(Direction.X) + FMath::Square(Direction.Y);
+	const float LengthSquared = PlanarSquared + FMath::Square(Direction.Z);
+	if (LengthSquared <= SMALL_NUMBER)
+	{
+		return FQuat::Identity;
+	}
+
+	float CosYaw = 1.f;
+	if (PlanarSquared > SMALL_NUMBER)
+	{
+		CosYaw = Direction.X * FMath::InvSqrt(PlanarSquared);
+	}
+	const float CosPitch = FMath::Sqrt(PlanarSquared) * FMath::InvSqrt(LengthSquared);
+
+	const float CY = FMath::Sqrt(FMath::Max(0.5f * (1.f + CosYaw), 0.f));
+	const float SY = FMath::Sqrt(FMath::Max(0.5f * (1.f - CosYaw), 0.f)) * (Direction.Y < 0.f ? -1.f : 1.f);
+	const float CP = FMath::Sqrt(FMath::Max(0.5f * (1.f + CosPitch), 0.f));
+	const float SP = FMath::Sqrt(FMath::Max(0.5f * (1.f - CosPitch), 0.f)) * (Direction.Z < 0.f ? -1.f : 1.f);
+
+	//FRotator::Quaternion with zero roll
+	return FQuat(SP * SY, -SP * CY, CP * SY, CP * CY);
+}
+void FGrapplingHookUpdateInput::Compute(const FGrapplingHookUpdateParams& Params, FGrapplingHookUpdateResult& OutResult) const
+{
+	OutResult.DeltaTime = DeltaTime;
+	OutResult.Frame = Frame;
+	OutResult.State = State;
+	OutResult.bValidStart = bValidStart;
+	OutResult.bValidEnd = bValidEnd;
+	if (Params.bDeterministic)
+	{
+		ComputeDeterministic(Params, OutResult);
+		return;
+	}
+	OutResult.GrappleLength = FVector::Distance(EndLocation, StartLocation);
+	OutResult.bBreak = OutResult.GrappleLength > Params.BreakDistance;
+	OutResult.LaunchVelocity = FVector::ZeroVector;
+	OutResult.RetractLocation = HookLocation;
+	OutResult.RetractRotation = FQuat::Identity;
+	OutResult.RetractClock = RetractClock;
+	OutResult.PullTargetLocation = StartLocation;
+	OutResult.bRetractOver = false;
+	OutResult.bPullOver = false;
+
+	switch (State)
+	{
+	case EGrapplingHookState::GS_Launch:
+	{
+		//Same as GetOwnerLaunchVelocity with the launch offset applied to the end location
+		const FVector TargetLocation(EndLocation.X, EndLocation.Y, EndLocation.Z + Params.LaunchOffsetZ);
+		OutResult.LaunchVelocity = (TargetLocation - OwnerLocation) * DeltaTime * Params.LaunchSpeed;
+		break;
+	}
+	case EGrapplingHookState::GS_Retracting:
+	{
+		OutResult.RetractClock = FGrapplingHookRetractClock::Advance(RetractClock, RetractClockRate, DeltaTime);
+		const float Alpha = Params.RetractEasing ? Params.RetractEasing->Evaluate(OutResult.RetractClock) : OutResult.RetractClock * (1.f / FGrapplingHookRetractClock::One);
+		OutResult.RetractLocation = FMath::Lerp(RetractStartLocation, StartLocation, Alpha);
+		OutResult.RetractRotation = GetLookAtQuat(StartLocation, HookLocation);
+		//The grapple end moves along with the hook
+		OutResult.bRetractOver = FVector::DistSquared(OutResult.RetractLocation + (EndLocation - HookLocation), StartLocation) <= FMath::Square(Params.RetractDistanceTollerance);
+		break;
+	}
+	case EGrapplingHookState::GS_Pull:
+		OutResult.PullTargetLocation = StartLocation + (CableForward * Params.PullDistanceTollerance);
+		OutResult.bPullOver = Params.PullDistanceInterrupt >= PulledObjectDistance;
+		break;
+	default:
+		break;
+	}
+}
+void FGrapplingHookUpdateInput::ComputeDeterministic(const FGrapplingHookUpdateParams& Params, FGrapplingHookUpdateResult& OutResult) const
+{
+	const FGrapplingHookFixedVector Start = FGrapplingHookFixedVector::FromVector(StartLocation);
+	const FGrapplingHookFixedVector End = FGrapplingHookFixedVector::FromVector(EndLocation);
+	const FGrapplingHookFixed Step = FGrapplingHookFixed::FromFloat(DeltaTime);
+	const FGrapplingHookFixed Length = (End - Start).Size();
+	OutResult.GrappleLength = Length.ToFloat();
+	OutResult.bBreak = Length > FGrapplingHookFixed::FromFloat(Params.BreakDistance);
+	OutResult.LaunchVelocity = FVector::ZeroVector;
+	OutResult.RetractLocation = HookLocation;
+	OutResult.RetractRotation = FQuat::Identity;
+	OutResult.RetractClock = RetractClock;
+	OutResult.PullTargetLocation = StartLocation;
+	OutResult.bRetractOver = false;
+	OutResult.bPullOver = false;
+
+	switch (State)
+	{
+	case EGrapplingHookState::GS_Launch:
+	{
+		FGrapplingHookFixedVector TargetLocation = End;
+		TargetLocation.Z += FGrapplingHookFixed::FromFloat(Params.LaunchOffsetZ);
+		const FGrapplingHookFixedVector Velocity = (TargetLocation - FGrapplingHookFixedVector::FromVector(OwnerLocation)) * (Step * FGrapplingHookFixed::FromFloat(Params.LaunchSpeed));
+		OutResult.LaunchVelocity = Velocity.ToVector();
+		break;
+	}
+	case EGrapplingHookState::GS_Retracting:
+	{
+		//The retract clock is already 16.16 fixed point, only its step is computed here (rounded, same as FGrapplingHookRetractClock::Advance)
+		const int64 ClockStepRaw = FMath::Max<int64>((FGrapplingHookFixed::FromFloat(RetractClockRate) * Step).Raw, 0);
+		const int64 ClockStep = (ClockStepRaw + (static_cast<int64>(1) << (FGrapplingHookFixed::FracBits - 1))) >> FGrapplingHookFixed::FracBits;
+		const uint32 Left = FGrapplingHookRetractClock::One - FMath::Min(RetractClock, FGrapplingHookRetractClock::One);
+		OutResult.RetractClock = ClockStep >= Left ? FGrapplingHookRetractClock::One : RetractClock + static_cast<uint32>(ClockStep);
+		const FGrapplingHookFixed Alpha = FGrapplingHookFixed::FromRaw(Params.RetractEasing ? static_cast<int64>(Params.RetractEasing->EvaluateFixed(OutResult.RetractClock)) : static_cast<int64>(FMath::Min(OutResult.RetractClock, FGrapplingHookRetractClock::One)));
+
+		const FGrapplingHookFixedVector RetractStart = FGrapplingHookFixedVector::FromVector(RetractStartLocation);
+		const FGrapplingHookFixedVector Location = RetractStart + (Start - RetractStart) * Alpha;
+		OutResult.RetractLocation = Location.ToVector();
+		//Only used to orient the hook mesh, not part of the simulated state
+		OutResult.RetractRotation = GetLookAtQuat(StartLocation, HookLocation);
+		const FGrapplingHookFixedVector RetractEnd = Location + (End - FGrapplingHookFixedVector::FromVector(HookLocation));
+		const FGrapplingHookFixed Tollerance = FGrapplingHookFixed::FromFloat(Params.RetractDistanceTollerance);
+		OutResult.bRetractOver = (RetractEnd - Start).SizeSquared() <= Tollerance * Tollerance;
+		break;
+	}
+	case EGrapplingHookState::GS_Pull:
+	{
+		const FGrapplingHookFixedVector Forward = FGrapplingHookFixedVector::FromVector(CableForward);
+		OutResult.PullTargetLocation = (Start + Forward * FGrapplingHookFixed::FromFloat(Params.PullDistanceTollerance)).ToVector();
+		//Float comparison is exact, PulledObjectDistance is computed in fixed point by the deterministic pull
+		OutResult.bPullOver = Params.PullDistanceInterrupt >= PulledObjectDistance;
+		break;
+	}
+	default:
+		break;
+	}
+}
+
 UGrapplingHookComponent::UGrapplingHookComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -27,12 +311,40 @@ UGrapplingHookComponent::UGrapplingHookComponent()
 
 	PrimaryComponentTick.TickGroup = ETickingGroup::TG_PrePhysics;
 
-	CooldownTimerHandle.Invalidate();
+	GroundedGraceTimerHandle.Invalidate();
 	GroundCheckTimerHandle.Invalidate();
+	bGroundedInterruptArmed = false;
+	BoundOwner = nullptr;
 
-	bActivatedSwing = false;
 	bInitializeCoreOnBeginPlay = true;
 	bInitializeNonCoreOnBeginPlay = true;
+	bDeferInitialization = false;
+	bUsePhysicsPool = true;
+	bLazySubobjects = false;
+	LazyIdleTime = 10.f;
+	LazyCableClass = UCableComponent::StaticClass();
+	LazyCableSocket = NAME_None;
+	bLazyAudio = false;
+	InputBufferWindow = 0.2f;
+	bStopCancelsBufferedLaunch = true;
+	bChainHooks = false;
+	bLaunchBuffered = false;
+	BufferedLaunchHookIndex = INDEX_NONE;
+	BufferedLaunchExpireTime = 0.0;
+	LaunchInputTime = -1.0;
+	LaunchInputFrame = 0;
+	LastLaunchLatencyMs = -1.f;
+	LastLaunchLatencyFrames = 0;
+	bPooledSwingConstraint = false;
+	bPooledPullHandle = false;
+	bInitializationPending = false;
+
+	ErrorReportInterval = 1.f;
+	MaxConsecutiveCoreFailures = 30;
+	ConsecutiveCoreFailures = 0;
+	bCoreFailureThisTick = false;
+
+	HookCount = 1;
 
 	MissedCooldown = UGrapplingHookComponent::MinTimerValue;
 
@@ -47,6 +359,10 @@ UGrapplingHookComponent::UGrapplingHookComponent()
 	PullMaxInterruptVelocity = 50.f;
 	PullCooldown = 2.f;
 
+	bTugHeavyObjects = false;
+	TugForce = 50000.f;
+	TugCooldown = 2.f;
+
 	SwingingStrength = 100.f;
 	SwingSurfaceNormal = -FVector::UpVector;
 	SwingSurfaceDegreesTollerance = 60.01f;
@@ -54,14 +370,36 @@ UGrapplingHookComponent::UGrapplingHookComponent()
 
 	RetractDistanceTollerance = 100.f;
 	RetractDuration = 0.5f;
-	CurrentRetractDuration = RetractDuration;
 
 	GroundedCheckDelay = 0.15f;
+	GroundedInterruptGracePeriod = 0.15f;
 	HookClass = AProjectileHook::StaticClass();
 	Activation = static_cast<uint8>(EGrapplingHookActivation::GA_All);
 
 	BreakDistance = 5000.f;
 	BlockingObjects.Add(ECollisionChannel::ECC_Pawn);
+	AimAssistConeDegrees = 6.f;
+	AimAssistRings = 2;
+	AimAssistRaysPerRing = 8;
+	bAimAssistRingByRing = false;
+	AimAssistReuseDistance = 10.f;
+	AimAssistReuseDegrees = 1.f;
+	AimAssistReuseTime = 0.1f;
+	TrajectoryPreviewMaxTime = 2.f;
+	TrajectoryPreviewMinSpacing = 50.f;
+	TrajectoryPreviewReuseDistance = 10.f;
+	TrajectoryPreviewShiftDistance = 100.f;
+	bRopeCollision = false;
+	RopeCollisionSpans = 4;
+	RopeCollisionLODDistance = 2000.f;
+	RopeCollisionReuseDistance = 2.f;
+	bRopeContactCableCollision = false;
+	bHookIgnoresTraceChannels = true;
+	PullableObjects.Add(ECollisionChannel::ECC_WorldDynamic);
+	PullableObjects.Add(ECollisionChannel::ECC_PhysicsBody);
+	SwingableObjects.Add(ECollisionChannel::ECC_WorldStatic);
+	SwingableObjects.Add(ECollisionChannel::ECC_WorldDynamic);
+	SwingableObjects.Add(ECollisionChannel::ECC_PhysicsBody);
 
 	ActivatedSound = nullptr;
 	InterruptedSound = nullptr;
@@ -73,22 +411,37 @@ UGrapplingHookComponent::UGrapplingHookComponent()
 	NoiseTag = NAME_None;
 
 	Owner = nullptr;
-	Cable = nullptr;
-	GrappledObject = nullptr;
-	Hook = nullptr;
 
 	SwingConstraint = nullptr;
 	CurrentSwingingForce = FVector::ZeroVector;
+	SubstepSwingingForce = FVector::ZeroVector;
+	bSubstepAccelChange = false;
+	bSubstepSwing = true;
+	ReelInSpeed = 300.f;
+	ReelOutSpeed = 300.f;
+	MinRopeLength = 100.f;
+	CurrentReelInput = 0.f;
+	SubstepReelSpeed = 0.f;
+	SubstepMinRopeLength = 0.f;
+	SubstepMaxRopeLength = 0.f;
 	bAccelChange = true;
+	bSwingPhysicsActive = false;
+	ConstrainedHookIndex = INDEX_NONE;
+	bDeterministic = false;
+	DeterministicTimeStep = 1.f / 30.f;
+	bDeterministicOwnerDriven = false;
+	DeterministicStateHash = FGrapplingHookStateHash::Seed;
+	DeterministicFrame = 0;
 
 	PullHandle = nullptr;
+	PullHookIndex = INDEX_NONE;
+	StateTable = nullptr;
+	bRefreshingStateTable = false;
 	Audio = nullptr;
 	NoiseInstigator = nullptr;
 
-	SetCurrentState(EGrapplingHookState::GS_Ready);
-	PreRetractingState = CurrentState;
-
-	RetractTime = 0.f;
+	Hooks.SetNum(HookCount);
+	RetractCurve = nullptr;
 }
 EGrapplingHookActivation UGrapplingHookComponent::GetActivationFlag() const
 {
@@ -101,29 +454,38 @@ uint8 UGrapplingHookComponent::GetActivationUFlag() const
 void UGrapplingHookComponent::SetActivationUFlag(const uint8 InFlags)
 {
 	Activation = InFlags;
+	RefreshStateTable();
 }
 void UGrapplingHookComponent::SetActivationFlag(const EGrapplingHookActivation InFlags)
 {
 	Activation = static_cast<uint8>(InFlags);
+	RefreshStateTable();
 }
 FVector UGrapplingHookComponent::GetOwnerLaunchVelocity(const float DeltaTime, const float Speed, const FVector& TargetLocation, const FVector& StartLocation) const
 {
 	return (TargetLocation - StartLocation) * DeltaTime * Speed;
 }
-FVector UGrapplingHookComponent::GetGrappleStartLocation(bool& bOutValid) const
+FVector UGrapplingHookComponent::GetGrappleStartLocation(bool& bOutValid, const int32 HookIndex) const
 {
-	if (Cable)
+	if (Hooks.IsValidIndex(HookIndex) && Hooks[HookIndex].Cable)
 	{
 		bOutValid = true;
-		return Cable->GetComponentLocation();
+		return Hooks[HookIndex].Cable->GetComponentLocation();
 	}
 	bOutValid = false;
 	return FVector::ZeroVector;
 }
-FVector UGrapplingHookComponent::GetGrappleEndLocation(bool& bOutValid) const
+FVector UGrapplingHookComponent::GetGrappleEndLocation(bool& bOutValid, const int32 HookIndex) const
 {
-	if (Cable)
+	//Anchored hooks are refreshed once per frame in RefreshAnchors
+	if (Hooks.IsValidIndex(HookIndex) && Hooks[HookIndex].Anchor.IsValid())
+	{
+		bOutValid = true;
+		return Hooks[HookIndex].AnchorLocation;
+	}
+	if (Hooks.IsValidIndex(HookIndex) && Hooks[HookIndex].Cable)
 	{
+		const UCableComponent* const Cable = Hooks[HookIndex].Cable;
 		const USceneComponent* const Attached = Cable->GetAttachedComponent();
 		if (Attached)
 		{
@@ -148,71 +510,298 @@ UAudioComponent* UGrapplingHookComponent::GetAudioComponent() const
 }
 void UGrapplingHookComponent::SetAudioComponent(UAudioComponent* const InAudio)
 {
+	if (bLazyAudio && Audio && Audio != InAudio)
+	{
+		Audio->DestroyComponent();
+	}
+	bLazyAudio = false;
 	Audio = InAudio;
 }
-bool UGrapplingHookComponent::ActivateSwing()
+void UGrapplingHookComponent::CreateLazyCable(const int32 HookIndex)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	AActor* const ActorOwner = GetOwner();
+	if (Instance.Cable || !ActorOwner)
+	{
+		return;
+	}
+
+	USceneComponent* Parent = ActorOwner->GetRootComponent();
+	FName Socket = NAME_None;
+	USkeletalMeshComponent* const Mesh = Owner ? Owner->GetMesh() : nullptr;
+	if (Mesh && LazyCableSocket != NAME_None && Mesh->DoesSocketExist(LazyCableSocket))
+	{
+		Parent = Mesh;
+		Socket = LazyCableSocket;
+	}
+
+	UClass* const CableClass = LazyCableClass ? LazyCableClass.Get() : UCableComponent::StaticClass();
+	UCableComponent* const Cable = NewObject<UCableComponent>(ActorOwner, CableClass, NAME_None, RF_Transient);
+	Cable->SetupAttachment(Parent, Socket);
+	Cable->RegisterComponent();
+	Cable->SetVisibility(false, true);
+
+	Instance.Cable = Cable;
+	Instance.bLazyCable = true;
+}
+void UGrapplingHookComponent::CreateLazyAudio()
+{
+	AActor* const ActorOwner = GetOwner();
+	if (Audio || !ActorOwner)
+	{
+		return;
+	}
+	UAudioComponent* const NewAudio = NewObject<UAudioComponent>(ActorOwner, NAME_None, RF_Transient);
+	NewAudio->bAutoActivate = false;
+	NewAudio->SetupAttachment(ActorOwner->GetRootComponent());
+	NewAudio->RegisterComponent();
+
+	Audio = NewAudio;
+	bLazyAudio = true;
+}
+void UGrapplingHookComponent::ScheduleLazyRelease()
+{
+	if (!bLazySubobjects || LazyIdleTime <= 0.f)
+	{
+		return;
+	}
+	for (const FGrapplingHookInstance& Instance : Hooks)
+	{
+		if (Instance.CurrentState != EGrapplingHookState::GS_Ready)
+		{
+			return;
+		}
+	}
+	FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+	if (TimerWheel)
+	{
+		TimerWheel->ClearTimer(LazyIdleTimerHandle);
+		LazyIdleTimerHandle = TimerWheel->SetTimer(FSimpleDelegate::CreateUObject(this, &UGrapplingHookComponent::OnLazyIdleTimeEnd), LazyIdleTime, false);
+		//The deterministic timer wheel is only advanced by the tick
+		if (bDeterministic)
+		{
+			SetComponentTickEnabled(true);
+		}
+	}
+}
+void UGrapplingHookComponent::OnLazyIdleTimeEnd()
+{
+	LazyIdleTimerHandle.Invalidate();
+	for (const FGrapplingHookInstance& Instance : Hooks)
+	{
+		if (Instance.CurrentState != EGrapplingHookState::GS_Ready)
+		{
+			return;
+		}
+	}
+	DestroyLazySubobjects();
+}
+void UGrapplingHookComponent::DestroyLazySubobjects()
+{
+	FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+	if (TimerWheel)
+	{
+		TimerWheel->ClearTimer(LazyIdleTimerHandle);
+	}
+	for (FGrapplingHookInstance& Instance : Hooks)
+	{
+		if (Instance.bLazyCable && Instance.Cable)
+		{
+			Instance.Cable->DestroyComponent();
+			Instance.Cable = nullptr;
+		}
+		Instance.bLazyCable = false;
+		//Route cables are only created on first use too
+		for (UCableComponent* const RouteCable : Instance.RopeRouteCables)
+		{
+			if (RouteCable)
+			{
+				RouteCable->DestroyComponent();
+			}
+		}
+		Instance.RopeRouteCables.Reset();
+		Instance.bRopeRouted = false;
+	}
+	if (bLazyAudio && Audio)
+	{
+		Audio->Stop();
+		Audio->DestroyComponent();
+		Audio = nullptr;
+	}
+	bLazyAudio = false;
+}
+int32 UGrapplingHookComponent::GetLazyMemorySaved() const
+{
+	int32 Bytes = 0;
+	if (bLazySubobjects)
+	{
+		const UClass* const CableClass = LazyCableClass ? LazyCableClass.Get() : UCableComponent::StaticClass();
+		for (const FGrapplingHookInstance& Instance : Hooks)
+		{
+			Bytes += Instance.Cable ? 0 : CableClass->GetPropertiesSize();
+		}
+		Bytes += Audio ? 0 : UAudioComponent::StaticClass()->GetPropertiesSize();
+	}
+	if (bUsePhysicsPool)
+	{
+		Bytes += SwingConstraint ? 0 : UPhysicsConstraintComponent::StaticClass()->GetPropertiesSize();
+		Bytes += PullHandle ? 0 : UPhysicsHandleComponent::StaticClass()->GetPropertiesSize();
+	}
+	return Bytes;
+}
+/* Logs the memory saved by lazy and pooled subobjects, grouped by owner class
+*/
+static void GrapplingHookLazyMemoryReport()
+{
+	TMap<const UClass*, TPair<int32, int64>> Report;
+	for (TObjectIterator<UGrapplingHookComponent> It; It; ++It)
+	{
+		const UGrapplingHookComponent* const Grappler = *It;
+		if (Grappler->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) || !Grappler->GetOwner() || !Grappler->GetWorld())
+		{
+			continue;
+		}
+		TPair<int32, int64>& Entry = Report.FindOrAdd(Grappler->GetOwner()->GetClass());
+		Entry.Key += 1;
+		Entry.Value += Grappler->GetLazyMemorySaved();
+	}
+	for (const TPair<const UClass*, TPair<int32, int64>>& Entry : Report)
+	{
+		UE_LOG(LogGrapplingHook, Log, TEXT("%s: %d characters, %lld bytes saved (%lld per character)"), *Entry.Key->GetName(), Entry.Value.Key, Entry.Value.Value, Entry.Value.Value / Entry.Value.Key);
+	}
+}
+static FAutoConsoleCommand GrapplingHookLazyMemoryReportCommand(
+	TEXT("GrapplingHook.LazyMemoryReport"),
+	TEXT("Logs the memory saved by lazily created and pooled grappling hook subobjects, per character class"),
+	FConsoleCommandDelegate::CreateStatic(&GrapplingHookLazyMemoryReport));
+bool UGrapplingHookComponent::ActivateSwing(const int32 HookIndex)
 {
-	if (!Owner || !SwingConstraint)
+	if (!Owner)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_SwingActivationCore);
+		ReportError(EGrapplingHookError::GE_SwingActivationCore);
 		return false;
 	}
 
 	UCharacterMovementComponent* const MoveComponent = Owner->GetCharacterMovement();
 	if (!MoveComponent)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_SwingActivationCore);
+		ReportError(EGrapplingHookError::GE_SwingActivationCore);
 		return false;
 	}
 
 	UCapsuleComponent* const Capsule = Owner->GetCapsuleComponent();
 	if (!Capsule)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_SwingActivationCore);
+		ReportError(EGrapplingHookError::GE_SwingActivationCore);
 		return false;
 	}
+
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
 	//Activate already executed
-	if (bActivatedSwing)
+	if (Instance.bActivatedSwing)
+	{
+		return true;
+	}
+
+	bool bValid = true;
+	Instance.RopeLength = GetGrappleLength(bValid, HookIndex);
+	if (!bValid)
+	{
+		ReportError(EGrapplingHookError::GE_SwingActivationCore);
+	}
+	Instance.bActivatedSwing = true;
+
+	//The deterministic integrator moves the owner itself, no physics simulation is started
+	if (bDeterministic)
 	{
+		AcquireDeterministicOwner();
+		const FGrapplingHookFixedVector Anchor = FGrapplingHookFixedVector::FromVector(GetGrappleEndLocation(bValid, HookIndex));
+		Instance.DeterministicRopeLength = (DeterministicOwnerLocation - Anchor).Size();
+		Instance.RopeLength = Instance.DeterministicRopeLength.ToFloat();
 		return true;
 	}
 
-	bActivatedSwing = true;
+	//Owner physics are shared by all the swinging hooks
+	if (!bSwingPhysicsActive)
+	{
+		bSwingPhysicsActive = true;
+		Capsule->SetSimulatePhysics(true);
+		MoveComponent->SetActive(false);
+		Owner->bUseControllerRotationYaw = false;
+	}
+
+	return true;
+}
+void UGrapplingHookComponent::ConstrainSwing(const int32 HookIndex)
+{
+	ReleaseSwingConstraint();
+	if (!AcquireSwingConstraint() || !Owner)
+	{
+		ReportError(EGrapplingHookError::GE_SwingActivationCore);
+		return;
+	}
+	UCapsuleComponent* const Capsule = Owner->GetCapsuleComponent();
+	if (!Capsule)
+	{
+		ReportError(EGrapplingHookError::GE_SwingActivationCore);
+		return;
+	}
 
-	Capsule->SetSimulatePhysics(true);
-	MoveComponent->SetActive(false);
+	ConstrainedHookIndex = HookIndex;
 
 	bool bValid = true;
-	SwingConstraint->SetWorldLocation(GetGrappleEndLocation(bValid), false, (FHitResult*)nullptr, ETeleportType::TeleportPhysics);
-	SwingConstraint->SetConstrainedComponents(GrappledObject, NAME_None, Capsule, NAME_None);
+	SwingConstraint->SetWorldLocation(GetGrappleEndLocation(bValid, HookIndex), false, (FHitResult*)nullptr, ETeleportType::TeleportPhysics);
+	SwingConstraint->SetConstrainedComponents(Hooks[HookIndex].GrappledObject, NAME_None, Capsule, NAME_None);
 	SwingConstraint->UpdateConstraintFrames();
 
 	if (!bValid)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_SwingActivationCore);
+		ReportError(EGrapplingHookError::GE_SwingActivationCore);
 	}
 
-	const float GrappleLength = GetGrappleLength(bValid);
+	const float GrappleLength = GetGrappleLength(bValid, HookIndex);
 	if (!bValid)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_SwingActivationCore);
+		ReportError(EGrapplingHookError::GE_SwingActivationCore);
 	}
 	SwingConstraint->SetLinearXLimit(ELinearConstraintMotion::LCM_Locked, GrappleLength);
 	SwingConstraint->SetLinearYLimit(ELinearConstraintMotion::LCM_Locked, GrappleLength);
 	SwingConstraint->SetLinearZLimit(ELinearConstraintMotion::LCM_Locked, GrappleLength);
-
-	Owner->bUseControllerRotationYaw = false;
-
-	return true;
+}
+void UGrapplingHookComponent::ReleaseSwingConstraint()
+{
+	if (ConstrainedHookIndex == INDEX_NONE)
+	{
+		return;
+	}
+	ConstrainedHookIndex = INDEX_NONE;
+	if (SwingConstraint)
+	{
+		SwingConstraint->SetConstrainedComponents(nullptr, NAME_None, nullptr, NAME_None);
+	}
+}
+int32 UGrapplingHookComponent::GetNumSwingingHooks(int32& OutLastIndex) const
+{
+	int32 Count = 0;
+	OutLastIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Hooks.Num(); ++Index)
+	{
+		if (Hooks[Index].CurrentState == EGrapplingHookState::GS_Swing && Hooks[Index].bActivatedSwing)
+		{
+			++Count;
+			OutLastIndex = Index;
+		}
+	}
+	return Count;
 }
 FVector UGrapplingHookComponent::GetCurrentSwingingForce(bool& bOutAccelChange) const
 {
 	bOutAccelChange = this->bAccelChange;
 	return CurrentSwingingForce;
 }
-FVector UGrapplingHookComponent::GetGrappleEndLocationWithLaunchOffset(bool& bOutValid) const
+FVector UGrapplingHookComponent::GetGrappleEndLocationWithLaunchOffset(bool& bOutValid, const int32 HookIndex) const
 {
-	FVector EndLocation = GetGrappleEndLocation(bOutValid);
+	FVector EndLocation = GetGrappleEndLocation(bOutValid, HookIndex);
 	if (Owner)
 	{
 		const UCapsuleComponent* const Capsule = Owner->GetCapsuleComponent();
@@ -225,702 +814,3219 @@ FVector UGrapplingHookComponent::GetGrappleEndLocationWithLaunchOffset(bool& bOu
 }
 bool UGrapplingHookComponent::IsSurfaceSwingable(const FVector& SurfaceNormal) const
 {
+	if (bDeterministic)
+	{
+		//Acos free: the angle is within the tollerance if the cosine is above the tollerance cosine
+		const FGrapplingHookFixedVector Normal = FGrapplingHookFixedVector::FromVector(SurfaceNormal);
+		const FGrapplingHookFixedVector Reference = FGrapplingHookFixedVector::FromVector(SwingSurfaceNormal);
+		const FGrapplingHookFixed Lengths = Normal.Size() * Reference.Size();
+		return FGrapplingHookFixedVector::DotProduct(Normal, Reference) >= FGrapplingHookFixed::CosDegrees(FGrapplingHookFixed::FromFloat(SwingSurfaceDegreesTollerance)) * Lengths;
+	}
 	return (FMath::Acos(FVector::DotProduct(SwingSurfaceNormal.GetSafeNormal(), SurfaceNormal)) * UGrapplingHookComponent::RadToDeg) <= SwingSurfaceDegreesTollerance;
 }
-void UGrapplingHookComponent::UpdateSwing()
+void UGrapplingHookComponent::UpdateSwing(const float Deltatime)
 {
 	if (!Owner)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_SwingUpdateCore);
+		ReportError(EGrapplingHookError::GE_SwingUpdateCore);
 		return;
 	}
-	if (CurrentState != EGrapplingHookState::GS_Swing)
+
+	int32 LastSwingingIndex = INDEX_NONE;
+	const int32 NumSwinging = GetNumSwingingHooks(LastSwingingIndex);
+	if (NumSwinging == 0)
 	{
 		return;
 	}
 
 	UCapsuleComponent* const Capsule = Owner->GetCapsuleComponent();
+	FBodyInstance* const Body = Capsule && bSubstepSwing ? Capsule->GetBodyInstance() : nullptr;
+	const bool bSubstep = Body && Body->IsValidBodyInstance();
 
 	if (Capsule)
 	{
 		bool bAccelerationChange;
 		const FVector Force = GetCurrentSwingingForce(bAccelerationChange);
-		Capsule->AddForce(Force, NAME_None, bAccelerationChange);
+		if (bSubstep)
+		{
+			//Applied by every substep of this frame, the total impulse matches a single tick application
+			SubstepSwingingForce = Force;
+			bSubstepAccelChange = bAccelerationChange;
+		}
+		else
+		{
+			Capsule->AddForce(Force, NAME_None, bAccelerationChange);
+		}
 	}
 	else
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_SwingUpdateCore);
+		ReportError(EGrapplingHookError::GE_SwingUpdateCore);
 	}
 
 	CurrentSwingingForce = FVector::ZeroVector;
-}
-void UGrapplingHookComponent::UpdateRetractGrapple(const float Deltatime)
-{
-	RetractTime += Deltatime;
-	bool RetractOver = true;
-	if (Hook)
+
+	BeginSwingReel();
+
+	//A single rope is simulated by the physics constraint, multiple ropes are solved together so that no constraint per hook is needed
+	if (NumSwinging == 1)
 	{
-		bool bValid = true;
-		const FVector StartLocation = GetGrappleStartLocation(bValid);
-		if (!bValid)
+		if (!AcquireSwingConstraint())
 		{
-			OnGrappleError.Broadcast(EGrapplingHookError::GE_RetractUpdateCore);
+			ReportError(EGrapplingHookError::GE_SwingActivationCore);
+			StopGrappleAt(LastSwingingIndex);
+			return;
 		}
-
-		const FVector HookLocation = Hook->GetActorLocation();
-		const float Alpha = FMath::Clamp((CurrentRetractDuration == 0.f ? 1.f : RetractTime / CurrentRetractDuration), 0.f, 1.f);
-
-		const FVector NewLocation = UKismetMathLibrary::VEase(RetractStartLocation, StartLocation, Alpha, EEasingFunc::Type::Linear);
-		const FRotator NewRotation = UKismetMathLibrary::FindLookAtRotation(StartLocation, HookLocation);
-		Hook->SetActorLocationAndRotation(NewLocation, NewRotation, false, (FHitResult*)nullptr, ETeleportType::TeleportPhysics);
-
-		RetractOver = GetGrappleLength(bValid) <= RetractDistanceTollerance;
-		if (!bValid)
+		if (ConstrainedHookIndex != LastSwingingIndex)
 		{
-			OnGrappleError.Broadcast(EGrapplingHookError::GE_RetractUpdateCore);
+			ConstrainSwing(LastSwingingIndex);
 		}
 	}
 	else
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_RetractUpdateCore);
+		ReleaseSwingConstraint();
 	}
 
-	if (RetractOver)
+	if (!Capsule)
+	{
+		SubstepSwingRopes.Reset();
+		return;
+	}
+	GatherSwingRopes(bSubstep ? Body->GetUnrealWorldTransform() : Capsule->GetComponentTransform(), SubstepSwingRopes);
+
+	if (bSubstep)
+	{
+		//Custom physics is consumed by the simulation of a single frame, it has to be registered again every tick
+		if (!SubstepSwingDelegate.IsBound())
+		{
+			SubstepSwingDelegate.BindUObject(this, &UGrapplingHookComponent::SubstepSwing);
+		}
+		Body->AddCustomPhysics(SubstepSwingDelegate);
+	}
+	else
 	{
-		EndRetractPhase();
+		SolveSwingRopes(Deltatime);
 	}
 }
-bool UGrapplingHookComponent::GetCooldownTimerInfo(float& OutTimeLeft, float& OutTimeElapsed) const
+void UGrapplingHookComponent::SolveSwingRopes(const float Deltatime)
 {
-	const UWorld* const World = GetWorld();
-	if (World)
+	UCapsuleComponent* const Capsule = Owner ? Owner->GetCapsuleComponent() : nullptr;
+	if (!Capsule || Deltatime <= 0.f || SubstepSwingRopes.Num() == 0)
 	{
-		FTimerManager& Manager = World->GetTimerManager();
-		OutTimeLeft = Manager.GetTimerRemaining(CooldownTimerHandle);
-		OutTimeElapsed = Manager.GetTimerElapsed(CooldownTimerHandle);
-		return Manager.TimerExists(CooldownTimerHandle);
+		return;
 	}
-	return false;
+
+	const FVector Velocity = Capsule->GetPhysicsLinearVelocity();
+	const FVector NewVelocity = StepSwingRopes(Capsule->GetComponentTransform(), Velocity, Deltatime);
+	if (!NewVelocity.Equals(Velocity))
+	{
+		Capsule->SetPhysicsLinearVelocity(NewVelocity);
+	}
+	StoreReeledRopeLengths();
 }
-void UGrapplingHookComponent::BeginPlay()
+void UGrapplingHookComponent::GatherSwingRopes(const FTransform& BodyTransform, TArray<FGrapplingHookSwingRope>& OutRopes) const
 {
-	Super::BeginPlay();
-	if (bInitializeCoreOnBeginPlay || bInitializeNonCoreOnBeginPlay)
+	OutRopes.Reset();
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
 	{
-		AActor* const ActorOwner = GetOwner();
-		UCableComponent* InCable = nullptr;
-		ACharacter* InCharacter = nullptr;
-		UPhysicsHandleComponent* InHandle = nullptr;
-		UPhysicsConstraintComponent* InConstraint = nullptr;
-		UAudioComponent* InAudio = nullptr;
-
-		if (ActorOwner)
-		{
-			InCharacter = Cast<ACharacter>(ActorOwner);
-			UActorComponent* const ComponentCable = ActorOwner->GetComponentByClass(UCableComponent::StaticClass());
-			UActorComponent* const ComponentAudio = ActorOwner->GetComponentByClass(UAudioComponent::StaticClass());
-			UActorComponent* const ComponentHandle = ActorOwner->GetComponentByClass(UPhysicsHandleComponent::StaticClass());
-			UActorComponent* const ComponentConstraint = ActorOwner->GetComponentByClass(UPhysicsConstraintComponent::StaticClass());
-			if (ComponentCable)
-			{
-				InCable = Cast<UCableComponent>(ComponentCable);
-			}
-			if (ComponentAudio)
-			{
-				InAudio = Cast<UAudioComponent>(ComponentAudio);
-			}
-			if (ComponentHandle)
-			{
-				InHandle = Cast<UPhysicsHandleComponent>(ComponentHandle);
-			}
-			if (ComponentConstraint)
-			{
-				InConstraint = Cast<UPhysicsConstraintComponent>(ComponentConstraint);
-			}
+		const FGrapplingHookInstance& Instance = Hooks[HookIndex];
+		if (Instance.CurrentState != EGrapplingHookState::GS_Swing || !Instance.bActivatedSwing)
+		{
+			continue;
 		}
 
-		if (bInitializeCoreOnBeginPlay)
+		bool bValidStart = true;
+		bool bValidEnd = true;
+		const FVector Start = GetGrappleStartLocation(bValidStart, HookIndex);
+		const FVector End = GetGrappleEndLocation(bValidEnd, HookIndex);
+		if (!bValidStart || !bValidEnd)
 		{
-			Initialize(InCharacter, InCable);
+			continue;
 		}
-		if (bInitializeNonCoreOnBeginPlay)
-		{
-			SetSwingConstraintComponent(InConstraint);
-			SetPullHandleComponent(InHandle);
-			SetAudioComponent(InAudio);
-			SetNoiseInstigator(ActorOwner);
+
+		FGrapplingHookSwingRope& Rope = OutRopes.AddDefaulted_GetRef();
+		Rope.LocalStart = BodyTransform.InverseTransformPosition(Start);
+		Rope.Anchor = End;
+		Rope.Length = Instance.RopeLength;
+		Rope.HookIndex = HookIndex;
+		Rope.bConstrained = HookIndex == ConstrainedHookIndex;
+	}
+}
+FVector UGrapplingHookComponent::SolveSwingRopeVelocity(const FTransform& BodyTransform, const FVector& Velocity, const TArray<FGrapplingHookSwingRope>& Ropes, const float Deltatime)
+{
+	//Fraction of the rope stretch corrected per second, independent of the number of steps the frame is split in
+	static const float StretchCorrectionRate = 12.f;
+
+	FVector OutVelocity = Velocity;
+	for (const FGrapplingHookSwingRope& Rope : Ropes)
+	{
+		//Enforced by the physics constraint
+		if (Rope.bConstrained)
+		{
+			continue;
+		}
+		const FVector Segment = BodyTransform.TransformPosition(Rope.LocalStart) - Rope.Anchor;
+		const float Length = Segment.Size();
+		if (Length <= Rope.Length || Length <= KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		//Taut rope: remove the outward radial velocity and pull back part of the stretch
+		const FVector Normal = Segment / Length;
+		const float RadialSpeed = FVector::DotProduct(OutVelocity, Normal);
+		if (RadialSpeed > 0.f)
+		{
+			OutVelocity -= Normal * RadialSpeed;
 		}
+		OutVelocity -= Normal * ((Length - Rope.Length) * FMath::Min(StretchCorrectionRate, 1.f / Deltatime));
 	}
+	return OutVelocity;
 }
-bool UGrapplingHookComponent::IsGrappleActive() const
+void UGrapplingHookComponent::ReelSwingRopes(const FTransform& BodyTransform, FVector& InOutVelocity, const float Deltatime)
+{
+	if (SubstepReelSpeed == 0.f)
+	{
+		return;
+	}
+
+	for (FGrapplingHookSwingRope& Rope : SubstepSwingRopes)
+	{
+		const float NewLength = FMath::Clamp(Rope.Length + SubstepReelSpeed * Deltatime, SubstepMinRopeLength, SubstepMaxRopeLength);
+		if (NewLength == Rope.Length || Rope.Length <= KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		//The constraint frame of a constrained rope is moved on the game thread, its speed-up is applied there in the same step (see StoreReeledRopeLengths)
+		if (!Rope.bConstrained)
+		{
+			ConserveReeledMomentum(BodyTransform, Rope, NewLength, InOutVelocity);
+		}
+		Rope.Length = NewLength;
+	}
+}
+void UGrapplingHookComponent::ConserveReeledMomentum(const FTransform& BodyTransform, const FGrapplingHookSwingRope& Rope, const float NewLength, FVector& InOutVelocity)
+{
+	const FVector Segment = BodyTransform.TransformPosition(Rope.LocalStart) - Rope.Anchor;
+	const float Length = Segment.Size();
+	//A taut rope being shortened conserves the angular momentum around its anchor by speeding up the tangential velocity
+	if (NewLength < Rope.Length && NewLength > KINDA_SMALL_NUMBER && Length >= Rope.Length - KINDA_SMALL_NUMBER && Length > KINDA_SMALL_NUMBER)
+	{
+		const FVector Normal = Segment / Length;
+		const FVector Radial = Normal * FVector::DotProduct(InOutVelocity, Normal);
+		InOutVelocity = Radial + (InOutVelocity - Radial) * (Rope.Length / NewLength);
+	}
+}
+FVector UGrapplingHookComponent::StepSwingRopes(const FTransform& BodyTransform, const FVector& Velocity, const float Deltatime)
 {
-	return CurrentState != EGrapplingHookState::GS_Disabled && CurrentState != EGrapplingHookState::GS_Ready;
+	FVector NewVelocity = Velocity;
+	ReelSwingRopes(BodyTransform, NewVelocity, Deltatime);
+	return SolveSwingRopeVelocity(BodyTransform, NewVelocity, SubstepSwingRopes, Deltatime);
 }
-EGrapplingHookState UGrapplingHookComponent::GetCurrentState() const
+void UGrapplingHookComponent::BeginSwingReel()
 {
-	return CurrentState;
+	//Lengths reeled by the previous frame substeps
+	StoreReeledRopeLengths();
+	SubstepReelSpeed = GetReelSpeed();
+	SubstepMinRopeLength = MinRopeLength;
+	SubstepMaxRopeLength = FMath::Max(BreakDistance, MinRopeLength);
+	CurrentReelInput = 0.f;
 }
-void UGrapplingHookComponent::LaunchGrapple()
+void UGrapplingHookComponent::StoreReeledRopeLengths()
 {
-	if (CurrentState != EGrapplingHookState::GS_Ready)
+	for (const FGrapplingHookSwingRope& Rope : SubstepSwingRopes)
 	{
-		return;
+		if (Hooks.IsValidIndex(Rope.HookIndex) && Hooks[Rope.HookIndex].bActivatedSwing)
+		{
+			FGrapplingHookInstance& Instance = Hooks[Rope.HookIndex];
+			if (Rope.bConstrained && Rope.HookIndex == ConstrainedHookIndex && Rope.Length != Instance.RopeLength)
+			{
+				//The speed-up of the reeled length is applied with the frame move, the constraint holds the old length until then
+				UCapsuleComponent* const Capsule = Owner ? Owner->GetCapsuleComponent() : nullptr;
+				if (Capsule)
+				{
+					FGrapplingHookSwingRope Reeled = Rope;
+					Reeled.Length = Instance.RopeLength;
+					const FVector Velocity = Capsule->GetPhysicsLinearVelocity();
+					FVector NewVelocity = Velocity;
+					ConserveReeledMomentum(Capsule->GetComponentTransform(), Reeled, Rope.Length, NewVelocity);
+					if (!NewVelocity.Equals(Velocity))
+					{
+						Capsule->SetPhysicsLinearVelocity(NewVelocity);
+					}
+				}
+				ReelSwingConstraint(Instance.RopeLength, Rope.Length);
+			}
+			Instance.RopeLength = Rope.Length;
+		}
 	}
-
-	if (!Cable)
+}
+void UGrapplingHookComponent::ReelSwingConstraint(const float OldLength, const float NewLength)
+{
+	if (!SwingConstraint || NewLength == OldLength)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_HookSpawnCable);
 		return;
 	}
-
-	UWorld* const World = GetWorld();
-	if (!World)
+	//The constraint limits are kept, only its frame on the owner body is moved along the rope by the length change.
+	//The measured frame is offset rather than scaled by the rope lengths, the grapple start is not the body origin and ratios would accumulate drift
+	const FVector Frame = SwingConstraint->ConstraintInstance.Pos2;
+	const float FrameLength = Frame.Size();
+	if (FrameLength <= KINDA_SMALL_NUMBER)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_HookSpawnWorld);
 		return;
 	}
-
-	FActorSpawnParameters SpawnParams;
-	SpawnParams.Instigator = Owner;
-	SpawnParams.Owner = Owner;
-	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	AActor* const SpawnedActor = World->SpawnActor(HookClass.Get(), &Cable->GetComponentTransform(), SpawnParams);
-
-	if (!SpawnedActor)
+	const float NewFrameLength = FMath::Max(FrameLength + NewLength - OldLength, KINDA_SMALL_NUMBER);
+	SwingConstraint->SetConstraintReferencePosition(EConstraintFrame::Frame2, Frame * (NewFrameLength / FrameLength));
+}
+float UGrapplingHookComponent::GetReelSpeed() const
+{
+	const float Input = FMath::Clamp(CurrentReelInput, -1.f, 1.f);
+	return Input > 0.f ? -Input * ReelInSpeed : -Input * ReelOutSpeed;
+}
+void UGrapplingHookComponent::ReelRope(const float Input)
+{
+	if (IsAnyHookInState(EGrapplingHookState::GS_Swing))
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_HookSpawnInstanceActor);
-		return;
+		CurrentReelInput += Input;
 	}
-
-	AProjectileHook* const SpawnedHook = Cast<AProjectileHook>(SpawnedActor);
-	if (!SpawnedHook)
+}
+float UGrapplingHookComponent::GetRopeLength(const int32 HookIndex) const
+{
+	return Hooks.IsValidIndex(HookIndex) && Hooks[HookIndex].bActivatedSwing ? Hooks[HookIndex].RopeLength : 0.f;
+}
+void UGrapplingHookComponent::SubstepSwing(float Deltatime, FBodyInstance* BodyInstance)
+{
+	//Runs inside the physics simulation: only the data gathered by UpdateSwing is used
+	if (!BodyInstance || Deltatime <= 0.f)
 	{
-		SpawnedActor->Destroy();
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_HookSpawnInstanceProjectile);
 		return;
 	}
 
-	Hook = SpawnedHook;
-	Hook->ReleaseContrainedBody();
-	Hook->MaxDistance = BreakDistance;
-	Cable->SetVisibility(true, true);
-	Hook->StartSimulation(Cable);
-
-	if (IsUFlagNotSet(Activation, EGrapplingHookActivation::GA_Extending))
+	if (!SubstepSwingingForce.IsZero())
 	{
-		FHitResult Hit;
-		Hook->AddActorWorldOffset(Cable->GetForwardVector() * BreakDistance, true, &Hit, ETeleportType::TeleportPhysics);
-		HookLanded(Hit.ImpactNormal, Hit.Component.Get());
-		return;
+		BodyInstance->AddForce(SubstepSwingingForce, false, bSubstepAccelChange);
 	}
-	SetCurrentState(EGrapplingHookState::GS_Extending);
-
-	PlaySound(ActivatedSound);
 
-	FScriptDelegate Delegate;
-	Delegate.BindUFunction(this, TEXT("HookLanded"));
-	Hook->OnHookStopped.Add(Delegate);
+	if (SubstepSwingRopes.Num() > 0)
+	{
+		const FVector Velocity = BodyInstance->GetUnrealWorldVelocity();
+		const FVector NewVelocity = StepSwingRopes(BodyInstance->GetUnrealWorldTransform(), Velocity, Deltatime);
+		if (!NewVelocity.Equals(Velocity))
+		{
+			BodyInstance->SetLinearVelocity(NewVelocity, false);
+		}
+	}
 }
-void UGrapplingHookComponent::HookLanded(const FVector HitNormal, UPrimitiveComponent* const HitComponent)
+void UGrapplingHookComponent::UpdateRetractGrapple(const int32 HookIndex, const float Deltatime)
 {
-	if (Hook)
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	const FGrapplingHookUpdateResult& Update = GetHookUpdate(HookIndex, Deltatime);
+	Instance.RetractClock = Update.RetractClock;
+	bool RetractOver = true;
+	if (Instance.Hook)
 	{
-		FScriptDelegate Delegate;
-		Delegate.BindUFunction(this, TEXT("HookLanded"));
-		Hook->OnHookStopped.Remove(Delegate);
+		if (!Update.bValidStart)
+		{
+			ReportError(EGrapplingHookError::GE_RetractUpdateCore);
+		}
+
+		Instance.Hook->SetActorLocationAndRotation(Update.RetractLocation, Update.RetractRotation, false, (FHitResult*)nullptr, ETeleportType::TeleportPhysics);
+
+		RetractOver = Update.bRetractOver;
+		if (!Update.bValidStart || !Update.bValidEnd)
+		{
+			ReportError(EGrapplingHookError::GE_RetractUpdateCore);
+		}
+	}
+	else
+	{
+		ReportError(EGrapplingHookError::GE_RetractUpdateCore);
 	}
 
-	ValutateCollision(HitNormal, HitComponent, HitComponent);
-}
-void UGrapplingHookComponent::ResetComponentState()
-{
-	StopGrapple();
-	EndRetractPhase();
-	OnEnableGrapple();
+	if (RetractOver)
+	{
+		EndRetractPhase(HookIndex);
+	}
 }
-UPhysicsHandleComponent* UGrapplingHookComponent::GetPullHandleComponent() const
+bool UGrapplingHookComponent::GetCooldownTimerInfo(float& OutTimeLeft, float& OutTimeElapsed, const int32 HookIndex) const
 {
-	return PullHandle;
+	const FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+	if (TimerWheel && Hooks.IsValidIndex(HookIndex))
+	{
+		return TimerWheel->GetTimerInfo(Hooks[HookIndex].CooldownTimerHandle, OutTimeLeft, OutTimeElapsed);
+	}
+	return false;
 }
-void UGrapplingHookComponent::SetPullHandleComponent(UPhysicsHandleComponent* const InHandle)
+FGrapplingHookTimerWheel* UGrapplingHookComponent::GetTimerWheel() const
 {
-	PullHandle = InHandle;
+	if (bDeterministic)
+	{
+		if (!DeterministicTimerWheel.IsValid())
+		{
+			DeterministicTimerWheel = MakeUnique<FGrapplingHookTimerWheel>();
+		}
+		return DeterministicTimerWheel.Get();
+	}
+	FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Get(GetWorld());
+	return WorldData ? &WorldData->GetTimerWheel() : nullptr;
 }
-UPhysicsConstraintComponent* UGrapplingHookComponent::GetSwingConstraintComponent() const
+void UGrapplingHookComponent::PostLoad()
 {
-	return SwingConstraint;
+	Super::PostLoad();
+	RetractEasing.Bake(RetractCurve);
 }
-void UGrapplingHookComponent::SetSwingConstraintComponent(UPhysicsConstraintComponent* const InSwingConstraint)
+UCurveFloat* UGrapplingHookComponent::GetRetractCurve() const
 {
-	SwingConstraint = InSwingConstraint;
+	return RetractCurve;
 }
-void UGrapplingHookComponent::Initialize(ACharacter* const InOwner, UCableComponent* const InCable)
+void UGrapplingHookComponent::SetRetractCurve(UCurveFloat* const InCurve)
 {
-	ResetComponentState();
-	Owner = InOwner;
-	Cable = InCable;
+	RetractCurve = InCurve;
+	RetractEasing.Bake(RetractCurve);
 }
-void UGrapplingHookComponent::AddSwingingForce(const FVector& Force, const bool bInAccelChange)
+void UGrapplingHookComponent::BeginPlay()
 {
-	if (CurrentState == EGrapplingHookState::GS_Swing)
+	Super::BeginPlay();
+	//Components spawned at runtime are not loaded
+	if (RetractEasing.GetBakedCurve() != RetractCurve)
 	{
-		this->bAccelChange = bInAccelChange;
-		CurrentSwingingForce += (Force * SwingingStrength);
+		RetractEasing.Bake(RetractCurve);
 	}
-}
-FString UGrapplingHookComponent::GetErrorInfo(const EGrapplingHookError Error) const
-{
-	FString Message = TEXT("None");
-	switch (Error)
+	FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Get(GetWorld());
+	if (WorldData)
 	{
-	case EGrapplingHookError::GE_HookSpawnCable:
-		Message = TEXT("The spawn of the AProjectileHook did not succeed because no Cable reference was set");
-		break;
-	case EGrapplingHookError::GE_HookSpawnInstanceActor:
-		Message = TEXT("The spawn of the AProjectileHook did not succeed");
-		break;
-	case EGrapplingHookError::GE_HookSpawnInstanceProjectile:
-		Message = TEXT("The spawn of the AProjectileHook did not succeed (Failed Cast to AProjectileHook)");
-		break;
-	case EGrapplingHookError::GE_HookSpawnWorld:
-		Message = TEXT("The spawn of the AProjectileHook did not succeed because no World was found");
-		break;
-	case EGrapplingHookError::GE_LaunchUpdateCore:
-		Message = TEXT("The Launch update failed due to missing core elements (Owner, Cable)");
-		break;
-	case EGrapplingHookError::GE_PullActivationCore:
-		Message = TEXT("The Pull Activation failed due to missing core elements (PullHandle, Cable)");
-		break;
-	case EGrapplingHookError::GE_PullUpdateCore:
-		Message = TEXT("The Pull update failed due to missing core elements (PullHandle, Cable)");
-		break;
-	case EGrapplingHookError::GE_RetractUpdateCore:
-		Message = TEXT("The Retract update failed due to missing core elements (Owner, Capsule, Cable)");
-		break;
-	case EGrapplingHookError::GE_SwingActivationCore:
-		Message = TEXT("The Swing activation failed due to missing core elements (Owner, Owner movement component,Capsule, Cable, SwingConstraint)");
-		break;
-	case EGrapplingHookError::GE_SwingUpdateCore:
-		Message = TEXT("The Swing update failed due to missing core elements (Owner, Capsule, Cable)");
-		break;
-	case EGrapplingHookError::GE_UpdateCore:
-		Message = TEXT("The update failed due to missing core elements (Owner, Cable, Hook)");
-		break;
-	default:
-		break;
+		WorldData->RegisterGrappler(this);
+	}
+	if (bInitializeCoreOnBeginPlay || bInitializeNonCoreOnBeginPlay)
+	{
+		if (bDeferInitialization && WorldData)
+		{
+			bInitializationPending = true;
+			WorldData->QueueInitialization(this);
+		}
+		else
+		{
+			InitializeFromOwner();
+		}
 	}
-	return Message;
 }
-void UGrapplingHookComponent::InterruptPull()
+bool UGrapplingHookComponent::IsInitializationPending() const
+{
+	return bInitializationPending;
+}
+void UGrapplingHookComponent::InitializeFromOwner()
 {
-	if (PullHandle)
+	bInitializationPending = false;
+	AActor* const ActorOwner = GetOwner();
+	FGrapplingHookOwnerComponents Components;
+	FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Get(GetWorld());
+	if (WorldData)
 	{
-		PullHandle->ReleaseComponent();
+		WorldData->GetComponentCache().Resolve(ActorOwner, GetFName(), Components);
 	}
-	if (GrappledObject)
+	else if (ActorOwner)
 	{
-		const FVector Velocity = GrappledObject->GetPhysicsLinearVelocity();
-		GrappledObject->SetPhysicsLinearVelocity(Velocity.GetClampedToMaxSize(PullMaxInterruptVelocity));
+		FGrapplingHookComponentCache Cache;
+		Cache.Resolve(ActorOwner, GetFName(), Components);
 	}
-	GrappledObject = nullptr;
-}
-void UGrapplingHookComponent::InterruptSwing()
-{
-	CurrentSwingingForce = FVector::ZeroVector;
-	if (SwingConstraint)
+
+	if (bInitializeCoreOnBeginPlay)
 	{
-		SwingConstraint->SetConstrainedComponents(nullptr, NAME_None, nullptr, NAME_None);
+		Initialize(Cast<ACharacter>(ActorOwner), Components.Cables.Num() > 0 ? Components.Cables[0] : nullptr);
+		//Additional hooks use the following cables of the owner, in order
+		for (int32 HookIndex = 1; HookIndex < Hooks.Num() && HookIndex < Components.Cables.Num(); ++HookIndex)
+		{
+			SetHookCable(HookIndex, Components.Cables[HookIndex]);
+		}
 	}
-	if (Owner)
+	if (bInitializeNonCoreOnBeginPlay)
 	{
-		FVector EndVelocity = Owner->GetVelocity();
-		UCapsuleComponent* const Capsule = Owner->GetCapsuleComponent();
-		if (Capsule)
+		SetSwingConstraintComponent(Components.Constraint);
+		SetPullHandleComponent(Components.Handle);
+		//Owners without their own physics components lease them, the pool is filled before the first grapple
+		if (bUsePhysicsPool && (!Components.Constraint || !Components.Handle) && WorldData)
 		{
-			EndVelocity = Capsule->GetPhysicsLinearVelocity();
-			Capsule->SetAllPhysicsLinearVelocity(FVector::ZeroVector);
-			Capsule->SetAllPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
-			Capsule->SetSimulatePhysics(false);
-			Capsule->SetWorldRotation(FRotator(0.f, Capsule->GetComponentRotation().Yaw, 0.f));
+			WorldData->GetPhysicsPool().Prewarm();
 		}
-		UCharacterMovementComponent* const MoveComponent = Owner->GetCharacterMovement();
-		if (MoveComponent)
+		SetAudioComponent(Components.Audio);
+		SetNoiseInstigator(ActorOwner);
+	}
+}
+bool UGrapplingHookComponent::IsGrappleActive() const
+{
+	for (const FGrapplingHookInstance& Instance : Hooks)
+	{
+		if (Instance.CurrentState != EGrapplingHookState::GS_Disabled && Instance.CurrentState != EGrapplingHookState::GS_Ready)
 		{
-			MoveComponent->SetActive(true, true);
+			return true;
 		}
-		Owner->LaunchCharacter(EndVelocity, true, true);
-		Owner->bUseControllerRotationYaw = true;
 	}
+	return false;
 }
-UPrimitiveComponent* UGrapplingHookComponent::GetGrappledObject() const
+EGrapplingHookState UGrapplingHookComponent::GetCurrentState(const int32 HookIndex) const
 {
-	return GrappledObject;
+	return Hooks.IsValidIndex(HookIndex) ? Hooks[HookIndex].CurrentState : EGrapplingHookState::GS_Disabled;
 }
-AProjectileHook* UGrapplingHookComponent::GetHook() const
+int32 UGrapplingHookComponent::GetHookCount() const
 {
-	return Hook;
+	return Hooks.Num();
 }
-void UGrapplingHookComponent::StopGrapple()
+UCableComponent* UGrapplingHookComponent::GetHookCable(const int32 HookIndex) const
 {
-	bActivatedSwing = false;
-
-	if (Hook)
+	return Hooks.IsValidIndex(HookIndex) ? Hooks[HookIndex].Cable : nullptr;
+}
+void UGrapplingHookComponent::SetHookCable(const int32 HookIndex, UCableComponent* const InCable)
+{
+	if (Hooks.IsValidIndex(HookIndex))
 	{
-		Hook->InterruptProjectileMovement(true);
-		Hook->ReleaseContrainedBody();
-	}
+		//The buffered launch is held back while the hook is reset (OnEnableHook would fire it on the old cable), it is performed with the new cable
+		const bool bWasLaunchBuffered = bLaunchBuffered;
+		bLaunchBuffered = false;
+		StopGrappleAt(HookIndex);
+		EndRetractPhase(HookIndex);
+		OnEnableHook(HookIndex);
+		FGrapplingHookInstance& Instance = Hooks[HookIndex];
+		if (Instance.bLazyCable && Instance.Cable && Instance.Cable != InCable)
+		{
+			Instance.Cable->DestroyComponent();
+		}
+		Instance.bLazyCable = false;
+		Instance.Cable = InCable;
 
+		bLaunchBuffered = bLaunchBuffered || bWasLaunchBuffered;
+		if (Instance.CurrentState == EGrapplingHookState::GS_Ready)
+		{
+			ConsumeBufferedLaunch(HookIndex);
+		}
+	}
+}
+void UGrapplingHookComponent::LaunchGrapple()
+{
+	LaunchGrappleAt(INDEX_NONE);
+}
+void UGrapplingHookComponent::LaunchGrappleAt(const int32 HookIndex)
+{
 	const UWorld* const World = GetWorld();
-	if (World)
+	LaunchInputTime = World ? World->GetRealTimeSeconds() : 0.0;
+	LaunchInputFrame = GFrameCounter;
+	bLaunchBuffered = false;
+	if (TryLaunchHook(HookIndex) || TryChainHook(HookIndex))
 	{
-		FTimerManager& TimerManager = World->GetTimerManager();
-		TimerManager.ClearTimer(GroundCheckTimerHandle);
+		return;
 	}
 
-	switch (CurrentState)
+	//Not ready yet (cooldown, retract): the input is kept and performed as soon as the hook is ready
+	if (InputBufferWindow > 0.f && (HookIndex == INDEX_NONE || Hooks.IsValidIndex(HookIndex)))
 	{
-	case EGrapplingHookState::GS_Launch:
-		break;
-	case EGrapplingHookState::GS_Pull:
-		InterruptPull();
-		break;
-	case EGrapplingHookState::GS_Swing:
-		InterruptSwing();
-		break;
-	case EGrapplingHookState::GS_Missed:
-		break;
-	case EGrapplingHookState::GS_Extending:
-		HookLanded(FVector::ZeroVector, nullptr);
-		break;
-	case EGrapplingHookState::GS_Ready:
-	case EGrapplingHookState::GS_Disabled:
-	case EGrapplingHookState::GS_Retracting:
-	default:
-		return;
+		//Game time: the window is paused and dilated along with the cooldown and retract it waits for
+		bLaunchBuffered = true;
+		BufferedLaunchHookIndex = HookIndex;
+		BufferedLaunchExpireTime = GetSimulationTime() + InputBufferWindow;
 	}
-
-	bool bValid = true;
-	RetractTime = 0.f;
-	CurrentRetractDuration = BreakDistance == 0.f ? RetractDuration : (RetractDuration * (GetGrappleLength(bValid) / BreakDistance));
-	RetractStartLocation = GetGrappleEndLocation(bValid);
-
-	GrappledObject = nullptr;
-	PreRetractingState = CurrentState;
-	SetCurrentState(EGrapplingHookState::GS_Retracting);
-	PlaySound(InterruptedSound);
-	OnGrappleInterrupted.Broadcast(CurrentState);
-	if (IsUFlagNotSet(Activation, EGrapplingHookActivation::GA_Retracting))
+	else
 	{
-		EndRetractPhase();
+		LaunchInputTime = -1.0;
 	}
 }
-void UGrapplingHookComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
+bool UGrapplingHookComponent::IsLaunchBuffered() const
 {
-	Super::OnComponentDestroyed(bDestroyingHierarchy);
-	ResetComponentState();
+	return bLaunchBuffered && GetSimulationTime() <= BufferedLaunchExpireTime;
 }
-void UGrapplingHookComponent::EndRetractPhase()
+void UGrapplingHookComponent::ClearBufferedLaunch()
 {
-	if (Cable)
+	if (bLaunchBuffered)
 	{
-		Cable->SetVisibility(false, true);
+		bLaunchBuffered = false;
+		LaunchInputTime = -1.0;
 	}
-	if (Hook)
+}
+int32 UGrapplingHookComponent::GetDeterministicStateHash(int32& OutFrame) const
+{
+	OutFrame = static_cast<int32>(DeterministicFrame);
+	return static_cast<int32>(DeterministicStateHash);
+}
+bool UGrapplingHookComponent::GetLastLaunchLatency(float& OutMilliseconds, int32& OutFrames) const
+{
+	OutMilliseconds = FMath::Max(LastLaunchLatencyMs, 0.f);
+	OutFrames = LastLaunchLatencyFrames;
+	return LastLaunchLatencyMs >= 0.f;
+}
+void UGrapplingHookComponent::ConsumeBufferedLaunch(const int32 HookIndex)
+{
+	if (!bLaunchBuffered || (BufferedLaunchHookIndex != INDEX_NONE && BufferedLaunchHookIndex != HookIndex))
 	{
-		Hook->Destroy();
-		Hook = nullptr;
+		return;
 	}
-
-	float Cooldown = UGrapplingHookComponent::MinTimerValue;
-	switch (PreRetractingState)
+	if (!IsLaunchBuffered())
 	{
-	case EGrapplingHookState::GS_Launch:
-		Cooldown = LaunchCooldown;
-		break;
-	case EGrapplingHookState::GS_Pull:
-		Cooldown = PullCooldown;
-		break;
-	case EGrapplingHookState::GS_Swing:
-		Cooldown = SwingCooldown;
-		break;
-	case EGrapplingHookState::GS_Missed:
-		Cooldown = MissedCooldown;
-		break;
-	case EGrapplingHookState::GS_Ready:
-	case EGrapplingHookState::GS_Disabled:
-	case EGrapplingHookState::GS_Retracting:
-	case EGrapplingHookState::GS_Extending:
-	default:
-		break;
+		ClearBufferedLaunch();
+		return;
 	}
-
-	RestartCooldown(Cooldown);
+	bLaunchBuffered = false;
+	LaunchHook(HookIndex);
 }
-void UGrapplingHookComponent::DetachGrappledObject()
+bool UGrapplingHookComponent::TryLaunchHook(const int32 HookIndex)
 {
-	if (GrappledObject)
+	if (HookIndex == INDEX_NONE)
 	{
-		StopGrapple();
-	}
-}
-UPrimitiveComponent* UGrapplingHookComponent::StartActiveGrapplePhase(UPrimitiveComponent* const InGrappledObject)
+		for (int32 Index = 0; Index < Hooks.Num(); ++Index)
+		{
+			if (Hooks[Index].CurrentState == EGrapplingHookState::GS_Ready)
+			{
+				LaunchHook(Index);
+				return true;
+			}
+		}
+		return false;
+	}
+	if (!Hooks.IsValidIndex(HookIndex) || Hooks[HookIndex].CurrentState != EGrapplingHookState::GS_Ready)
+	{
+		return false;
+	}
+	LaunchHook(HookIndex);
+	return true;
+}
+void UGrapplingHookComponent::LaunchHook(const int32 HookIndex)
 {
-	bActivatedSwing = false;
-	this->GrappledObject = InGrappledObject;
-	RetractTime = 0.f;
-	CurrentRetractDuration = RetractDuration;
-	RetractStartLocation = FVector::ZeroVector;
+	AProjectileHook* const Hook = SpawnHook(HookIndex);
+	if (!Hook)
+	{
+		return;
+	}
+	Hooks[HookIndex].Hook = Hook;
+	StartExtending(HookIndex);
+}
+AProjectileHook* UGrapplingHookComponent::SpawnHook(const int32 HookIndex)
+{
+	if (bLazySubobjects)
+	{
+		CreateLazyCable(HookIndex);
+		FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+		if (TimerWheel)
+		{
+			TimerWheel->ClearTimer(LazyIdleTimerHandle);
+		}
+	}
 
-	SetComponentTickEnabled(true);
+	UCableComponent* const Cable = Hooks[HookIndex].Cable;
+	if (!Cable)
+	{
+		ReportError(EGrapplingHookError::GE_HookSpawnCable);
+		return nullptr;
+	}
+
+	UWorld* const World = GetWorld();
+	if (!World)
+	{
+		ReportError(EGrapplingHookError::GE_HookSpawnWorld);
+		return nullptr;
+	}
+
+	//Never loaded synchronously, the launch fails until the async load is over
+	UClass* const SpawnClass = HookClass.Get();
+	if (!SpawnClass)
+	{
+		FGrapplingHookClassLoader::Request(HookClass);
+		ReportError(EGrapplingHookError::GE_HookSpawnClassNotLoaded);
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Instigator = Owner;
+	SpawnParams.Owner = Owner;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* const SpawnedActor = World->SpawnActor(SpawnClass, &Cable->GetComponentTransform(), SpawnParams);
+
+	if (!SpawnedActor)
+	{
+		ReportError(EGrapplingHookError::GE_HookSpawnInstanceActor);
+		return nullptr;
+	}
+
+	AProjectileHook* const SpawnedHook = Cast<AProjectileHook>(SpawnedActor);
+	if (!SpawnedHook)
+	{
+		SpawnedActor->Destroy();
+		ReportError(EGrapplingHookError::GE_HookSpawnInstanceProjectile);
+		return nullptr;
+	}
 
-	return GrappledObject;
+	FCollisionResponseContainer Responses;
+	BuildHookCollisionResponses(Responses);
+	SpawnedHook->SetHookCollision(Responses, GetOwner());
+	return SpawnedHook;
 }
-void UGrapplingHookComponent::ValutateCollision(const FVector& HitNormal, UPrimitiveComponent* const InGrappledObject, const bool bHit)
+bool UGrapplingHookComponent::TryChainHook(const int32 HookIndex)
 {
-	StartActiveGrapplePhase(InGrappledObject);
-	if (!bHit || !GrappledObject || BlockingObjects.Contains(GrappledObject->GetCollisionObjectType()))
+	if (!bChainHooks)
+	{
+		return false;
+	}
+	for (int32 Index = 0; Index < Hooks.Num(); ++Index)
+	{
+		const FGrapplingHookInstance& Instance = Hooks[Index];
+		if ((HookIndex == INDEX_NONE || HookIndex == Index) && Instance.Hook && Instance.Cable &&
+			(Instance.CurrentState == EGrapplingHookState::GS_Swing || Instance.CurrentState == EGrapplingHookState::GS_Launch))
+		{
+			ChainHook(Index);
+			return true;
+		}
+	}
+	return false;
+}
+void UGrapplingHookComponent::ChainHook(const int32 HookIndex)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+
+	//The swing exit hands the physics velocity back to the character
+	LeaveHookState(HookIndex);
+	DisarmGroundedInterrupt();
+
+	Instance.Hook->RestartProjectileMovement(Instance.Cable->GetComponentTransform());
+	StartExtending(HookIndex);
+}
+void UGrapplingHookComponent::LeaveHookState(const int32 HookIndex)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	//The extending exit lands the hook, an extending hook is only unbound
+	if (Instance.CurrentState == EGrapplingHookState::GS_Extending)
+	{
+		if (Instance.Hook)
+		{
+			FScriptDelegate Delegate;
+			Delegate.BindUFunction(this, TEXT("OnHookStopped"));
+			Instance.Hook->OnHookStoppedBy.Remove(Delegate);
+		}
+	}
+	else
+	{
+		(this->*GetStateTable().ExitHook)(HookIndex);
+	}
+	Instance.bActivatedSwing = false;
+	Instance.GrappledObject = nullptr;
+	ClearAnchor(HookIndex);
+}
+void UGrapplingHookComponent::StartExtending(const int32 HookIndex)
+{
+	AProjectileHook* const Hook = Hooks[HookIndex].Hook;
+	UCableComponent* const Cable = Hooks[HookIndex].Cable;
+	FGrapplingHookTelemetry::RecordLaunch();
+	//The hook moves from this frame on
+	const UWorld* const World = GetWorld();
+	if (LaunchInputTime >= 0.0 && World)
+	{
+		//Real time: the latency felt by the player does not depend on the time dilation
+		const double Latency = World->GetRealTimeSeconds() - LaunchInputTime;
+		LastLaunchLatencyMs = static_cast<float>(Latency * 1000.0);
+		LastLaunchLatencyFrames = static_cast<int32>(GFrameCounter - LaunchInputFrame);
+		FGrapplingHookTelemetry::RecordLaunchLatency(Latency, LastLaunchLatencyFrames);
+		LaunchInputTime = -1.0;
+	}
+	Hook->ReleaseContrainedBody();
+	Hook->MaxDistance = BreakDistance;
+	Cable->SetVisibility(true, true);
+	Hook->StartSimulation(Cable);
+
+	if (!GetStateTable().bExtending)
+	{
+		if (bDeterministic)
+		{
+			//Same instant flight, stopped where the fixed point sweep finds the hook blocked
+			const FGrapplingHookFixedVector Start = FGrapplingHookFixedVector::FromVector(Hook->GetActorLocation());
+			FGrapplingHookFixedVector End = Start + FGrapplingHookFixedVector::FromVector(Cable->GetForwardVector() * BreakDistance);
+			FVector HitNormal = FVector::ZeroVector;
+			UPrimitiveComponent* HitComponent = nullptr;
+			SweepDeterministic(Hook->CollisionComponent, Start, End, HitNormal, HitComponent);
+			LandDeterministicHook(HookIndex, End, HitNormal, HitComponent);
+			return;
+		}
+		FHitResult Hit;
+		Hook->AddActorWorldOffset(Cable->GetForwardVector() * BreakDistance, true, &Hit, ETeleportType::TeleportPhysics);
+		HookLanded(Hit.ImpactNormal, Hit.Component.Get(), HookIndex);
+		return;
+	}
+	SetCurrentState(HookIndex, EGrapplingHookState::GS_Extending);
+	if (bDeterministic)
+	{
+		StartDeterministicHookFlight(HookIndex);
+	}
+
+	PlaySound(ActivatedSound);
+
+	FScriptDelegate Delegate;
+	Delegate.BindUFunction(this, TEXT("OnHookStopped"));
+	Hook->OnHookStoppedBy.Add(Delegate);
+}
+void UGrapplingHookComponent::HookLanded(const FVector HitNormal, UPrimitiveComponent* const HitComponent, const int32 HookIndex)
+{
+	if (!Hooks.IsValidIndex(HookIndex))
 	{
-		SetCurrentState(EGrapplingHookState::GS_Missed);
-		OnGrappleMissed.Broadcast();
 		return;
 	}
+	AProjectileHook* const Hook = Hooks[HookIndex].Hook;
+	if (Hook)
+	{
+		FScriptDelegate Delegate;
+		Delegate.BindUFunction(this, TEXT("OnHookStopped"));
+		Hook->OnHookStoppedBy.Remove(Delegate);
+	}
+
+	ValutateCollision(HookIndex, HitNormal, HitComponent, HitComponent);
+}
+void UGrapplingHookComponent::OnHookStopped(const FVector HitNormal, UPrimitiveComponent* const HitComponent, AProjectileHook* const StoppedHook)
+{
+	const int32 HookIndex = FindHookIndex(StoppedHook);
+	if (HookIndex != INDEX_NONE)
+	{
+		HookLanded(HitNormal, HitComponent, HookIndex);
+	}
+}
+int32 UGrapplingHookComponent::FindHookIndex(const AProjectileHook* const InHook) const
+{
+	if (InHook)
+	{
+		for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+		{
+			if (Hooks[HookIndex].Hook == InHook)
+			{
+				return HookIndex;
+			}
+		}
+	}
+	return INDEX_NONE;
+}
+bool UGrapplingHookComponent::CaptureHookSnapshot(const int32 HookIndex, FGrapplingHookSnapshot& OutSnapshot) const
+{
+	if (!Hooks.IsValidIndex(HookIndex))
+	{
+		return false;
+	}
+	const FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	OutSnapshot.Anchor = Instance.Anchor;
+	if (Instance.Anchor.IsValid())
+	{
+		OutSnapshot.Location = Instance.AnchorRelativeLocation;
+	}
 	else
 	{
-		if (IsUFlagSet(Activation, EGrapplingHookActivation::GA_Pull) && IsGrappledObjectPullable())
+		OutSnapshot.Location = Instance.Hook ? Instance.Hook->GetActorLocation() : FVector::ZeroVector;
+	}
+	OutSnapshot.SetDirection(Instance.Hook ? Instance.Hook->GetActorForwardVector() : FVector::ForwardVector);
+	OutSnapshot.RetractStartLocation = Instance.RetractStartLocation;
+	OutSnapshot.RetractClock = Instance.RetractClock;
+	OutSnapshot.RetractClockRate = Instance.RetractClockRate;
+	OutSnapshot.RopeLength = Instance.RopeLength;
+
+	float TimeLeft = 0.f;
+	float TimeElapsed = 0.f;
+	OutSnapshot.CooldownRemaining = GetCooldownTimerInfo(TimeLeft, TimeElapsed, HookIndex) ? TimeLeft : 0.f;
+
+	OutSnapshot.State = static_cast<uint8>(Instance.CurrentState);
+	OutSnapshot.PreRetractingState = static_cast<uint8>(Instance.PreRetractingState);
+	OutSnapshot.Flags = 0;
+	if (Instance.bActivatedSwing)
+	{
+		OutSnapshot.Flags |= FGrapplingHookSnapshot::FlagActivatedSwing;
+	}
+	if (Instance.Anchor.IsValid())
+	{
+		OutSnapshot.Flags |= FGrapplingHookSnapshot::FlagAnchored;
+	}
+	return true;
+}
+bool UGrapplingHookComponent::RestoreHookSnapshot(const int32 HookIndex, const FGrapplingHookSnapshot& Snapshot)
+{
+	if (!Hooks.IsValidIndex(HookIndex) || Snapshot.State >= static_cast<uint8>(EGrapplingHookState::GS_MAX) || Snapshot.PreRetractingState >= static_cast<uint8>(EGrapplingHookState::GS_MAX))
+	{
+		return false;
+	}
+	USceneComponent* const SnapshotAnchor = Snapshot.Anchor.Get();
+	if ((Snapshot.Flags & FGrapplingHookSnapshot::FlagAnchored) != 0 && !IsValid(SnapshotAnchor))
+	{
+		return false;
+	}
+
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	const EGrapplingHookState State = static_cast<EGrapplingHookState>(Snapshot.State);
+	const bool bStateChanged = Instance.CurrentState != State || Instance.Anchor.Get() != SnapshotAnchor;
+	if (bStateChanged)
+	{
+		LeaveHookState(HookIndex);
+	}
+
+	FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+	if (TimerWheel && State != EGrapplingHookState::GS_Disabled)
+	{
+		TimerWheel->ClearTimer(Instance.CooldownTimerHandle);
+	}
+
+	if (State == EGrapplingHookState::GS_Ready || State == EGrapplingHookState::GS_Disabled)
+	{
+		if (Instance.Hook)
 		{
-			SetCurrentState(EGrapplingHookState::GS_Pull);
+			Instance.Hook->Destroy();
+			Instance.Hook = nullptr;
 		}
-		else
+		if (Instance.Cable)
+		{
+			Instance.Cable->SetVisibility(false, true);
+		}
+		ResetRopeCollision(HookIndex);
+	}
+	else
+	{
+		//Only a restore from Ready or Disabled spawns an hook
+		if (!Instance.Hook)
 		{
-			if (IsUFlagSet(Activation, EGrapplingHookActivation::GA_Swing))
+			Instance.Hook = SpawnHook(HookIndex);
+			if (!Instance.Hook)
 			{
-				if (IsSurfaceSwingable(HitNormal))
-				{
-					SetCurrentState(EGrapplingHookState::GS_Swing);
-				}
-				else
-				{
-					SetCurrentState(EGrapplingHookState::GS_Missed);
-					OnGrappleMissed.Broadcast();
-					return;
-				}
+				return false;
 			}
-			else if (IsUFlagSet(Activation, EGrapplingHookActivation::GA_Launch))
+		}
+		AProjectileHook* const Hook = Instance.Hook;
+		UCableComponent* const Cable = Instance.Cable;
+		if (!Cable)
+		{
+			ReportError(EGrapplingHookError::GE_UpdateCore);
+			return false;
+		}
+
+		const FVector Location = SnapshotAnchor ? SnapshotAnchor->GetComponentTransform().TransformPosition(Snapshot.Location) : Snapshot.Location;
+		const FTransform Transform(Snapshot.GetDirection().ToOrientationQuat(), Location);
+		Hook->MaxDistance = BreakDistance;
+		Cable->SetVisibility(true, true);
+		Hook->StartSimulation(Cable);
+
+		FScriptDelegate Delegate;
+		Delegate.BindUFunction(this, TEXT("OnHookStopped"));
+		Hook->OnHookStoppedBy.Remove(Delegate);
+		if (State == EGrapplingHookState::GS_Extending)
+		{
+			Hook->RestartProjectileMovement(Transform);
+			Hook->OnHookStoppedBy.Add(Delegate);
+			if (bDeterministic)
 			{
-				SetCurrentState(EGrapplingHookState::GS_Launch);
+				StartDeterministicHookFlight(HookIndex);
 			}
-			else
+		}
+		else
+		{
+			Hook->PlaceStopped(Transform, SnapshotAnchor);
+		}
+
+		if (SnapshotAnchor)
+		{
+			if (Instance.Anchor.Get() != SnapshotAnchor)
 			{
-				SetCurrentState(EGrapplingHookState::GS_Missed);
-				OnGrappleMissed.Broadcast();
-				return;
+				SetAnchor(HookIndex, SnapshotAnchor);
 			}
+			Instance.AnchorRelativeLocation = Snapshot.Location;
+			Instance.AnchorLocation = Location;
 		}
+		const bool bLanded = State != EGrapplingHookState::GS_Extending && State != EGrapplingHookState::GS_Retracting;
+		Instance.GrappledObject = bLanded ? Cast<UPrimitiveComponent>(SnapshotAnchor) : nullptr;
 	}
-	OnGrappleActivated.Broadcast(CurrentState, GrappledObject);
 
-	const UWorld* const World = GetWorld();
-	if (World)
+	Instance.RetractStartLocation = Snapshot.RetractStartLocation;
+	Instance.RetractClock = Snapshot.RetractClock;
+	Instance.RetractClockRate = Snapshot.RetractClockRate;
+	Instance.PreRetractingState = static_cast<EGrapplingHookState>(Snapshot.PreRetractingState);
+	if (State == EGrapplingHookState::GS_Pull)
 	{
-		FTimerManager& TimerManager = World->GetTimerManager();
-		TimerManager.ClearTimer(GroundCheckTimerHandle);
-		TimerManager.SetTimer(GroundCheckTimerHandle, this, &UGrapplingHookComponent::OnCheckGrounded, GroundedCheckDelay, true);
+		PullHookIndex = HookIndex;
 	}
-}
-void UGrapplingHookComponent::RestartCooldown(const float Cooldown)
-{
-	SetComponentTickEnabled(false);
-	if (IsUFlagSet(Activation, EGrapplingHookActivation::GA_Cooldown) && Cooldown > 0.f)
+
+	if (State == EGrapplingHookState::GS_Swing && (Snapshot.Flags & FGrapplingHookSnapshot::FlagActivatedSwing) != 0)
 	{
-		OnGrappleDisabled.Broadcast(Cooldown);
-		SetCurrentState(EGrapplingHookState::GS_Disabled);
-		PreRetractingState = CurrentState;
+		if (!ActivateSwing(HookIndex))
+		{
+			return false;
+		}
+		//Same as a reel
+		if (ConstrainedHookIndex == HookIndex)
+		{
+			ReelSwingConstraint(Instance.RopeLength, Snapshot.RopeLength);
+		}
+		Instance.RopeLength = Snapshot.RopeLength;
+	}
 
-		const UWorld* const World = GetWorld();
-		if (World)
+	SetCurrentState(HookIndex, State);
+	if (State == EGrapplingHookState::GS_Disabled)
+	{
+		//A running cooldown is rescheduled in place, its callback is kept
+		if (!TimerWheel || Snapshot.CooldownRemaining <= 0.f)
 		{
-			FTimerManager& Manager = World->GetTimerManager();
-			Manager.ClearTimer(CooldownTimerHandle);
-			Manager.SetTimer(CooldownTimerHandle, this, &UGrapplingHookComponent::OnEnableGrapple, Cooldown, false);
-			return;
+			OnEnableHook(HookIndex);
+		}
+		else if (!TimerWheel->SetTimeLeft(Instance.CooldownTimerHandle, Snapshot.CooldownRemaining))
+		{
+			Instance.CooldownTimerHandle = TimerWheel->SetTimer(FSimpleDelegate::CreateUObject(this, &UGrapplingHookComponent::OnEnableHook, HookIndex), Snapshot.CooldownRemaining, false);
 		}
 	}
+	else if (State == EGrapplingHookState::GS_Ready && bStateChanged)
+	{
+		ScheduleLazyRelease();
+	}
 
-	//If either cooldown feature is not active , cooldown time is not valid or a world could not be found skip cooldown and directly enable grapple
-	OnEnableGrapple();
+	//The batched update was gathered before the restore
+	Instance.Update.Frame = 0;
+	SetComponentTickEnabled(IsAnyHookTicking() || HasPendingDeterministicTimers());
+	return true;
 }
-void UGrapplingHookComponent::OnEnableGrapple()
+int32 UGrapplingHookComponent::CaptureSnapshot(FGrapplingHookSnapshot* const OutSnapshots, const int32 MaxSnapshots) const
 {
-	const UWorld* const World = GetWorld();
-	if (World)
+	const int32 NumSnapshots = OutSnapshots ? FMath::Min(MaxSnapshots, Hooks.Num()) : 0;
+	for (int32 HookIndex = 0; HookIndex < NumSnapshots; ++HookIndex)
 	{
-		FTimerManager& Manager = World->GetTimerManager();
-		Manager.ClearTimer(CooldownTimerHandle);
+		CaptureHookSnapshot(HookIndex, OutSnapshots[HookIndex]);
 	}
-	if (CurrentState != EGrapplingHookState::GS_Ready)
+	return FMath::Max(NumSnapshots, 0);
+}
+bool UGrapplingHookComponent::RestoreSnapshot(const FGrapplingHookSnapshot* const Snapshots, const int32 NumSnapshots)
+{
+	if (!Snapshots)
 	{
-		PlaySound(ReadySound);
-		OnGrappleReady.Broadcast();
-		SetCurrentState(EGrapplingHookState::GS_Ready);
+		return false;
 	}
+	bool bRestored = NumSnapshots == Hooks.Num();
+	const int32 NumHooks = FMath::Min(NumSnapshots, Hooks.Num());
+	for (int32 HookIndex = 0; HookIndex < NumHooks; ++HookIndex)
+	{
+		bRestored = RestoreHookSnapshot(HookIndex, Snapshots[HookIndex]) && bRestored;
+	}
+	return bRestored;
 }
-EGrapplingHookActivation UGrapplingHookComponent::DiffFlags(const EGrapplingHookActivation First, const EGrapplingHookActivation Second) const
+void UGrapplingHookComponent::ResetComponentState()
 {
-	return (First & (~Second));
+	ClearBufferedLaunch();
+	StopGrapple();
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		EndRetractPhase(HookIndex);
+	}
+	OnEnableGrapple();
 }
-uint8 UGrapplingHookComponent::DiffUFlags(const uint8 First, const uint8 Second) const
+UPhysicsHandleComponent* UGrapplingHookComponent::GetPullHandleComponent() const
 {
-	return (First & (~Second));
+	return PullHandle;
 }
-void UGrapplingHookComponent::AddActivationUFlag(const uint8 InFlags)
+void UGrapplingHookComponent::SetPullHandleComponent(UPhysicsHandleComponent* const InHandle)
 {
-	Activation = SumUFlags(Activation, InFlags);
+	ReturnPooledPullHandle();
+	PullHandle = InHandle;
 }
-void UGrapplingHookComponent::AddActivationFlag(const EGrapplingHookActivation InFlags)
+UPhysicsConstraintComponent* UGrapplingHookComponent::GetSwingConstraintComponent() const
 {
-	Activation = SumUFlags(Activation, static_cast<uint8>(InFlags));
+	return SwingConstraint;
 }
-void UGrapplingHookComponent::RemoveActivationUFlag(const uint8 InFlags)
+void UGrapplingHookComponent::SetSwingConstraintComponent(UPhysicsConstraintComponent* const InSwingConstraint)
 {
-	Activation = DiffUFlags(Activation, InFlags);
+	ReleaseSwingConstraint();
+	ReturnPooledSwingConstraint();
+	SwingConstraint = InSwingConstraint;
 }
-void UGrapplingHookComponent::RemoveActivationFlag(const EGrapplingHookActivation InFlags)
+bool UGrapplingHookComponent::AcquireSwingConstraint()
 {
-	Activation = DiffUFlags(Activation, static_cast<uint8>(InFlags));
+	if (!SwingConstraint && bUsePhysicsPool)
+	{
+		FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Get(GetWorld());
+		SwingConstraint = WorldData ? WorldData->GetPhysicsPool().LeaseConstraint() : nullptr;
+		bPooledSwingConstraint = SwingConstraint != nullptr;
+	}
+	return SwingConstraint != nullptr;
 }
-
-float UGrapplingHookComponent::GetGrappleLength(bool& bOutValid) const
+bool UGrapplingHookComponent::AcquirePullHandle()
 {
-	bool bValid = true;
-	const FVector End = GetGrappleEndLocation(bValid);
-	const FVector Start = GetGrappleStartLocation(bOutValid);
-	bOutValid = bOutValid && bValid;
-	return FVector::Distance(End, Start);
+	if (!PullHandle && bUsePhysicsPool)
+	{
+		FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Get(GetWorld());
+		PullHandle = WorldData ? WorldData->GetPhysicsPool().LeaseHandle() : nullptr;
+		bPooledPullHandle = PullHandle != nullptr;
+	}
+	return PullHandle != nullptr;
 }
-void UGrapplingHookComponent::SetCurrentState(const EGrapplingHookState NewState)
+void UGrapplingHookComponent::ReturnPooledSwingConstraint()
 {
-	if (NewState != CurrentState)
+	if (!bPooledSwingConstraint)
+	{
+		return;
+	}
+	FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Find(GetWorld());
+	if (WorldData)
 	{
-		const EGrapplingHookState Previous = CurrentState;
-		CurrentState = NewState;
-		OnGrappleStateChanged.Broadcast(Previous, CurrentState);
+		WorldData->GetPhysicsPool().ReturnConstraint(SwingConstraint);
 	}
+	SwingConstraint = nullptr;
+	bPooledSwingConstraint = false;
 }
-void UGrapplingHookComponent::PlaySound(USoundBase* const Sound)
+void UGrapplingHookComponent::ReturnPooledPullHandle()
 {
-	if (Audio != nullptr)
+	if (!bPooledPullHandle)
 	{
-		Audio->SetSound(Sound);
-		Audio->Play(0.f);
+		return;
 	}
-	if (!bPerformNoise)
+	FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Find(GetWorld());
+	if (WorldData)
 	{
-		return;
+		WorldData->GetPhysicsPool().ReturnHandle(PullHandle);
 	}
-
-	bool bValid = true;
-	UAISense_Hearing::ReportNoiseEvent(this, GetGrappleStartLocation(bValid), Loudness, NoiseInstigator, MaxRange, NoiseTag);
+	PullHandle = nullptr;
+	bPooledPullHandle = false;
 }
-void UGrapplingHookComponent::UpdateOwnerLaunch(const float Deltatime)
+FGrapplingHookPhysicsPoolStats UGrapplingHookComponent::GetPhysicsPoolStats() const
 {
-	if (Owner)
+	FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Find(GetWorld());
+	return WorldData ? WorldData->GetPhysicsPool().GetStats() : FGrapplingHookPhysicsPoolStats();
+}
+void UGrapplingHookComponent::Initialize(ACharacter* const InOwner, UCableComponent* const InCable)
+{
+	ResetComponentState();
+	DestroyLazySubobjects();
+	UnbindOwnerEvents();
+	Owner = InOwner;
+
+	Hooks.Reset();
+	Hooks.SetNum(FMath::Max(HookCount, 1));
+	Hooks[0].Cable = InCable;
+
+	BindOwnerEvents();
+}
+void UGrapplingHookComponent::AddSwingingForce(const FVector& Force, const bool bInAccelChange)
+{
+	if (IsAnyHookInState(EGrapplingHookState::GS_Swing))
+	{
+		this->bAccelChange = bInAccelChange;
+		CurrentSwingingForce += (Force * SwingingStrength);
+	}
+}
+FString UGrapplingHookComponent::GetErrorInfo(const EGrapplingHookError Error) const
+{
+	return GetErrorMessage(Error);
+}
+const TCHAR* UGrapplingHookComponent::GetErrorMessage(const EGrapplingHookError Error)
+{
+	return Error < EGrapplingHookError::GE_MAX ? GrapplingHookErrorMessages[static_cast<int32>(Error)] : TEXT("None");
+}
+void UGrapplingHookComponent::InterruptPull(const int32 HookIndex)
+{
+	if (PullHandle && PullHookIndex == HookIndex)
+	{
+		PullHandle->ReleaseComponent();
+		ReturnPooledPullHandle();
+	}
+	if (PullHookIndex == HookIndex)
+	{
+		PullHookIndex = INDEX_NONE;
+	}
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	Instance.bDeterministicPulled = false;
+	if (Instance.GrappledObject)
+	{
+		const FVector Velocity = Instance.GrappledObject->GetPhysicsLinearVelocity();
+		Instance.GrappledObject->SetPhysicsLinearVelocity(Velocity.GetClampedToMaxSize(PullMaxInterruptVelocity));
+	}
+	Instance.GrappledObject = nullptr;
+}
+void UGrapplingHookComponent::InterruptTug(const int32 HookIndex)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	if (Instance.GrappledObject)
+	{
+		const FVector Velocity = Instance.GrappledObject->GetPhysicsLinearVelocity();
+		Instance.GrappledObject->SetPhysicsLinearVelocity(Velocity.GetClampedToMaxSize(PullMaxInterruptVelocity));
+	}
+	Instance.GrappledObject = nullptr;
+}
+void UGrapplingHookComponent::InterruptSwing(const int32 HookIndex)
+{
+	Hooks[HookIndex].bActivatedSwing = false;
+	if (ConstrainedHookIndex == HookIndex)
+	{
+		ReleaseSwingConstraint();
+	}
+
+	//Owner keeps swinging from the remaining hooks
+	int32 LastSwingingIndex = INDEX_NONE;
+	if (!bSwingPhysicsActive || GetNumSwingingHooks(LastSwingingIndex) > 0)
+	{
+		return;
+	}
+	bSwingPhysicsActive = false;
+
+	CurrentSwingingForce = FVector::ZeroVector;
+	SubstepSwingingForce = FVector::ZeroVector;
+	SubstepSwingRopes.Reset();
+	CurrentReelInput = 0.f;
+	SubstepReelSpeed = 0.f;
+	ReleaseSwingConstraint();
+	ReturnPooledSwingConstraint();
+	if (Owner)
+	{
+		FVector EndVelocity = Owner->GetVelocity();
+		UCapsuleComponent* const Capsule = Owner->GetCapsuleComponent();
+		if (Capsule)
+		{
+			EndVelocity = Capsule->GetPhysicsLinearVelocity();
+			Capsule->SetAllPhysicsLinearVelocity(FVector::ZeroVector);
+			Capsule->SetAllPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+			Capsule->SetSimulatePhysics(false);
+			Capsule->SetWorldRotation(FRotator(0.f, Capsule->GetComponentRotation().Yaw, 0.f));
+		}
+		UCharacterMovementComponent* const MoveComponent = Owner->GetCharacterMovement();
+		if (MoveComponent)
+		{
+			MoveComponent->SetActive(true, true);
+		}
+		Owner->LaunchCharacter(EndVelocity, true, true);
+		Owner->bUseControllerRotationYaw = true;
+	}
+}
+UPrimitiveComponent* UGrapplingHookComponent::GetGrappledObject(const int32 HookIndex) const
+{
+	return Hooks.IsValidIndex(HookIndex) ? Hooks[HookIndex].GrappledObject : nullptr;
+}
+AProjectileHook* UGrapplingHookComponent::GetHook(const int32 HookIndex) const
+{
+	return Hooks.IsValidIndex(HookIndex) ? Hooks[HookIndex].Hook : nullptr;
+}
+void UGrapplingHookComponent::StopGrapple()
+{
+	if (bStopCancelsBufferedLaunch)
+	{
+		ClearBufferedLaunch();
+	}
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		StopGrappleAt(HookIndex);
+	}
+}
+void UGrapplingHookComponent::StopGrappleAt(const int32 HookIndex)
+{
+	if (!Hooks.IsValidIndex(HookIndex))
+	{
+		return;
+	}
+
+	if (Hooks[HookIndex].Hook)
+	{
+		Hooks[HookIndex].Hook->InterruptProjectileMovement(true);
+		Hooks[HookIndex].Hook->ReleaseContrainedBody();
+	}
+
+	const FGrapplingHookStateTable& Table = GetStateTable();
+	const int32 StateIndex = static_cast<int32>(Hooks[HookIndex].CurrentState);
+	if (!Table.bInterruptible[StateIndex])
+	{
+		return;
+	}
+	(this->*Table.ExitHook)(HookIndex);
+	Hooks[HookIndex].bActivatedSwing = false;
+	DisarmGroundedInterrupt();
+
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	bool bValid = true;
+	const FVector EndLocation = GetGrappleEndLocation(bValid, HookIndex);
+	float Duration = RetractDuration;
+	if (BreakDistance != 0.f)
+	{
+		//Duration scales with the grapple length
+		const float LengthSquared = FVector::DistSquared(EndLocation, GetGrappleStartLocation(bValid, HookIndex));
+		const float Length = LengthSquared > SMALL_NUMBER ? LengthSquared * FMath::InvSqrt(LengthSquared) : 0.f;
+		Duration = RetractDuration * (Length / BreakDistance);
+	}
+	Instance.RetractClock = 0;
+	Instance.RetractClockRate = FGrapplingHookRetractClock::GetRate(Duration);
+	Instance.RetractStartLocation = EndLocation;
+
+	Instance.GrappledObject = nullptr;
+	ClearAnchor(HookIndex);
+	Instance.PreRetractingState = Instance.CurrentState;
+	SetCurrentState(HookIndex, EGrapplingHookState::GS_Retracting);
+	PlaySound(InterruptedSound);
+	OnGrappleInterrupted.Broadcast(Hooks[HookIndex].CurrentState);
+	if (!GetStateTable().bRetracting)
+	{
+		EndRetractPhase(HookIndex);
+	}
+}
+void UGrapplingHookComponent::DisarmGroundedInterrupt()
+{
+	//The grounded interruption is shared, it stays active while another hook is still launching or swinging
+	if (!IsAnyHookInState(EGrapplingHookState::GS_Swing) && !IsAnyHookInState(EGrapplingHookState::GS_Launch))
+	{
+		FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+		if (TimerWheel)
+		{
+			TimerWheel->ClearTimer(GroundedGraceTimerHandle);
+			TimerWheel->ClearTimer(GroundCheckTimerHandle);
+		}
+		bGroundedInterruptArmed = false;
+	}
+}
+void UGrapplingHookComponent::OnComponentDestroyed(bool bDestroyingHierarchy)
+{
+	Super::OnComponentDestroyed(bDestroyingHierarchy);
+	ResetComponentState();
+	UnbindOwnerEvents();
+	FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Find(GetWorld());
+	if (WorldData)
+	{
+		WorldData->UnregisterGrappler(this);
+	}
+}
+void UGrapplingHookComponent::OnRegister()
+{
+	Super::OnRegister();
+	FGrapplingHookClassLoader::Request(HookClass);
+}
+bool UGrapplingHookComponent::IsHookClassLoaded() const
+{
+	return HookClass.Get() != nullptr;
+}
+void UGrapplingHookComponent::SetHookClass(const TSoftClassPtr<AProjectileHook>& InHookClass)
+{
+	HookClass = InHookClass;
+	FGrapplingHookClassLoader::Request(HookClass);
+}
+void UGrapplingHookComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	DestroyLazySubobjects();
+	ReleaseSwingConstraint();
+	ReturnPooledSwingConstraint();
+	ReturnPooledPullHandle();
+	FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Find(GetWorld());
+	if (WorldData)
+	{
+		WorldData->UnregisterGrappler(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+void UGrapplingHookComponent::EndRetractPhase(const int32 HookIndex)
+{
+	ClearAnchor(HookIndex);
+	ResetRopeCollision(HookIndex);
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	if (Instance.Cable)
+	{
+		Instance.Cable->SetVisibility(false, true);
+	}
+	if (Instance.Hook)
+	{
+		Instance.Hook->Destroy();
+		Instance.Hook = nullptr;
+	}
+
+	float UGrapplingHookComponent::* const CooldownProperty = GetStateTable().Cooldown[static_cast<int32>(Instance.PreRetractingState)];
+	RestartCooldown(HookIndex, CooldownProperty ? this->*CooldownProperty : UGrapplingHookComponent::MinTimerValue);
+}
+void UGrapplingHookComponent::DetachGrappledObject()
+{
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		if (Hooks[HookIndex].GrappledObject)
+		{
+			StopGrappleAt(HookIndex);
+		}
+	}
+}
+UPrimitiveComponent* UGrapplingHookComponent::StartActiveGrapplePhase(const int32 HookIndex, UPrimitiveComponent* const InGrappledObject)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	Instance.bActivatedSwing = false;
+	Instance.GrappledObject = InGrappledObject;
+	Instance.RetractClock = 0;
+	Instance.RetractClockRate = FGrapplingHookRetractClock::GetRate(RetractDuration);
+	Instance.RetractStartLocation = FVector::ZeroVector;
+	SetAnchor(HookIndex, InGrappledObject);
+
+	SetComponentTickEnabled(true);
+
+	return Instance.GrappledObject;
+}
+void UGrapplingHookComponent::SetAnchor(const int32 HookIndex, USceneComponent* const InAnchor)
+{
+	ClearAnchor(HookIndex);
+	if (!InAnchor)
+	{
+		return;
+	}
+	bool bValid = true;
+	const FVector EndLocation = GetGrappleEndLocation(bValid, HookIndex);
+	if (!bValid)
+	{
+		return;
+	}
+
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	Instance.Anchor = InAnchor;
+	Instance.AnchorRelativeLocation = InAnchor->GetComponentTransform().InverseTransformPosition(EndLocation);
+	Instance.AnchorLocation = EndLocation;
+
+	//Moving platforms and vehicles are moved by their owner tick, the anchor is read after it
+	AActor* const AnchorActor = InAnchor->GetOwner();
+	if (AnchorActor && AnchorActor != GetOwner())
+	{
+		AddTickPrerequisiteActor(AnchorActor);
+	}
+}
+void UGrapplingHookComponent::ClearAnchor(const int32 HookIndex)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	//A pending kill anchor still knows its owner. A collected one does not, its stale prerequisite is skipped by the tick graph
+	USceneComponent* const Anchor = Instance.Anchor.Get(true);
+	Instance.Anchor.Reset();
+	AActor* const AnchorActor = Anchor ? Anchor->GetOwner() : nullptr;
+	if (!AnchorActor || AnchorActor == GetOwner())
+	{
+		return;
+	}
+	for (const FGrapplingHookInstance& Other : Hooks)
+	{
+		const USceneComponent* const OtherAnchor = Other.Anchor.Get();
+		if (OtherAnchor && OtherAnchor->GetOwner() == AnchorActor)
+		{
+			return;
+		}
+	}
+	RemoveTickPrerequisiteActor(AnchorActor);
+}
+void UGrapplingHookComponent::RefreshAnchors()
+{
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		FGrapplingHookInstance& Instance = Hooks[HookIndex];
+		if (Instance.Anchor.IsExplicitlyNull())
+		{
+			continue;
+		}
+		//Destroyed or collected since the hook landed
+		USceneComponent* const Anchor = Instance.Anchor.Get();
+		if (!IsValid(Anchor))
+		{
+			ClearAnchor(HookIndex);
+			continue;
+		}
+
+		const FVector Location = Anchor->GetComponentTransform().TransformPosition(Instance.AnchorRelativeLocation);
+		if (Location.Equals(Instance.AnchorLocation))
+		{
+			continue;
+		}
+		Instance.AnchorLocation = Location;
+		//The batched update was gathered before the anchor moved
+		Instance.Update.Frame = 0;
+
+		//A constraint on a component with a physics body follows it already, otherwise its frame is in world space
+		if (HookIndex == ConstrainedHookIndex && SwingConstraint)
+		{
+			const FBodyInstance* const Body = Instance.GrappledObject ? Instance.GrappledObject->GetBodyInstance() : nullptr;
+			if (!Body || !Body->IsValidBodyInstance())
+			{
+				SwingConstraint->SetConstraintReferencePosition(EConstraintFrame::Frame1, Location);
+			}
+		}
+	}
+}
+void UGrapplingHookComponent::ValutateCollision(const int32 HookIndex, const FVector& HitNormal, UPrimitiveComponent* const InGrappledObject, const bool bHit)
+{
+	UPrimitiveComponent* const GrappledObject = StartActiveGrapplePhase(HookIndex, InGrappledObject);
+	if (!bHit || !GrappledObject || BlockingObjects.Contains(GrappledObject->GetCollisionObjectType()))
+	{
+		SetCurrentState(HookIndex, EGrapplingHookState::GS_Missed);
+		OnGrappleMissed.Broadcast();
+		return;
+	}
+
+	const EGrapplingHookState NewState = (this->*GetStateTable().Enter)(HookIndex, HitNormal);
+	if (NewState == EGrapplingHookState::GS_Pull)
+	{
+		PullHookIndex = HookIndex;
+	}
+	SetCurrentState(HookIndex, NewState);
+	if (NewState == EGrapplingHookState::GS_Missed)
+	{
+		OnGrappleMissed.Broadcast();
+		return;
+	}
+	OnGrappleActivated.Broadcast(Hooks[HookIndex].CurrentState, GrappledObject);
+	if (FGrapplingHookTelemetry::IsEnabled())
+	{
+		bool bValid = true;
+		FGrapplingHookTelemetry::RecordLaunchDistance(GetGrappleLength(bValid, HookIndex));
+	}
+
+	bGroundedInterruptArmed = false;
+	FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+	if (TimerWheel)
+	{
+		TimerWheel->ClearTimer(GroundedGraceTimerHandle);
+		TimerWheel->ClearTimer(GroundCheckTimerHandle);
+		GroundedGraceTimerHandle = TimerWheel->SetTimer(FSimpleDelegate::CreateUObject(this, &UGrapplingHookComponent::OnGroundedGracePeriodEnd), GroundedInterruptGracePeriod, false);
+		GroundCheckTimerHandle = TimerWheel->SetTimer(FSimpleDelegate::CreateUObject(this, &UGrapplingHookComponent::OnGroundedCheckDelayEnd), GroundedCheckDelay, false);
+	}
+	//No grace period (or no timer wheel): landing events interrupt the grapple right away
+	if (!GroundedGraceTimerHandle.IsValid())
+	{
+		bGroundedInterruptArmed = true;
+	}
+}
+void UGrapplingHookComponent::RestartCooldown(const int32 HookIndex, const float Cooldown)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	bool bCooldownStarted = false;
+	if (GetStateTable().bCooldown && Cooldown > 0.f)
+	{
+		OnGrappleDisabled.Broadcast(Cooldown);
+		SetCurrentState(HookIndex, EGrapplingHookState::GS_Disabled);
+		Instance.PreRetractingState = Instance.CurrentState;
+
+		FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+		if (TimerWheel)
+		{
+			TimerWheel->ClearTimer(Instance.CooldownTimerHandle);
+			Instance.CooldownTimerHandle = TimerWheel->SetTimer(FSimpleDelegate::CreateUObject(this, &UGrapplingHookComponent::OnEnableHook, HookIndex), Cooldown, false);
+			bCooldownStarted = Instance.CooldownTimerHandle.IsValid();
+		}
+	}
+
+	//If either cooldown feature is not active , cooldown time is not valid or a world could not be found skip cooldown and directly enable grapple
+	if (!bCooldownStarted)
+	{
+		OnEnableHook(HookIndex);
+	}
+
+	//Tick is kept while other hooks are still active, or while the deterministic cooldowns it advances are running
+	if (!IsAnyHookTicking() && !HasPendingDeterministicTimers())
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+void UGrapplingHookComponent::OnEnableGrapple()
+{
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		OnEnableHook(HookIndex);
+	}
+}
+void UGrapplingHookComponent::OnEnableHook(const int32 HookIndex)
+{
+	if (!Hooks.IsValidIndex(HookIndex))
+	{
+		return;
+	}
+	FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+	if (TimerWheel)
+	{
+		TimerWheel->ClearTimer(Hooks[HookIndex].CooldownTimerHandle);
+	}
+	if (Hooks[HookIndex].CurrentState != EGrapplingHookState::GS_Ready)
+	{
+		PlaySound(ReadySound);
+		OnGrappleReady.Broadcast();
+		SetCurrentState(HookIndex, EGrapplingHookState::GS_Ready);
+		ScheduleLazyRelease();
+		ConsumeBufferedLaunch(HookIndex);
+	}
+}
+EGrapplingHookActivation UGrapplingHookComponent::DiffFlags(const EGrapplingHookActivation First, const EGrapplingHookActivation Second) const
+{
+	return (First & (~Second));
+}
+uint8 UGrapplingHookComponent::DiffUFlags(const uint8 First, const uint8 Second) const
+{
+	return (First & (~Second));
+}
+void UGrapplingHookComponent::AddActivationUFlag(const uint8 InFlags)
+{
+	Activation = SumUFlags(Activation, InFlags);
+	RefreshStateTable();
+}
+void UGrapplingHookComponent::AddActivationFlag(const EGrapplingHookActivation InFlags)
+{
+	Activation = SumUFlags(Activation, static_cast<uint8>(InFlags));
+	RefreshStateTable();
+}
+void UGrapplingHookComponent::RemoveActivationUFlag(const uint8 InFlags)
+{
+	Activation = DiffUFlags(Activation, InFlags);
+	RefreshStateTable();
+}
+void UGrapplingHookComponent::RemoveActivationFlag(const EGrapplingHookActivation InFlags)
+{
+	Activation = DiffUFlags(Activation, static_cast<uint8>(InFlags));
+	RefreshStateTable();
+}
+
+float UGrapplingHookComponent::GetGrappleLength(bool& bOutValid, const int32 HookIndex) const
+{
+	bool bValid = true;
+	const FVector End = GetGrappleEndLocation(bValid, HookIndex);
+	const FVector Start = GetGrappleStartLocation(bOutValid, HookIndex);
+	bOutValid = bOutValid && bValid;
+	return FVector::Distance(End, Start);
+}
+void UGrapplingHookComponent::SetCurrentState(const int32 HookIndex, const EGrapplingHookState NewState)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	if (NewState != Instance.CurrentState)
+	{
+		const EGrapplingHookState Previous = Instance.CurrentState;
+		Instance.CurrentState = NewState;
+		if (NewState != EGrapplingHookState::GS_Launch && NewState != EGrapplingHookState::GS_Swing)
+		{
+			ReleaseDeterministicOwner();
+		}
+		if (FGrapplingHookTelemetry::IsEnabled())
+		{
+			const double Now = FPlatformTime::Seconds();
+			if (Instance.StateEnterTime > 0.0)
+			{
+				FGrapplingHookTelemetry::RecordStateExit(Previous, Now - Instance.StateEnterTime);
+				//Actual wait of the cooldown (timer wheel granularity, time dilation and pauses included), not its configured value
+				if (Previous == EGrapplingHookState::GS_Disabled)
+				{
+					FGrapplingHookTelemetry::RecordCooldown(static_cast<float>(Now - Instance.StateEnterTime));
+				}
+			}
+			FGrapplingHookTelemetry::RecordStateEnter(NewState);
+			Instance.StateEnterTime = Now;
+		}
+		else
+		{
+			Instance.StateEnterTime = 0.0;
+		}
+		OnGrappleStateChanged.Broadcast(Previous, NewState);
+		OnHookStateChanged.Broadcast(HookIndex, Previous, NewState);
+	}
+}
+void UGrapplingHookComponent::ReportError(const EGrapplingHookError Error)
+{
+	FGrapplingHookTelemetry::RecordError(Error);
+	if (Error >= EGrapplingHookError::GE_MAX)
+	{
+		return;
+	}
+	switch (Error)
+	{
+	case EGrapplingHookError::GE_UpdateCore:
+	case EGrapplingHookError::GE_LaunchUpdateCore:
+	case EGrapplingHookError::GE_PullUpdateCore:
+	case EGrapplingHookError::GE_RetractUpdateCore:
+	case EGrapplingHookError::GE_SwingUpdateCore:
+	case EGrapplingHookError::GE_TugUpdateCore:
+		bCoreFailureThisTick = true;
+		break;
+	default:
+		break;
+	}
+
+	FGrapplingHookErrorRecord& Record = ErrorRecords[static_cast<int32>(Error)];
+	++Record.PendingCount;
+	//Intervals are measured with the clock of the timer wheel scheduling the flush
+	FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+	const float TimeLeft = TimerWheel ? static_cast<float>(Record.LastBroadcastTime + ErrorReportInterval - TimerWheel->GetTime()) : 0.f;
+	if (TimeLeft <= KINDA_SMALL_NUMBER)
+	{
+		BroadcastError(Error);
+		return;
+	}
+	//Reports left at the end of the interval are broadcasted by the flush timer, armed for the error whose interval ends first
+	float FlushTimeLeft = 0.f;
+	float FlushTimeElapsed = 0.f;
+	if (!TimerWheel->GetTimerInfo(ErrorFlushTimerHandle, FlushTimeLeft, FlushTimeElapsed))
+	{
+		ErrorFlushTimerHandle = TimerWheel->SetTimer(FSimpleDelegate::CreateUObject(this, &UGrapplingHookComponent::FlushErrors), TimeLeft, false);
+		//The deterministic timer wheel is only advanced by the tick
+		if (bDeterministic)
+		{
+			SetComponentTickEnabled(true);
+		}
+	}
+	else if (TimeLeft < FlushTimeLeft)
+	{
+		TimerWheel->SetTimeLeft(ErrorFlushTimerHandle, TimeLeft);
+	}
+}
+void UGrapplingHookComponent::BroadcastError(const EGrapplingHookError Error)
+{
+	FGrapplingHookErrorRecord& Record = ErrorRecords[static_cast<int32>(Error)];
+	const int32 Occurrences = Record.PendingCount;
+	if (Occurrences <= 0)
+	{
+		return;
+	}
+	const FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+	Record.LastBroadcastTime = TimerWheel ? TimerWheel->GetTime() : 0.0;
+	Record.PendingCount = 0;
+	OnGrappleError.Broadcast(Error);
+	OnGrappleErrorAggregated.Broadcast(Error, Occurrences);
+}
+void UGrapplingHookComponent::FlushErrors()
+{
+	ErrorFlushTimerHandle.Invalidate();
+	FGrapplingHookTimerWheel* const TimerWheel = GetTimerWheel();
+	float NextTimeLeft = MAX_flt;
+	for (int32 Error = 0; Error < static_cast<int32>(EGrapplingHookError::GE_MAX); ++Error)
+	{
+		const FGrapplingHookErrorRecord& Record = ErrorRecords[Error];
+		if (Record.PendingCount <= 0)
+		{
+			continue;
+		}
+		//Errors still inside their own interval wait for it to end, each error is rate limited on its own
+		const float TimeLeft = TimerWheel ? static_cast<float>(Record.LastBroadcastTime + ErrorReportInterval - TimerWheel->GetTime()) : 0.f;
+		if (TimeLeft <= KINDA_SMALL_NUMBER)
+		{
+			BroadcastError(static_cast<EGrapplingHookError>(Error));
+		}
+		else
+		{
+			NextTimeLeft = FMath::Min(NextTimeLeft, TimeLeft);
+		}
+	}
+	if (TimerWheel && NextTimeLeft < MAX_flt)
+	{
+		ErrorFlushTimerHandle = TimerWheel->SetTimer(FSimpleDelegate::CreateUObject(this, &UGrapplingHookComponent::FlushErrors), NextTimeLeft, false);
+	}
+}
+void UGrapplingHookComponent::PlaySound(USoundBase* const Sound)
+{
+	if (!Audio && Sound && bLazySubobjects)
+	{
+		CreateLazyAudio();
+	}
+	if (Audio != nullptr)
+	{
+		Audio->SetSound(Sound);
+		Audio->Play(0.f);
+	}
+	if (!bPerformNoise)
+	{
+		return;
+	}
+
+	bool bValid = true;
+	UAISense_Hearing::ReportNoiseEvent(this, GetGrappleStartLocation(bValid), Loudness, NoiseInstigator, MaxRange, NoiseTag);
+}
+void UGrapplingHookComponent::UpdateOwnerLaunch(const float Deltatime)
+{
+	if (!IsAnyHookInState(EGrapplingHookState::GS_Launch))
+	{
+		return;
+	}
+	if (!Owner)
+	{
+		ReportError(EGrapplingHookError::GE_LaunchUpdateCore);
+		return;
+	}
+
+	//All the launching hooks contribute to a single launch, averaged so that more hooks pull toward their middle at the speed of one
+	FVector LaunchVelocity = FVector::ZeroVector;
+	int32 NumLaunching = 0;
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		if (Hooks[HookIndex].CurrentState != EGrapplingHookState::GS_Launch)
+		{
+			continue;
+		}
+		const FGrapplingHookUpdateResult& Update = GetHookUpdate(HookIndex, Deltatime);
+		LaunchVelocity += Update.LaunchVelocity;
+		++NumLaunching;
+		if (!Update.bValidEnd)
+		{
+			ReportError(EGrapplingHookError::GE_LaunchUpdateCore);
+		}
+	}
+	Owner->LaunchCharacter(LaunchVelocity / NumLaunching, true, true);
+}
+float UGrapplingHookComponent::GetSimulationDeltaTime(const float DeltaTime) const
+{
+	if (!bDeterministic)
+	{
+		return DeltaTime;
+	}
+	//Quantized so that the float step and the fixed point step are the same value
+	return FGrapplingHookFixed::FromFloat(DeterministicTimeStep > 0.f ? DeterministicTimeStep : DeltaTime).ToFloat();
+}
+int32 UGrapplingHookComponent::ConsumeDeterministicSteps(const float DeltaTime)
+{
+	//Steps run per tick at most, a hitch is caught up over the next ticks instead of stalling a single frame
+	static const int64 MaxStepsPerTick = 8;
+
+	if (DeterministicTimeStep <= 0.f)
+	{
+		return 1;
+	}
+	const FGrapplingHookFixed Step = FGrapplingHookFixed::FromFloat(DeterministicTimeStep);
+	if (Step <= FGrapplingHookFixed())
+	{
+		return 0;
+	}
+	DeterministicTimeAccumulator += FGrapplingHookFixed::FromFloat(FMath::Max(DeltaTime, 0.f));
+	const int64 NumSteps = FMath::Min(DeterministicTimeAccumulator.Raw / Step.Raw, MaxStepsPerTick);
+	DeterministicTimeAccumulator.Raw -= NumSteps * Step.Raw;
+	return static_cast<int32>(NumSteps);
+}
+void UGrapplingHookComponent::StepDeterministic(const float StepTime, const bool bFirstStep)
+{
+	if (!bFirstStep)
+	{
+		//The batched compute phase ran once for this frame, the further steps compute their own updates
+		for (FGrapplingHookInstance& Instance : Hooks)
+		{
+			Instance.Update.Frame = 0;
+		}
+	}
+	UpdateDeterministicHookFlight(StepTime);
+	(this->*GetStateTable().UpdateHooks)(StepTime);
+	UpdateDeterministicOwner(StepTime);
+	GetTimerWheel()->Advance(StepTime);
+	UpdateDeterministicHash();
+}
+double UGrapplingHookComponent::GetSimulationTime() const
+{
+	if (bDeterministic)
+	{
+		return GetTimerWheel()->GetTime();
+	}
+	const UWorld* const World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+void UGrapplingHookComponent::UpdateDeterministicOwner(const float Deltatime)
+{
+	const bool bLaunching = IsAnyHookInState(EGrapplingHookState::GS_Launch);
+	if (!bLaunching && !IsAnyHookInState(EGrapplingHookState::GS_Swing))
+	{
+		return;
+	}
+	if (!Owner)
+	{
+		ReportError(EGrapplingHookError::GE_SwingUpdateCore);
+		return;
+	}
+	AcquireDeterministicOwner();
+
+	const FGrapplingHookFixed Step = FGrapplingHookFixed::FromFloat(Deltatime);
+	FGrapplingHookFixedVector Acceleration;
+	if (bLaunching)
+	{
+		//Same as LaunchCharacter with both overrides: the launch velocity replaces the current one
+		DeterministicOwnerVelocity = FGrapplingHookFixedVector();
+		for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+		{
+			if (Hooks[HookIndex].CurrentState != EGrapplingHookState::GS_Launch)
+			{
+				continue;
+			}
+			const FGrapplingHookUpdateResult& Update = GetHookUpdate(HookIndex, Deltatime);
+			DeterministicOwnerVelocity += FGrapplingHookFixedVector::FromVector(Update.LaunchVelocity);
+			if (!Update.bValidEnd)
+			{
+				ReportError(EGrapplingHookError::GE_LaunchUpdateCore);
+			}
+		}
+	}
+	else
+	{
+		Acceleration = GetDeterministicSwingAcceleration(CurrentSwingingForce);
+	}
+	CurrentSwingingForce = FVector::ZeroVector;
+
+	const FGrapplingHookFixed ReelStep = FGrapplingHookFixed::FromFloat(GetReelSpeed()) * Step;
+	const FGrapplingHookFixed MinLength = FGrapplingHookFixed::FromFloat(MinRopeLength);
+	const FGrapplingHookFixed MaxLength = FGrapplingHookFixed::FromFloat(FMath::Max(BreakDistance, MinRopeLength));
+	CurrentReelInput = 0.f;
+
+	DeterministicRopes.Reset();
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		FGrapplingHookInstance& Instance = Hooks[HookIndex];
+		if (Instance.CurrentState != EGrapplingHookState::GS_Swing || !Instance.bActivatedSwing)
+		{
+			continue;
+		}
+		if (ReelStep != FGrapplingHookFixed())
+		{
+			Instance.DeterministicRopeLength = FGrapplingHookFixed::Clamp(Instance.DeterministicRopeLength + ReelStep, MinLength, MaxLength);
+		}
+		Instance.RopeLength = Instance.DeterministicRopeLength.ToFloat();
+
+		bool bValid = true;
+		const FVector Anchor = GetGrappleEndLocation(bValid, HookIndex);
+		if (!bValid)
+		{
+			ReportError(EGrapplingHookError::GE_SwingUpdateCore);
+			continue;
+		}
+		FGrapplingHookFixedRope& Rope = DeterministicRopes.AddDefaulted_GetRef();
+		Rope.Anchor = FGrapplingHookFixedVector::FromVector(Anchor);
+		Rope.Length = Instance.DeterministicRopeLength;
+	}
+	const FGrapplingHookFixedVector PreviousLocation = DeterministicOwnerLocation;
+	StepDeterministicOwner(DeterministicOwnerLocation, DeterministicOwnerVelocity, Acceleration, DeterministicRopes, Step);
+
+	//Swept so that the owner does not tunnel through walls. Only whether the move is blocked is read from the query: a blocked owner stops at the
+	//last free location found on the fixed point move and loses its velocity along that move, the contact point and normal are not used
+	const FGrapplingHookFixedVector Move = DeterministicOwnerLocation - PreviousLocation;
+	FVector HitNormal = FVector::ZeroVector;
+	UPrimitiveComponent* HitComponent = nullptr;
+	if (SweepDeterministic(Owner->GetCapsuleComponent(), PreviousLocation, DeterministicOwnerLocation, HitNormal, HitComponent))
+	{
+		const FGrapplingHookFixed MoveSize = Move.Size();
+		if (MoveSize > FGrapplingHookFixed())
+		{
+			const FGrapplingHookFixedVector Direction = Move / MoveSize;
+			const FGrapplingHookFixed MoveSpeed = FGrapplingHookFixedVector::DotProduct(DeterministicOwnerVelocity, Direction);
+			if (MoveSpeed > FGrapplingHookFixed())
+			{
+				DeterministicOwnerVelocity -= Direction * MoveSpeed;
+			}
+		}
+	}
+	Owner->SetActorLocation(DeterministicOwnerLocation.ToVector(), false, nullptr, ETeleportType::TeleportPhysics);
+
+	if (bLaunching)
+	{
+		//The owner is teleported, no landing event is received: the launch is over once the target is reached
+		const FGrapplingHookFixed Tollerance = FGrapplingHookFixed::FromFloat(RetractDistanceTollerance);
+		for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+		{
+			if (Hooks[HookIndex].CurrentState != EGrapplingHookState::GS_Launch)
+			{
+				continue;
+			}
+			bool bValid = true;
+			const FGrapplingHookFixedVector Target = FGrapplingHookFixedVector::FromVector(GetGrappleEndLocationWithLaunchOffset(bValid, HookIndex));
+			if (bValid && (Target - DeterministicOwnerLocation).SizeSquared() <= Tollerance * Tollerance)
+			{
+				StopGrappleAt(HookIndex);
+			}
+		}
+	}
+}
+void UGrapplingHookComponent::StepDeterministicOwner(FGrapplingHookFixedVector& InOutLocation, FGrapplingHookFixedVector& InOutVelocity, const FGrapplingHookFixedVector& Acceleration, const TArray<FGrapplingHookFixedRope>& Ropes, const FGrapplingHookFixed Step)
+{
+	InOutVelocity += Acceleration * Step;
+	InOutLocation += InOutVelocity * Step;
+	//Every rope is an inextensible distance constraint: the owner is projected back on the rope sphere and loses its outward velocity
+	for (const FGrapplingHookFixedRope& Rope : Ropes)
+	{
+		SolveDeterministicRope(InOutLocation, InOutVelocity, Rope.Anchor, Rope.Length);
+	}
+}
+void UGrapplingHookComponent::StartDeterministicHookFlight(const int32 HookIndex)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	AProjectileHook* const Hook = Instance.Hook;
+	//The projectile movement integrates with the frame time, the flight is stepped by UpdateDeterministicHookFlight instead
+	Hook->InterruptProjectileMovement(false);
+	const float Speed = Hook->ProjectileMovement ? Hook->ProjectileMovement->InitialSpeed : 0.f;
+	Instance.DeterministicHookLocation = FGrapplingHookFixedVector::FromVector(Hook->GetActorLocation());
+	Instance.DeterministicHookVelocity = FGrapplingHookFixedVector::FromVector(Hook->GetActorForwardVector() * Speed);
+	SetComponentTickEnabled(true);
+}
+void UGrapplingHookComponent::UpdateDeterministicHookFlight(const float Deltatime)
+{
+	const FGrapplingHookFixed Step = FGrapplingHookFixed::FromFloat(Deltatime);
+	const FGrapplingHookFixed MaxDistance = FGrapplingHookFixed::FromFloat(BreakDistance);
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		FGrapplingHookInstance& Instance = Hooks[HookIndex];
+		if (Instance.CurrentState != EGrapplingHookState::GS_Extending)
+		{
+			continue;
+		}
+		if (!Instance.Hook || !Instance.Cable)
+		{
+			ReportError(EGrapplingHookError::GE_UpdateCore);
+			HookLanded(FVector::ZeroVector, nullptr, HookIndex);
+			continue;
+		}
+
+		FGrapplingHookFixedVector Location = Instance.DeterministicHookLocation + Instance.DeterministicHookVelocity * Step;
+		FVector HitNormal = FVector::ZeroVector;
+		UPrimitiveComponent* HitComponent = nullptr;
+		if (SweepDeterministic(Instance.Hook->CollisionComponent, Instance.DeterministicHookLocation, Location, HitNormal, HitComponent))
+		{
+			LandDeterministicHook(HookIndex, Location, HitNormal, HitComponent);
+			continue;
+		}
+		Instance.DeterministicHookLocation = Location;
+		//Past the break distance from the cable the hook missed, as the projectile hook does
+		const FGrapplingHookFixedVector Start = FGrapplingHookFixedVector::FromVector(Instance.Cable->GetComponentLocation());
+		if ((Location - Start).SizeSquared() > MaxDistance * MaxDistance)
+		{
+			LandDeterministicHook(HookIndex, Location, FVector::ZeroVector, nullptr);
+			continue;
+		}
+		Instance.Hook->SetActorLocation(Location.ToVector(), false, nullptr, ETeleportType::TeleportPhysics);
+	}
+}
+void UGrapplingHookComponent::LandDeterministicHook(const int32 HookIndex, const FGrapplingHookFixedVector& Location, const FVector& HitNormal, UPrimitiveComponent* const HitComponent)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	Instance.DeterministicHookLocation = Location;
+	Instance.DeterministicHookVelocity = FGrapplingHookFixedVector();
+	if (Instance.Hook)
+	{
+		//Stopped as the projectile hook does on a hit: attached to the hit component, with its collision disabled
+		Instance.Hook->PlaceStopped(FTransform(Instance.Hook->GetActorQuat(), Location.ToVector()), HitComponent);
+	}
+	HookLanded(HitNormal, HitComponent, HookIndex);
+}
+bool UGrapplingHookComponent::SweepDeterministic(const UPrimitiveComponent* const Component, const FGrapplingHookFixedVector& Start, FGrapplingHookFixedVector& InOutEnd, FVector& OutHitNormal, UPrimitiveComponent*& OutHitComponent) const
+{
+	//Bisections of a blocked move, the stop location is found within 1/256 of the move
+	static const int32 NumBisections = 8;
+
+	const UWorld* const World = GetWorld();
+	if (!World || !Component)
+	{
+		return false;
+	}
+	const FCollisionShape Shape = Component->GetCollisionShape();
+	FCollisionQueryParams Params(FCollisionQueryParams::DefaultQueryParam);
+	FCollisionResponseParams ResponseParams;
+	Component->InitSweepCollisionParams(Params, ResponseParams);
+	Params.AddIgnoredActor(GetOwner());
+	Params.AddIgnoredActor(Component->GetOwner());
+	const ECollisionChannel Channel = Component->GetCollisionObjectType();
+	const FQuat Rotation = Component->GetComponentQuat();
+
+	FHitResult Hit;
+	if (!World->SweepSingleByChannel(Hit, Start.ToVector(), InOutEnd.ToVector(), Rotation, Channel, Shape, Params, ResponseParams))
+	{
+		return false;
+	}
+	OutHitComponent = Hit.Component.Get();
+	OutHitNormal = FGrapplingHookFixedVector::FromVector(Hit.ImpactNormal).ToVector();
+
+	//The hit time and location are not read back: the last free fraction of the move is searched with yes/no queries, so the stop location is on the fixed point move
+	const FGrapplingHookFixedVector Move = InOutEnd - Start;
+	FGrapplingHookFixed Free;
+	FGrapplingHookFixed Blocked = FGrapplingHookFixed::FromInt(1);
+	for (int32 Bisection = 0; Bisection < NumBisections; ++Bisection)
+	{
+		const FGrapplingHookFixed Middle = FGrapplingHookFixed::FromRaw((Free.Raw + Blocked.Raw) / 2);
+		if (World->SweepTestByChannel(Start.ToVector(), (Start + Move * Middle).ToVector(), Rotation, Channel, Shape, Params, ResponseParams))
+		{
+			Blocked = Middle;
+		}
+		else
+		{
+			Free = Middle;
+		}
+	}
+	InOutEnd = Start + Move * Free;
+	return true;
+}
+FGrapplingHookFixedVector UGrapplingHookComponent::GetDeterministicSwingAcceleration(const FVector& SwingingForce) const
+{
+	FGrapplingHookFixedVector Acceleration = FGrapplingHookFixedVector::FromVector(SwingingForce);
+	const UCharacterMovementComponent* const MoveComponent = Owner ? Owner->GetCharacterMovement() : nullptr;
+	if (!bAccelChange && MoveComponent && MoveComponent->Mass > KINDA_SMALL_NUMBER)
+	{
+		Acceleration = Acceleration / FGrapplingHookFixed::FromFloat(MoveComponent->Mass);
+	}
+	const UWorld* const World = GetWorld();
+	Acceleration.Z += FGrapplingHookFixed::FromFloat(World ? World->GetGravityZ() : 0.f);
+	return Acceleration;
+}
+void UGrapplingHookComponent::SolveDeterministicRope(FGrapplingHookFixedVector& InOutLocation, FGrapplingHookFixedVector& InOutVelocity, const FGrapplingHookFixedVector& Anchor, const FGrapplingHookFixed RopeLength)
+{
+	const FGrapplingHookFixedVector Offset = InOutLocation - Anchor;
+	const FGrapplingHookFixed Distance = Offset.Size();
+	if (Distance <= RopeLength || Distance == FGrapplingHookFixed())
+	{
+		return;
+	}
+	const FGrapplingHookFixedVector Direction = Offset / Distance;
+	InOutLocation = Anchor + Direction * RopeLength;
+	const FGrapplingHookFixed RadialSpeed = FGrapplingHookFixedVector::DotProduct(InOutVelocity, Direction);
+	if (RadialSpeed > FGrapplingHookFixed())
+	{
+		InOutVelocity -= Direction * RadialSpeed;
+	}
+}
+void UGrapplingHookComponent::AcquireDeterministicOwner()
+{
+	if (bDeterministicOwnerDriven || !Owner)
+	{
+		return;
+	}
+	bDeterministicOwnerDriven = true;
+	DeterministicOwnerLocation = FGrapplingHookFixedVector::FromVector(Owner->GetActorLocation());
+	DeterministicOwnerVelocity = FGrapplingHookFixedVector::FromVector(Owner->GetVelocity());
+	UCharacterMovementComponent* const MoveComponent = Owner->GetCharacterMovement();
+	if (MoveComponent)
+	{
+		MoveComponent->StopMovementImmediately();
+		MoveComponent->SetActive(false);
+	}
+}
+void UGrapplingHookComponent::ReleaseDeterministicOwner()
+{
+	if (!bDeterministicOwnerDriven || IsAnyHookInState(EGrapplingHookState::GS_Launch) || IsAnyHookInState(EGrapplingHookState::GS_Swing))
+	{
+		return;
+	}
+	bDeterministicOwnerDriven = false;
+	if (!Owner)
+	{
+		return;
+	}
+	UCharacterMovementComponent* const MoveComponent = Owner->GetCharacterMovement();
+	if (MoveComponent)
+	{
+		MoveComponent->SetActive(true);
+	}
+	Owner->LaunchCharacter(DeterministicOwnerVelocity.ToVector(), true, true);
+}
+void UGrapplingHookComponent::UpdateDeterministicHash()
+{
+	uint32 Hash = FGrapplingHookStateHash::Combine(FGrapplingHookStateHash::Seed, static_cast<int64>(++DeterministicFrame));
+	Hash = FGrapplingHookStateHash::Combine(Hash, static_cast<int64>(bDeterministicOwnerDriven ? 1 : 0));
+	if (bDeterministicOwnerDriven)
+	{
+		Hash = FGrapplingHookStateHash::Combine(Hash, DeterministicOwnerLocation);
+		Hash = FGrapplingHookStateHash::Combine(Hash, DeterministicOwnerVelocity);
+	}
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		const FGrapplingHookInstance& Instance = Hooks[HookIndex];
+		Hash = FGrapplingHookStateHash::Combine(Hash, static_cast<int64>(Instance.CurrentState));
+		Hash = FGrapplingHookStateHash::Combine(Hash, static_cast<int64>(Instance.RetractClock));
+		Hash = FGrapplingHookStateHash::Combine(Hash, Instance.DeterministicRopeLength.Raw);
+		if (Instance.bDeterministicPulled)
+		{
+			Hash = FGrapplingHookStateHash::Combine(Hash, Instance.DeterministicPulledLocation);
+		}
+		if (Instance.CurrentState == EGrapplingHookState::GS_Extending)
+		{
+			Hash = FGrapplingHookStateHash::Combine(Hash, Instance.DeterministicHookLocation);
+			Hash = FGrapplingHookStateHash::Combine(Hash, Instance.DeterministicHookVelocity);
+		}
+		if (Instance.CurrentState == EGrapplingHookState::GS_Disabled)
+		{
+			//The remaining cooldown decides the step the hook is ready again
+			float TimeLeft = 0.f;
+			float TimeElapsed = 0.f;
+			GetTimerWheel()->GetTimerInfo(Instance.CooldownTimerHandle, TimeLeft, TimeElapsed);
+			Hash = FGrapplingHookStateHash::Combine(Hash, FGrapplingHookFixed::FromFloat(TimeLeft).Raw);
+		}
+		if (Instance.CurrentState != EGrapplingHookState::GS_Ready && Instance.CurrentState != EGrapplingHookState::GS_Disabled)
+		{
+			bool bValid = true;
+			Hash = FGrapplingHookStateHash::Combine(Hash, FGrapplingHookFixedVector::FromVector(GetGrappleEndLocation(bValid, HookIndex)));
+		}
+	}
+	DeterministicStateHash = Hash;
+	if (CVarGrapplingHookDeterministicLogHash.GetValueOnGameThread() != 0)
+	{
+		UE_LOG(LogGrapplingHook, Log, TEXT("%s frame %u hash %08x"), *GetPathName(), DeterministicFrame, DeterministicStateHash);
+	}
+}
+bool UGrapplingHookComponent::UpdatePulledObject(const int32 HookIndex, const float Deltatime)
+{
+	UCableComponent* const Cable = Hooks[HookIndex].Cable;
+	if ((!PullHandle && !bDeterministic) || !Cable)
+	{
+		ReportError(EGrapplingHookError::GE_PullUpdateCore);
+		return true;
+	}
+	if (!IsGrappledObjectPullable(HookIndex))
+	{
+		return true;
+	}
+
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	if (Instance.bDeterministicPulled)
+	{
+		const FGrapplingHookUpdateResult& Update = GetHookUpdate(HookIndex, Deltatime);
+		if (!Update.bValidStart)
+		{
+			ReportError(EGrapplingHookError::GE_PullUpdateCore);
+		}
+		//Same approach as the physics handle interpolation, integrated in fixed point
+		const FGrapplingHookFixed Alpha = FGrapplingHookFixed::Min(FGrapplingHookFixed::FromFloat(PullObjectInterpolationSpeed) * FGrapplingHookFixed::FromFloat(Deltatime), FGrapplingHookFixed::FromInt(1));
+		Instance.DeterministicPulledLocation += (FGrapplingHookFixedVector::FromVector(Update.PullTargetLocation) - Instance.DeterministicPulledLocation) * Alpha;
+		//The simulated location is authoritative, the body velocity is never read back
+		Instance.GrappledObject->SetWorldLocation(Instance.DeterministicPulledLocation.ToVector(), false, (FHitResult*)nullptr, ETeleportType::TeleportPhysics);
+		Instance.GrappledObject->SetPhysicsLinearVelocity(FVector::ZeroVector);
+		return Update.bPullOver;
+	}
+	PullHandle->SetInterpolationSpeed(PullObjectInterpolationSpeed);
+
+	const FGrapplingHookUpdateResult& Update = GetHookUpdate(HookIndex, Deltatime);
+	if (!Update.bValidStart)
+	{
+		ReportError(EGrapplingHookError::GE_PullUpdateCore);
+	}
+	PullHandle->SetTargetLocation(Update.PullTargetLocation);
+
+	return Update.bPullOver;
+}
+void UGrapplingHookComponent::ActivatePull(const int32 HookIndex)
+{
+	if (bDeterministic)
+	{
+		FGrapplingHookInstance& Instance = Hooks[HookIndex];
+		if (!Instance.bDeterministicPulled && Instance.GrappledObject)
+		{
+			Instance.bDeterministicPulled = true;
+			Instance.DeterministicPulledLocation = FGrapplingHookFixedVector::FromVector(Instance.GrappledObject->GetComponentLocation());
+		}
+		return;
+	}
+	if (!AcquirePullHandle())
+	{
+		ReportError(EGrapplingHookError::GE_PullActivationCore);
+		return;
+	}
+	UPrimitiveComponent* const GrappledObject = Hooks[HookIndex].GrappledObject;
+	if (PullHandle->GrabbedComponent != GrappledObject)
+	{
+		PullHandle->ReleaseComponent();
+		bool bValid = true;
+		PullHandle->GrabComponentAtLocation(GrappledObject, NAME_None, GetGrappleEndLocation(bValid, HookIndex));
+		if (!bValid)
+		{
+			ReportError(EGrapplingHookError::GE_PullActivationCore);
+		}
+	}
+}
+bool UGrapplingHookComponent::IsGrappledObjectPullable(const int32 HookIndex) const
+{
+	const UPrimitiveComponent* const GrappledObject = GetGrappledObject(HookIndex);
+	if (GrappledObject)
+	{
+		return GrappledObject->Mobility == EComponentMobility::Type::Movable && GrappledObject->IsSimulatingPhysics() && GrappledObject->GetMass() <= PullMaxObjectMass;
+	}
+	return false;
+}
+bool UGrapplingHookComponent::UpdateTug(const int32 HookIndex, const float Deltatime)
+{
+	UPrimitiveComponent* const GrappledObject = Hooks[HookIndex].GrappledObject;
+	if (!Owner || !GrappledObject)
+	{
+		ReportError(EGrapplingHookError::GE_TugUpdateCore);
+		return true;
+	}
+	UCharacterMovementComponent* const MoveComponent = Owner->GetCharacterMovement();
+	if (!MoveComponent)
+	{
+		ReportError(EGrapplingHookError::GE_TugUpdateCore);
+		return true;
+	}
+	if (!IsGrappledObjectTuggable(HookIndex))
+	{
+		return true;
+	}
+
+	bool bValidStart = true;
+	bool bValidEnd = true;
+	const FVector StartLocation = GetGrappleStartLocation(bValidStart, HookIndex);
+	const FVector EndLocation = GetGrappleEndLocation(bValidEnd, HookIndex);
+	if (!bValidStart || !bValidEnd)
+	{
+		ReportError(EGrapplingHookError::GE_TugUpdateCore);
+		return true;
+	}
+
+	const FVector Rope = EndLocation - StartLocation;
+	const float RopeLength = Rope.Size();
+	if (RopeLength <= PullDistanceInterrupt)
+	{
+		return true;
+	}
+	if (Deltatime <= 0.f)
+	{
+		return false;
+	}
+
+	const float OwnerMass = MoveComponent->Mass;
+	const float ObjectMass = GrappledObject->GetMass();
+	const float InvOwnerMass = OwnerMass > 0.f ? 1.f / OwnerMass : 0.f;
+	const float InvObjectMass = ObjectMass > 0.f ? 1.f / ObjectMass : 0.f;
+	const float InvMassSum = InvOwnerMass + InvObjectMass;
+	if (InvMassSum <= 0.f)
+	{
+		return false;
+	}
+
+	//Velocity level solver step: the rope impulse cancels any separating speed (the rope can't stretch), adds the tug force contribution and
+	//is clamped so that the two ends never close more than the remaining slack in a single step (keeps the solver stable at low tick rates)
+	const FVector Direction = Rope / RopeLength;
+	const float SeparatingSpeed = FVector::DotProduct(GrappledObject->GetPhysicsLinearVelocity() - MoveComponent->Velocity, Direction);
+	const float MaxClosingSpeed = FMath::Max(RopeLength - PullDistanceTollerance, 0.f) / Deltatime;
+	const float MinImpulse = FMath::Max(SeparatingSpeed, 0.f) / InvMassSum;
+	const float MaxImpulse = FMath::Max((MaxClosingSpeed + SeparatingSpeed) / InvMassSum, MinImpulse);
+	const float Impulse = FMath::Clamp(MinImpulse + (TugForce * Deltatime), MinImpulse, MaxImpulse);
+
+	MoveComponent->AddImpulse(Direction * (Impulse * InvOwnerMass), true);
+	GrappledObject->AddImpulse(-Direction * (Impulse * InvObjectMass), NAME_None, true);
+
+	return false;
+}
+bool UGrapplingHookComponent::IsGrappledObjectTuggable(const int32 HookIndex) const
+{
+	const UPrimitiveComponent* const GrappledObject = GetGrappledObject(HookIndex);
+	if (GrappledObject)
+	{
+		return GrappledObject->Mobility == EComponentMobility::Type::Movable && GrappledObject->IsSimulatingPhysics() && GrappledObject->GetMass() > PullMaxObjectMass;
+	}
+	return false;
+}
+bool UGrapplingHookComponent::IsOwnerLaunchingMidair() const
+{
+	if (Owner)
+	{
+		const UCharacterMovementComponent* const MoveComponent = Owner->GetCharacterMovement();
+		if (MoveComponent)
+		{
+			return IsAnyHookInState(EGrapplingHookState::GS_Launch) && !MoveComponent->IsMovingOnGround();
+		}
+	}
+	return false;
+}
+bool UGrapplingHookComponent::IsAnyHookTicking() const
+{
+	for (const FGrapplingHookInstance& Instance : Hooks)
+	{
+		switch (Instance.CurrentState)
+		{
+		case EGrapplingHookState::GS_Launch:
+		case EGrapplingHookState::GS_Pull:
+		case EGrapplingHookState::GS_Tug:
+		case EGrapplingHookState::GS_Swing:
+		case EGrapplingHookState::GS_Missed:
+		case EGrapplingHookState::GS_Retracting:
+			return true;
+		case EGrapplingHookState::GS_Extending:
+			//The deterministic hook flight is stepped by the component
+			if (bDeterministic)
+			{
+				return true;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	return false;
+}
+bool UGrapplingHookComponent::HasPendingDeterministicTimers() const
+{
+	return bDeterministic && DeterministicTimerWheel.IsValid() && DeterministicTimerWheel->GetNumActiveTimers() > 0;
+}
+bool UGrapplingHookComponent::IsAnyHookInState(const EGrapplingHookState State) const
+{
+	for (const FGrapplingHookInstance& Instance : Hooks)
+	{
+		if (Instance.CurrentState == State)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+FGrapplingHookUpdateParams UGrapplingHookComponent::GetUpdateParams() const
+{
+	FGrapplingHookUpdateParams Params;
+	Params.LaunchSpeed = LaunchSpeed;
+	Params.BreakDistance = BreakDistance;
+	Params.RetractDistanceTollerance = RetractDistanceTollerance;
+	Params.PullDistanceTollerance = PullDistanceTollerance;
+	Params.PullDistanceInterrupt = PullDistanceInterrupt;
+	Params.RetractEasing = &RetractEasing;
+	Params.bDeterministic = bDeterministic;
+	if (Owner)
+	{
+		const UCapsuleComponent* const Capsule = Owner->GetCapsuleComponent();
+		if (Capsule)
+		{
+			Params.LaunchOffsetZ = Capsule->GetScaledCapsuleHalfHeight() * 2.f * OffsetZPercentage;
+		}
+	}
+	return Params;
+}
+void UGrapplingHookComponent::GatherHookUpdateInput(const int32 HookIndex, const float DeltaTime, FGrapplingHookUpdateInput& OutInput) const
+{
+	const FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	OutInput.DeltaTime = DeltaTime;
+	OutInput.Frame = GFrameCounter;
+	OutInput.HookIndex = HookIndex;
+	OutInput.State = Instance.CurrentState;
+	OutInput.StartLocation = GetGrappleStartLocation(OutInput.bValidStart, HookIndex);
+	OutInput.EndLocation = GetGrappleEndLocation(OutInput.bValidEnd, HookIndex);
+	OutInput.CableForward = Instance.Cable ? Instance.Cable->GetForwardVector() : FVector::ForwardVector;
+	OutInput.OwnerLocation = bDeterministicOwnerDriven ? DeterministicOwnerLocation.ToVector() : (Owner ? Owner->GetActorLocation() : FVector::ZeroVector);
+	OutInput.HookLocation = Instance.Hook ? Instance.Hook->GetActorLocation() : OutInput.EndLocation;
+	OutInput.RetractStartLocation = Instance.RetractStartLocation;
+	OutInput.RetractClock = Instance.RetractClock;
+	OutInput.RetractClockRate = Instance.RetractClockRate;
+	OutInput.PulledObjectDistance = MAX_flt;
+	if (Instance.CurrentState == EGrapplingHookState::GS_Pull && Instance.bDeterministicPulled)
+	{
+		//Distance from the simulated object location, a collision query could differ between machines
+		OutInput.PulledObjectDistance = (Instance.DeterministicPulledLocation - FGrapplingHookFixedVector::FromVector(OutInput.StartLocation)).Size().ToFloat();
+	}
+	else if (Instance.CurrentState == EGrapplingHookState::GS_Pull && Instance.GrappledObject)
+	{
+		//Collision query, it has to be done here rather than in the compute phase
+		FVector Out;
+		OutInput.PulledObjectDistance = Instance.GrappledObject->GetClosestPointOnCollision(OutInput.StartLocation, Out);
+	}
+}
+void UGrapplingHookComponent::GatherUpdateBatch(const float DeltaTime, FGrapplingHookUpdateBatch& Batch)
+{
+	//Same delta time received by the component tick
+	const AActor* const ActorOwner = GetOwner();
+	const float HookDeltaTime = GetSimulationDeltaTime(DeltaTime * (ActorOwner ? ActorOwner->CustomTimeDilation : 1.f));
+
+	int32 ParamsIndex = INDEX_NONE;
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		const EGrapplingHookState State = Hooks[HookIndex].CurrentState;
+		if (State == EGrapplingHookState::GS_Extending || State == EGrapplingHookState::GS_Ready || State == EGrapplingHookState::GS_Disabled)
+		{
+			continue;
+		}
+		if (ParamsIndex == INDEX_NONE)
+		{
+			ParamsIndex = Batch.Params.Add(GetUpdateParams());
+			Batch.Components.Add(this);
+		}
+		FGrapplingHookUpdateInput& Input = Batch.Inputs[Batch.Inputs.AddDefaulted()];
+		GatherHookUpdateInput(HookIndex, HookDeltaTime, Input);
+		Input.ParamsIndex = ParamsIndex;
+	}
+}
+void UGrapplingHookComponent::SetHookUpdate(const int32 HookIndex, const FGrapplingHookUpdateResult& InUpdate)
+{
+	if (Hooks.IsValidIndex(HookIndex))
+	{
+		Hooks[HookIndex].Update = InUpdate;
+	}
+}
+const FGrapplingHookUpdateResult& UGrapplingHookComponent::GetHookUpdate(const int32 HookIndex, const float DeltaTime)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	const FGrapplingHookUpdateResult& Update = Instance.Update;
+	if (Update.Frame != GFrameCounter || Update.DeltaTime != DeltaTime || Update.State != Instance.CurrentState)
+	{
+		FGrapplingHookUpdateInput Input;
+		GatherHookUpdateInput(HookIndex, DeltaTime, Input);
+		Input.Compute(GetUpdateParams(), Instance.Update);
+	}
+	return Instance.Update;
+}
+void UGrapplingHookComponent::BuildHookCollisionResponses(FCollisionResponseContainer& OutResponses) const
+{
+	//Object types no enabled feature can use are a miss anyway, the hook passes through them (an empty list accepts every object type)
+	const bool bPull = IsUFlagSet(Activation, EGrapplingHookActivation::GA_Pull);
+	const bool bSwingOrLaunch = IsUFlagSet(Activation, EGrapplingHookActivation::GA_Swing) || IsUFlagSet(Activation, EGrapplingHookActivation::GA_Launch);
+	const bool bAllObjectTypes = (bPull && PullableObjects.Num() == 0) || (bSwingOrLaunch && SwingableObjects.Num() == 0);
+
+	OutResponses.SetAllChannels(ECollisionResponse::ECR_Block);
+	const UCollisionProfile* const Profile = UCollisionProfile::Get();
+	for (int32 Channel = 0; Channel < 32; ++Channel)
+	{
+		const ECollisionChannel CollisionChannel = static_cast<ECollisionChannel>(Channel);
+		if (Profile->ConvertToObjectType(CollisionChannel) == EObjectTypeQuery::ObjectTypeQuery_MAX)
+		{
+			if (bHookIgnoresTraceChannels)
+			{
+				OutResponses.SetResponse(CollisionChannel, ECollisionResponse::ECR_Ignore);
+			}
+		}
+		else if (!bAllObjectTypes && !(bPull && PullableObjects.Contains(CollisionChannel)) && !(bSwingOrLaunch && SwingableObjects.Contains(CollisionChannel)))
+		{
+			OutResponses.SetResponse(CollisionChannel, ECollisionResponse::ECR_Ignore);
+		}
+	}
+	for (const ECollisionChannel Item : HookIgnoredObjects)
+	{
+		OutResponses.SetResponse(Item, ECollisionResponse::ECR_Ignore);
+	}
+	//A hit on a blocking object is a miss, the hook still has to stop there
+	for (const ECollisionChannel Item : BlockingObjects)
+	{
+		OutResponses.SetResponse(Item, ECollisionResponse::ECR_Block);
+	}
+}
+bool UGrapplingHookComponent::IsGrappledObjectTypeIn(const int32 HookIndex, const TArray<TEnumAsByte<ECollisionChannel>>& ObjectTypes) const
+{
+	const UPrimitiveComponent* const GrappledObject = GetGrappledObject(HookIndex);
+	return ObjectTypes.Num() == 0 || (GrappledObject && ObjectTypes.Contains(GrappledObject->GetCollisionObjectType()));
+}
+void UGrapplingHookComponent::GetAimingQueryParams(const bool bTraceComplex, FCollisionObjectQueryParams& OutObjectParams, FCollisionQueryParams& OutParams) const
+{
+	OutParams = FCollisionQueryParams(FCollisionQueryParams::DefaultQueryParam);
+	OutParams.bTraceComplex = bTraceComplex;
+	OutParams.AddIgnoredActor(Owner);
+	OutObjectParams = FCollisionObjectQueryParams();
+	for (const ECollisionChannel Item : BlockingObjects)
+	{
+		OutObjectParams.AddObjectTypesToQuery(Item);
+	}
+}
+bool UGrapplingHookComponent::IsAimingHitValid(const FVector& StartLocation, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, FHitResult& OutHit, bool& bPossibleValidHit) const
+{
+	const UWorld* const World = GetWorld();
+	if (World)
+	{
+		FCollisionQueryParams BlockingParams;
+		FCollisionObjectQueryParams BlockingQuery;
+		GetAimingQueryParams(bTraceComplex, BlockingQuery, BlockingParams);
+
+		const bool Hit = World->LineTraceSingleByObjectType(OutHit, StartLocation, StartLocation + (Direction * MaxDistance), BlockingQuery, BlockingParams);
+		if (!OutHit.Component.IsValid() || !Hit)
+		{
+			return false;
+		}
+		bPossibleValidHit = OutHit.Distance < BreakDistance && (IsUFlagNotSet(Activation, EGrapplingHookActivation::GA_Swing) || IsSurfaceSwingable(OutHit.ImpactNormal));
+		return true;
+	}
+	return false;
+}
+float UGrapplingHookComponent::ScoreAimingHit(const FVector& StartLocation, const FVector& Direction, const FHitResult& Hit, bool& bOutPossibleValidHit) const
+{
+	bOutPossibleValidHit = Hit.Distance < BreakDistance && (IsUFlagNotSet(Activation, EGrapplingHookActivation::GA_Swing) || IsSurfaceSwingable(Hit.ImpactNormal));
+	//The hit point lies on its ray, its deviation is the angle between the ray and the aim direction
+	const FVector HitDirection = (Hit.ImpactPoint - StartLocation).GetSafeNormal(SMALL_NUMBER, Direction);
+	const float Deviation = FMath::Acos(FMath::Clamp(FVector::DotProduct(HitDirection, Direction), -1.f, 1.f)) * UGrapplingHookComponent::RadToDeg;
+	return bOutPossibleValidHit ? Deviation : Deviation + 180.f;
+}
+bool UGrapplingHookComponent::IsAimingHitValidCone(const FVector& StartLocation, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, FHitResult& OutHit, bool& bPossibleValidHit)
+{
+	const UWorld* const World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+	FCollisionQueryParams BlockingParams;
+	FCollisionObjectQueryParams BlockingQuery;
+	GetAimingQueryParams(bTraceComplex, BlockingQuery, BlockingParams);
+
+	AimAssist.BuildPattern(AimAssistConeDegrees, AimAssistRings, AimAssistRaysPerRing);
+	const FVector AimDirection = Direction.GetSafeNormal(SMALL_NUMBER, FVector::ForwardVector);
+	const FMatrix AimFrame = FGrapplingHookAimAssist::MakeAimFrame(AimDirection);
+	float BestScore = MAX_flt;
+	bool bHit = false;
+	FHitResult RayHit;
+	for (int32 Ring = 0; Ring < AimAssist.GetNumRings(); ++Ring)
+	{
+		for (int32 RayIndex = AimAssist.GetRingStart(Ring); RayIndex < AimAssist.GetRingStart(Ring + 1); ++RayIndex)
+		{
+			const FVector End = StartLocation + AimAssist.GetRayDirection(RayIndex, AimFrame) * MaxDistance;
+			if (!World->LineTraceSingleByObjectType(RayHit, StartLocation, End, BlockingQuery, BlockingParams) || !RayHit.Component.IsValid())
+			{
+				continue;
+			}
+			bool bRayPossibleValidHit = false;
+			const float Score = ScoreAimingHit(StartLocation, AimDirection, RayHit, bRayPossibleValidHit);
+			if (Score < BestScore)
+			{
+				BestScore = Score;
+				OutHit = RayHit;
+				bPossibleValidHit = bRayPossibleValidHit;
+				bHit = true;
+			}
+		}
+		//Outer rings deviate more, they can not beat a possible valid hit of this ring
+		if (bHit && bPossibleValidHit)
+		{
+			break;
+		}
+	}
+	return bHit;
+}
+void UGrapplingHookComponent::RequestAimAssist(const FVector& StartLocation, const FVector& Direction, const float MaxDistance, const bool bTraceComplex)
+{
+	UWorld* const World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+	AimAssist.BuildPattern(AimAssistConeDegrees, AimAssistRings, AimAssistRaysPerRing);
+	const double Now = World->GetTimeSeconds();
+	if (AimAssist.CanReuse(StartLocation, Direction, MaxDistance, bTraceComplex, Now, AimAssistReuseDistance, AimAssistReuseDegrees, AimAssistReuseTime))
+	{
+		return;
+	}
+
+	if (!AimAssistTraceDelegate.IsBound())
+	{
+		AimAssistTraceDelegate.BindUObject(this, &UGrapplingHookComponent::OnAimAssistTraceDone);
+	}
+	AimAssist.BeginSweep(StartLocation, Direction, MaxDistance, bTraceComplex, Now, bAimAssistRingByRing);
+	SubmitAimAssistRays(AimAssist, AimAssistTraceDelegate);
+}
+void UGrapplingHookComponent::SubmitAimAssistRays(FGrapplingHookAimAssist& Sweep, FTraceDelegate& Delegate)
+{
+	UWorld* const World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+	FCollisionQueryParams BlockingParams;
+	FCollisionObjectQueryParams BlockingQuery;
+	GetAimingQueryParams(Sweep.IsSweepTraceComplex(), BlockingQuery, BlockingParams);
+
+	//Traces requested in the same frame are processed together by the world async trace batch
+	const FVector& StartLocation = Sweep.GetSweepStart();
+	const float MaxDistance = Sweep.GetSweepMaxDistance();
+	const FMatrix AimFrame = FGrapplingHookAimAssist::MakeAimFrame(Sweep.GetSweepDirection());
+	for (int32 RayIndex = Sweep.GetRingStart(Sweep.GetSweepFirstRing()); RayIndex < Sweep.GetRingStart(Sweep.GetSweepRing() + 1); ++RayIndex)
+	{
+		const FVector End = StartLocation + Sweep.GetRayDirection(RayIndex, AimFrame) * MaxDistance;
+		World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, StartLocation, End, BlockingQuery, BlockingParams, &Delegate, Sweep.GetTraceUserData(RayIndex));
+	}
+}
+void UGrapplingHookComponent::OnAimAssistTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	const FHitResult* const Hit = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit && Datum.OutHits[0].Component.IsValid() ? &Datum.OutHits[0] : nullptr;
+	if (!AimAssist.StoreTraceResult(Datum.UserData, Hit))
+	{
+		return;
+	}
+
+	//Submitted rings complete: the rings traced so far are scored here, GetAimAssistHit only reads the selection
+	const FVector& StartLocation = AimAssist.GetSweepStart();
+	const FVector& Direction = AimAssist.GetSweepDirection();
+	const FHitResult* Best = nullptr;
+	bool bBestPossibleValidHit = false;
+	float BestScore = MAX_flt;
+	for (int32 Ring = 0; Ring <= AimAssist.GetSweepRing(); ++Ring)
+	{
+		for (int32 RayIndex = AimAssist.GetRingStart(Ring); RayIndex < AimAssist.GetRingStart(Ring + 1); ++RayIndex)
+		{
+			const FHitResult* const RayHit = AimAssist.GetRayHit(RayIndex);
+			if (!RayHit)
+			{
+				continue;
+			}
+			bool bRayPossibleValidHit = false;
+			const float Score = ScoreAimingHit(StartLocation, Direction, *RayHit, bRayPossibleValidHit);
+			if (Score < BestScore)
+			{
+				BestScore = Score;
+				Best = RayHit;
+				bBestPossibleValidHit = bRayPossibleValidHit;
+			}
+		}
+		//Outer rings deviate more, they can not beat a possible valid hit of this ring (same selection as IsAimingHitValidCone)
+		if (bBestPossibleValidHit)
+		{
+			break;
+		}
+	}
+	//Ring by ring sweeps trace the outer rings (next frame) only when no possible valid hit was found
+	if (!bBestPossibleValidHit && AimAssist.BeginNextRing())
+	{
+		SubmitAimAssistRays(AimAssist, AimAssistTraceDelegate);
+		return;
+	}
+	AimAssist.SetSelection(Best, bBestPossibleValidHit);
+}
+void UGrapplingHookComponent::OnTrajectoryAimTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	const FHitResult* const Hit = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit && Datum.OutHits[0].Component.IsValid() ? &Datum.OutHits[0] : nullptr;
+	//Single ray pattern: its only ring is complete
+	if (!TrajectoryAim.StoreTraceResult(Datum.UserData, Hit))
+	{
+		return;
+	}
+	bool bPossibleValidHit = false;
+	if (Hit)
+	{
+		ScoreAimingHit(TrajectoryAim.GetSweepStart(), TrajectoryAim.GetSweepDirection(), *Hit, bPossibleValidHit);
+	}
+	TrajectoryAim.SetSelection(Hit, bPossibleValidHit);
+}
+bool UGrapplingHookComponent::GetAimAssistHit(FHitResult& OutHit, bool& bPossibleValidHit) const
+{
+	return AimAssist.GetSelection(OutHit, bPossibleValidHit);
+}
+bool UGrapplingHookComponent::GetTrajectoryPreview(const FVector& StartLocation, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, TArray<FVector>& OutPoints, EGrapplingHookState& OutState)
+{
+	UWorld* const World = GetWorld();
+	if (World)
+	{
+		//Aim direction ray only, reused while the aim does not move like the aim assist sweeps
+		TrajectoryAim.BuildPattern(0.f, 0, 1);
+		const double Now = World->GetTimeSeconds();
+		if (!TrajectoryAim.CanReuse(StartLocation, Direction, MaxDistance, bTraceComplex, Now, AimAssistReuseDistance, AimAssistReuseDegrees, AimAssistReuseTime))
+		{
+			if (!TrajectoryAimTraceDelegate.IsBound())
+			{
+				TrajectoryAimTraceDelegate.BindUObject(this, &UGrapplingHookComponent::OnTrajectoryAimTraceDone);
+			}
+			TrajectoryAim.BeginSweep(StartLocation, Direction, MaxDistance, bTraceComplex, Now, false);
+			SubmitAimAssistRays(TrajectoryAim, TrajectoryAimTraceDelegate);
+		}
+	}
+
+	//Latest completed trace, the one submitted above is processed at the end of the frame
+	FHitResult Hit;
+	bool bPossibleValidHit = false;
+	if (!TrajectoryAim.GetSelection(Hit, bPossibleValidHit) || !bPossibleValidHit)
+	{
+		TrajectoryPreview.Invalidate();
+		OutPoints.Reset();
+		OutState = EGrapplingHookState::GS_Missed;
+		return false;
+	}
+	return GetTrajectoryPreviewTo(Hit.ImpactPoint, Hit.ImpactNormal, OutPoints, OutState);
+}
+bool UGrapplingHookComponent::GetTrajectoryPreviewTo(const FVector& TargetLocation, const FVector& TargetNormal, TArray<FVector>& OutPoints, EGrapplingHookState& OutState)
+{
+	//Same choice as SelectLandedState for a target that is not pulled
+	OutState = EGrapplingHookState::GS_Missed;
+	if (IsUFlagSet(Activation, EGrapplingHookActivation::GA_Swing))
+	{
+		OutState = IsSurfaceSwingable(TargetNormal) ? EGrapplingHookState::GS_Swing : EGrapplingHookState::GS_Missed;
+	}
+	else if (IsUFlagSet(Activation, EGrapplingHookActivation::GA_Launch))
+	{
+		OutState = EGrapplingHookState::GS_Launch;
+	}
+
+	const UWorld* const World = GetWorld();
+	bool bValidStart = true;
+	const FVector Start = GetGrappleStartLocation(bValidStart);
+	const FVector OwnerLocation = Owner ? Owner->GetActorLocation() : FVector::ZeroVector;
+	//Lazy cables may not exist yet, the owner location is used as grapple start
+	const FVector StartOffset = bValidStart ? Start - OwnerLocation : FVector::ZeroVector;
+	if (OutState == EGrapplingHookState::GS_Missed || !Owner || !World || FVector::Distance(OwnerLocation + StartOffset, TargetLocation) > BreakDistance)
+	{
+		TrajectoryPreview.Invalidate();
+		OutPoints.Reset();
+		return false;
+	}
+
+	//Runtime launch and swing depend on the frame time step, the cached one is kept while the frame rate is stable
+	static const float TimeStepTollerance = 0.05f;
+	const float FrameTimeStep = GetSimulationDeltaTime(World->GetDeltaSeconds());
+	const float CachedTimeStep = TrajectoryPreview.GetTimeStep();
+	const bool bSameSimulation = TrajectoryPreview.IsValid() && TrajectoryPreview.GetState() == static_cast<uint8>(OutState) && FMath::Abs(FrameTimeStep - CachedTimeStep) <= CachedTimeStep * TimeStepTollerance;
+
+	const FVector OwnerVelocity = Owner->GetVelocity();
+	if (bSameSimulation && OutState == EGrapplingHookState::GS_Swing)
+	{
+		//Nothing else in the world is simulated: a swing path only depends on the owner location relative to its anchor and drifts by the velocity change over the whole preview.
+		//Its points have a start weight of 1, shifting moves the path rigidly along with the owner
+		const FVector RelativeMove = (OwnerLocation - TargetLocation) - (TrajectoryPreview.GetOwnerLocation() - TrajectoryPreview.GetTarget());
+		const float VelocityMove = FVector::Distance(OwnerVelocity, TrajectoryPreview.GetOwnerVelocity()) * TrajectoryPreview.GetDuration();
+		if (FMath::Max(RelativeMove.Size(), VelocityMove) <= TrajectoryPreviewReuseDistance)
+		{
+			TrajectoryPreview.Shift(OwnerLocation, TargetLocation);
+			OutPoints = TrajectoryPreview.GetPoints();
+			return true;
+		}
+	}
+
+	//Launch overrides the owner velocity, its path only depends on the owner and target locations
+	const float MaxMove = FMath::Max(FVector::Distance(OwnerLocation, TrajectoryPreview.GetOwnerLocation()), FVector::Distance(TargetLocation, TrajectoryPreview.GetTarget()));
+	if (bSameSimulation && OutState == EGrapplingHookState::GS_Launch && MaxMove <= TrajectoryPreviewReuseDistance)
+	{
+		OutPoints = TrajectoryPreview.GetPoints();
+		return true;
+	}
+	//The fixed point launch is not exactly linear, it is always simulated again
+	if (bSameSimulation && OutState == EGrapplingHookState::GS_Launch && !bDeterministic && MaxMove <= TrajectoryPreviewShiftDistance)
+	{
+		//Shifting keeps the number of steps: a path that reached its target must still end there, one cut by TrajectoryPreviewMaxTime is exact
+		const FVector LaunchOffset(0.f, 0.f, GetUpdateParams().LaunchOffsetZ);
+		const float TolleranceSquared = FMath::Square(RetractDistanceTollerance);
+		const bool bReachedTarget = FVector::DistSquared(TrajectoryPreview.GetPoints().Last(), TrajectoryPreview.GetTarget() + LaunchOffset) <= TolleranceSquared;
+		TrajectoryPreview.Shift(OwnerLocation, TargetLocation);
+		if (!bReachedTarget || FVector::DistSquared(TrajectoryPreview.GetPoints().Last(), TargetLocation + LaunchOffset) <= TolleranceSquared)
+		{
+			OutPoints = TrajectoryPreview.GetPoints();
+			return true;
+		}
+	}
+
+	TrajectoryPreview.Reset(static_cast<uint8>(OutState), OwnerLocation, OwnerVelocity, TargetLocation, bSameSimulation ? CachedTimeStep : FrameTimeStep);
+	if (OutState == EGrapplingHookState::GS_Launch)
+	{
+		if (bDeterministic)
+		{
+			SimulateDeterministicLaunchPreview(StartOffset);
+		}
+		else
+		{
+			SimulateLaunchPreview(StartOffset);
+		}
+	}
+	else if (bDeterministic)
+	{
+		SimulateDeterministicSwingPreview();
+	}
+	else
+	{
+		SimulateSwingPreview(StartOffset);
+	}
+	OutPoints = TrajectoryPreview.GetPoints();
+	return true;
+}
+const TArray<FVector>& UGrapplingHookComponent::GetTrajectoryPreviewPoints() const
+{
+	return TrajectoryPreview.GetPoints();
+}
+int32 UGrapplingHookComponent::GetRopeContacts(TArray<FVector>& OutLocations, const int32 HookIndex) const
+{
+	OutLocations.Reset();
+	if (Hooks.IsValidIndex(HookIndex))
+	{
+		//Spans are ordered from the cable component (grapple start) to its end
+		for (const FGrapplingHookRopeContact& Contact : Hooks[HookIndex].RopeContacts)
+		{
+			if (Contact.bContact)
+			{
+				OutLocations.Add(Contact.Location);
+			}
+		}
+	}
+	return OutLocations.Num();
+}
+void UGrapplingHookComponent::UpdateRopeCollision()
+{
+	const FGrapplingHookStateTable& Table = GetStateTable();
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		const FGrapplingHookInstance& Instance = Hooks[HookIndex];
+		//Only the cables of the updated hooks are visible and moving
+		if (!Table.Update[static_cast<int32>(Instance.CurrentState)] || !Instance.Cable || !Instance.Cable->IsVisible())
+		{
+			continue;
+		}
+		//A routed cable is hidden from the frame, its first route cable tells whether the rope is rendered
+		const UCableComponent* const RenderedCable = Instance.bRopeRouted && Instance.RopeRouteCables.Num() > 0 && Instance.RopeRouteCables[0] ? Instance.RopeRouteCables[0] : Instance.Cable;
+		const int32 Budget = GetRopeCollisionBudget(RenderedCable);
+		if (Budget > 0)
+		{
+			UpdateRopeCollision(HookIndex, Budget);
+		}
+	}
+}
+void UGrapplingHookComponent::UpdateRopeCollision(const int32 HookIndex, const int32 MaxSweeps)
+{
+	UWorld* const World = GetWorld();
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	UCableComponent* const Cable = Instance.Cable;
+	if (!World || !Cable)
+	{
+		return;
+	}
+
+	//Particles go from the cable component (grapple start) to the cable end (grapple end)
+	Cable->GetCableParticleLocations(RopeCollisionParticles);
+	const int32 NumSegments = RopeCollisionParticles.Num() - 1;
+	if (NumSegments < 1)
+	{
+		return;
+	}
+	const int32 NumSpans = FMath::Min(RopeCollisionSpans, NumSegments);
+	if (Instance.RopeContacts.Num() != NumSpans)
+	{
+		Instance.RopeContacts.Reset();
+		Instance.RopeContacts.SetNum(NumSpans);
+		Instance.RopeCollisionCursor = 0;
+	}
+
+	//Same query as the cable particle collision, a sphere swept along a span covers the capsule around it
+	const float Radius = FMath::Max(Cable->CableWidth * 0.5f, KINDA_SMALL_NUMBER);
+	const FCollisionShape Shape = FCollisionShape::MakeSphere(Radius);
+	FCollisionQueryParams Params(FCollisionQueryParams::DefaultQueryParam);
+	FCollisionResponseParams ResponseParams;
+	Cable->InitSweepCollisionParams(Params, ResponseParams);
+	Params.AddIgnoredActor(Owner);
+	Params.AddIgnoredActor(Instance.Hook);
+	const ECollisionChannel Channel = Cable->GetCollisionObjectType();
+
+	const float ReuseDistanceSquared = FMath::Square(RopeCollisionReuseDistance);
+	const int32 Cursor = FMath::Clamp(Instance.RopeCollisionCursor, 0, NumSpans - 1);
+	int32 NextCursor = Cursor;
+	int32 Sweeps = 0;
+	bool bContact = false;
+	for (int32 Visited = 0; Visited < NumSpans; ++Visited)
+	{
+		const int32 Span = (Cursor + Visited) % NumSpans;
+		FGrapplingHookRopeContact& Contact = Instance.RopeContacts[Span];
+		const FVector Start = RopeCollisionParticles[(Span * NumSegments) / NumSpans];
+		const FVector End = RopeCollisionParticles[((Span + 1) * NumSegments) / NumSpans];
+
+		const bool bMoved = !Contact.bSwept || FVector::DistSquared(Start, Contact.SpanStart) > ReuseDistanceSquared || FVector::DistSquared(End, Contact.SpanEnd) > ReuseDistanceSquared;
+		if (bMoved && Sweeps >= MaxSweeps && NextCursor == Cursor)
+		{
+			//Out of budget: the next pass starts from the first span left behind
+			NextCursor = Span;
+		}
+		if (!bMoved || Sweeps >= MaxSweeps)
+		{
+			bContact = bContact || Contact.bContact;
+			continue;
+		}
+		++Sweeps;
+
+		//A moved span is always swept against the whole world, a nearer blocker may have come between the span ends and the previous contact
+		FHitResult Hit;
+		const bool bHit = World->SweepSingleByChannel(Hit, Start, End, FQuat::Identity, Channel, Shape, Params, ResponseParams);
+		Contact.SpanStart = Start;
+		Contact.SpanEnd = End;
+		Contact.bSwept = true;
+		Contact.bContact = bHit;
+		Contact.Component = nullptr;
+		if (bHit)
+		{
+			Contact.Component = Hit.Component;
+			Contact.Normal = Hit.ImpactNormal;
+			Contact.Location = Hit.ImpactPoint + Hit.ImpactNormal * Radius;
+		}
+		bContact = bContact || bHit;
+	}
+	Instance.RopeCollisionCursor = NextCursor;
+
+	if (bRopeContactCableCollision)
+	{
+		Cable->bEnableCollision = bContact;
+		ClearRopeRoute(HookIndex);
+	}
+	else if (bContact)
+	{
+		UpdateRopeRoute(HookIndex, RopeCollisionParticles[0], RopeCollisionParticles.Last());
+	}
+	else
+	{
+		ClearRopeRoute(HookIndex);
+	}
+}
+void UGrapplingHookComponent::UpdateRopeRoute(const int32 HookIndex, const FVector& Start, const FVector& End)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	UCableComponent* const Cable = Instance.Cable;
+	if (!Cable)
+	{
+		return;
+	}
+
+	//Route points go from Start through the contacts (ordered from the grapple start) to End, a straight route cable between every two of them
+	const int32 NumContacts = Instance.RopeContacts.Num();
+	int32 NumRoutes = 0;
+	FVector RouteStart = Start;
+	for (int32 Span = 0; Span <= NumContacts; ++Span)
+	{
+		const bool bEnd = Span == NumContacts;
+		if (!bEnd && !Instance.RopeContacts[Span].bContact)
+		{
+			continue;
+		}
+		UCableComponent* const RouteCable = GetRopeRouteCable(HookIndex, NumRoutes);
+		if (!RouteCable)
+		{
+			ClearRopeRoute(HookIndex);
+			return;
+		}
+		const FVector RouteEnd = bEnd ? End : Instance.RopeContacts[Span].Location;
+		//Route cables are not attached, the end location is relative to their world location only
+		RouteCable->SetWorldLocation(RouteStart);
+		RouteCable->EndLocation = RouteEnd - RouteStart;
+		RouteCable->CableLength = FVector::Dist(RouteStart, RouteEnd);
+		if (!RouteCable->IsVisible())
+		{
+			RouteCable->SetVisibility(true);
+		}
+		RouteStart = RouteEnd;
+		++NumRoutes;
+	}
+	for (int32 RouteIndex = NumRoutes; RouteIndex < Instance.RopeRouteCables.Num(); ++RouteIndex)
+	{
+		UCableComponent* const RouteCable = Instance.RopeRouteCables[RouteIndex];
+		if (RouteCable && RouteCable->IsVisible())
+		{
+			RouteCable->SetVisibility(false);
+		}
+	}
+
+	if (!Instance.bRopeRouted)
+	{
+		//Hidden from the frame only: the cable stays visible and simulated, the rope collision pass keeps sweeping its particles
+		Instance.bRopeRouted = true;
+		Instance.bRopeRouteMainPass = Cable->bRenderInMainPass;
+		Instance.bRopeRouteCastShadow = Cable->CastShadow;
+		Cable->SetRenderInMainPass(false);
+		Cable->SetCastShadow(false);
+	}
+}
+UCableComponent* UGrapplingHookComponent::GetRopeRouteCable(const int32 HookIndex, const int32 RouteIndex)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	if (Instance.RopeRouteCables.IsValidIndex(RouteIndex))
+	{
+		return Instance.RopeRouteCables[RouteIndex];
+	}
+	AActor* const ActorOwner = GetOwner();
+	const UCableComponent* const Cable = Instance.Cable;
+	if (!ActorOwner || !Cable || RouteIndex != Instance.RopeRouteCables.Num())
+	{
+		return nullptr;
+	}
+
+	//Same look as the hook cable, both ends fixed (a route is taut between its points)
+	UCableComponent* const RouteCable = NewObject<UCableComponent>(ActorOwner, Cable->GetClass(), NAME_None, RF_Transient);
+	RouteCable->CableWidth = Cable->CableWidth;
+	RouteCable->NumSides = Cable->NumSides;
+	RouteCable->TileMaterial = Cable->TileMaterial;
+	RouteCable->NumSegments = FMath::Max(Cable->NumSegments / FMath::Max(RopeCollisionSpans, 1), 1);
+	RouteCable->SolverIterations = Cable->SolverIterations;
+	RouteCable->CableGravityScale = Cable->CableGravityScale;
+	RouteCable->bAttachStart = true;
+	RouteCable->bAttachEnd = true;
+	RouteCable->bEnableCollision = false;
+	RouteCable->CastShadow = Cable->CastShadow;
+	RouteCable->SetMaterial(0, Cable->GetMaterial(0));
+	RouteCable->RegisterComponent();
+	RouteCable->SetVisibility(false);
+
+	Instance.RopeRouteCables.Add(RouteCable);
+	return RouteCable;
+}
+void UGrapplingHookComponent::ClearRopeRoute(const int32 HookIndex)
+{
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	for (UCableComponent* const RouteCable : Instance.RopeRouteCables)
+	{
+		if (RouteCable && RouteCable->IsVisible())
+		{
+			RouteCable->SetVisibility(false);
+		}
+	}
+	if (Instance.bRopeRouted)
 	{
-		bool bValid = true;
-		Owner->LaunchCharacter(GetOwnerLaunchVelocity(Deltatime, LaunchSpeed, GetGrappleEndLocationWithLaunchOffset(bValid), Owner->GetActorLocation()), true, true);
-		if (!bValid)
+		Instance.bRopeRouted = false;
+		if (Instance.Cable)
 		{
-			OnGrappleError.Broadcast(EGrapplingHookError::GE_LaunchUpdateCore);
+			Instance.Cable->SetRenderInMainPass(Instance.bRopeRouteMainPass);
+			Instance.Cable->SetCastShadow(Instance.bRopeRouteCastShadow);
 		}
-		return;
 	}
-	OnGrappleError.Broadcast(EGrapplingHookError::GE_LaunchUpdateCore);
 }
-bool UGrapplingHookComponent::UpdatePulledObject()
+int32 UGrapplingHookComponent::GetRopeCollisionBudget(const UCableComponent* const Cable) const
 {
-	if (!PullHandle || !Cable)
+	//Rope collision is only visual
+	if (!Cable->WasRecentlyRendered())
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_PullUpdateCore);
-		return true;
+		return 0;
 	}
-	if (!IsGrappledObjectPullable())
+	const UWorld* const World = GetWorld();
+	if (RopeCollisionLODDistance <= 0.f || !World)
 	{
-		return true;
+		return RopeCollisionSpans;
 	}
-	PullHandle->SetInterpolationSpeed(PullObjectInterpolationSpeed);
 
-	bool bValid = true;
-	const FVector StartLocation = GetGrappleStartLocation(bValid);
-	if (!bValid)
+	float DistanceSquared = MAX_flt;
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_PullUpdateCore);
+		const APlayerController* const Controller = Iterator->Get();
+		if (Controller && Controller->IsLocalController() && Controller->PlayerCameraManager)
+		{
+			DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(Controller->PlayerCameraManager->GetCameraLocation(), Cable->Bounds.Origin));
+		}
 	}
-	PullHandle->SetTargetLocation(StartLocation + (Cable->GetForwardVector() * PullDistanceTollerance));
-
-	FVector Out;
-	return PullDistanceInterrupt >= GrappledObject->GetClosestPointOnCollision(StartLocation, Out);
+	if (DistanceSquared == MAX_flt)
+	{
+		return RopeCollisionSpans;
+	}
+	//Every LOD halves the sweeps, at least one span is swept per frame
+	const int32 LOD = FMath::Min(FMath::FloorToInt(FMath::Sqrt(DistanceSquared) / RopeCollisionLODDistance), 16);
+	return FMath::Max(RopeCollisionSpans >> LOD, 1);
 }
-void UGrapplingHookComponent::ActivatePull()
+void UGrapplingHookComponent::ResetRopeCollision(const int32 HookIndex)
 {
-	if (!PullHandle)
+	FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	Instance.RopeContacts.Reset();
+	Instance.RopeCollisionCursor = 0;
+	ClearRopeRoute(HookIndex);
+	if (Instance.Cable && bRopeCollision && bRopeContactCableCollision)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_PullActivationCore);
-		return;
+		Instance.Cable->bEnableCollision = false;
 	}
-	if (PullHandle->GrabbedComponent != GrappledObject)
+}
+void UGrapplingHookComponent::SimulateLaunchPreview(const FVector& StartOffset)
+{
+	const FGrapplingHookUpdateParams Params = GetUpdateParams();
+	const float Step = TrajectoryPreview.GetTimeStep();
+	const int32 MaxSteps = Step > 0.f ? FMath::CeilToInt(TrajectoryPreviewMaxTime / Step) : 0;
+	const UWorld* const World = GetWorld();
+	const float GravityStep = World ? World->GetGravityZ() * Step : 0.f;
+	const FVector LaunchTarget = TrajectoryPreview.GetTarget() + FVector(0.f, 0.f, Params.LaunchOffsetZ);
+	//Every step moves the owner by LaunchSpeed * Step^2 of its distance to the target (see FGrapplingHookUpdateInput::Compute)
+	const float StartDecay = 1.f - Params.LaunchSpeed * Step * Step;
+
+	FGrapplingHookUpdateInput Input;
+	Input.State = EGrapplingHookState::GS_Launch;
+	Input.EndLocation = TrajectoryPreview.GetTarget();
+	Input.HookLocation = Input.EndLocation;
+	Input.DeltaTime = Step;
+	Input.bValidStart = true;
+	Input.bValidEnd = true;
+	FGrapplingHookUpdateResult Result;
+
+	FVector Location = TrajectoryPreview.GetOwnerLocation();
+	float StartWeight = 1.f;
+	TrajectoryPreview.AddPoint(Location, StartWeight, TrajectoryPreviewMinSpacing, true);
+	int32 StepIndex = 0;
+	while (StepIndex < MaxSteps)
 	{
-		PullHandle->ReleaseComponent();
-		bool bValid = true;
-		PullHandle->GrabComponentAtLocation(GrappledObject, NAME_None, GetGrappleEndLocation(bValid));
-		if (!bValid)
+		++StepIndex;
+		Input.OwnerLocation = Location;
+		Input.StartLocation = Location + StartOffset;
+		Input.Compute(Params, Result);
+		//LaunchCharacter overrides the velocity, then the falling movement applies gravity
+		Location += (Result.LaunchVelocity + FVector(0.f, 0.f, GravityStep)) * Step;
+		StartWeight *= StartDecay;
+		if (FVector::DistSquared(Location, LaunchTarget) <= FMath::Square(RetractDistanceTollerance))
 		{
-			OnGrappleError.Broadcast(EGrapplingHookError::GE_PullActivationCore);
+			break;
 		}
+		TrajectoryPreview.AddPoint(Location, StartWeight, TrajectoryPreviewMinSpacing, false);
 	}
-}
-bool UGrapplingHookComponent::IsGrappledObjectPullable() const
-{
-	if (GrappledObject)
+	//The path always ends at the last simulated location
+	if (TrajectoryPreview.GetPoints().Last() != Location)
 	{
-		return GrappledObject->Mobility == EComponentMobility::Type::Movable && GrappledObject->IsSimulatingPhysics() && GrappledObject->GetMass() <= PullMaxObjectMass;
+		TrajectoryPreview.AddPoint(Location, StartWeight, TrajectoryPreviewMinSpacing, true);
 	}
-	return false;
+	TrajectoryPreview.SetDuration(StepIndex * Step);
 }
-bool UGrapplingHookComponent::IsOwnerLaunchingMidair() const
+void UGrapplingHookComponent::SimulateSwingPreview(const FVector& StartOffset)
 {
-	if (Owner)
+	const float Step = TrajectoryPreview.GetTimeStep();
+	const int32 MaxSteps = Step > 0.f ? FMath::CeilToInt(TrajectoryPreviewMaxTime / Step) : 0;
+	float SubstepTime = Step;
+	const int32 Substeps = GetSwingSubsteps(Step, SubstepTime);
+	const UWorld* const World = GetWorld();
+	const float GravityStep = World ? World->GetGravityZ() * SubstepTime : 0.f;
+
+	FVector Location = TrajectoryPreview.GetOwnerLocation();
+	FVector Velocity = TrajectoryPreview.GetOwnerVelocity();
+	TArray<FGrapplingHookSwingRope> Ropes;
+	FGrapplingHookSwingRope& Rope = Ropes.AddDefaulted_GetRef();
+	Rope.LocalStart = StartOffset;
+	Rope.Anchor = TrajectoryPreview.GetTarget();
+	Rope.Length = FVector::Distance(Location + StartOffset, Rope.Anchor);
+	Rope.HookIndex = 0;
+	Rope.bConstrained = false;
+
+	//Swing paths are not linear in their inputs, the start weights are not used
+	TrajectoryPreview.AddPoint(Location, 1.f, TrajectoryPreviewMinSpacing, true);
+	for (int32 StepIndex = 0; StepIndex < MaxSteps; ++StepIndex)
 	{
-		const UCharacterMovementComponent* const MoveComponent = Owner->GetCharacterMovement();
-		if (MoveComponent)
+		//Same order as the physics substeps: the rope solver runs before the body is integrated (see SubstepSwing)
+		for (int32 Substep = 0; Substep < Substeps; ++Substep)
 		{
-			return CurrentState == EGrapplingHookState::GS_Launch && !MoveComponent->IsMovingOnGround();
+			Velocity = SolveSwingRopeVelocity(FTransform(Location), Velocity, Ropes, SubstepTime);
+			Velocity.Z += GravityStep;
+			Location += Velocity * SubstepTime;
 		}
+		TrajectoryPreview.AddPoint(Location, 1.f, TrajectoryPreviewMinSpacing, false);
 	}
-	return false;
+	if (TrajectoryPreview.GetPoints().Last() != Location)
+	{
+		TrajectoryPreview.AddPoint(Location, 1.f, TrajectoryPreviewMinSpacing, true);
+	}
+	TrajectoryPreview.SetDuration(MaxSteps * Step);
 }
-bool UGrapplingHookComponent::IsAimingHitValid(const FVector& StartLocation, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, FHitResult& OutHit, bool& bPossibleValidHit) const
+void UGrapplingHookComponent::SimulateDeterministicLaunchPreview(const FVector& StartOffset)
 {
-	const UWorld* const World = GetWorld();
-	if (World)
+	const FGrapplingHookUpdateParams Params = GetUpdateParams();
+	const float Step = TrajectoryPreview.GetTimeStep();
+	const int32 MaxSteps = Step > 0.f ? FMath::CeilToInt(TrajectoryPreviewMaxTime / Step) : 0;
+	const FGrapplingHookFixed FixedStep = FGrapplingHookFixed::FromFloat(Step);
+	const FGrapplingHookFixedVector LaunchTarget = FGrapplingHookFixedVector::FromVector(TrajectoryPreview.GetTarget() + FVector(0.f, 0.f, Params.LaunchOffsetZ));
+	const FGrapplingHookFixed Tollerance = FGrapplingHookFixed::FromFloat(RetractDistanceTollerance);
+	const TArray<FGrapplingHookFixedRope> NoRopes;
+
+	FGrapplingHookUpdateInput Input;
+	Input.State = EGrapplingHookState::GS_Launch;
+	Input.EndLocation = TrajectoryPreview.GetTarget();
+	Input.HookLocation = Input.EndLocation;
+	Input.DeltaTime = Step;
+	Input.bValidStart = true;
+	Input.bValidEnd = true;
+	FGrapplingHookUpdateResult Result;
+
+	//Same steps as UpdateDeterministicOwner while launching: the launch velocity replaces the owner velocity, no gravity is applied
+	FGrapplingHookFixedVector Location = FGrapplingHookFixedVector::FromVector(TrajectoryPreview.GetOwnerLocation());
+	FGrapplingHookFixedVector Velocity;
+	TrajectoryPreview.AddPoint(Location.ToVector(), 1.f, TrajectoryPreviewMinSpacing, true);
+	int32 StepIndex = 0;
+	while (StepIndex < MaxSteps)
 	{
-		FCollisionQueryParams BlockingParams(FCollisionQueryParams::DefaultQueryParam);
-		BlockingParams.bTraceComplex = bTraceComplex;
-		BlockingParams.AddIgnoredActor(Owner);
-		FCollisionObjectQueryParams BlockingQuery;
-		for (const ECollisionChannel Item : BlockingObjects)
+		++StepIndex;
+		Input.OwnerLocation = Location.ToVector();
+		Input.StartLocation = Input.OwnerLocation + StartOffset;
+		Input.Compute(Params, Result);
+		Velocity = FGrapplingHookFixedVector::FromVector(Result.LaunchVelocity);
+		StepDeterministicOwner(Location, Velocity, FGrapplingHookFixedVector(), NoRopes, FixedStep);
+		TrajectoryPreview.AddPoint(Location.ToVector(), 1.f, TrajectoryPreviewMinSpacing, false);
+		if ((LaunchTarget - Location).SizeSquared() <= Tollerance * Tollerance)
 		{
-			BlockingQuery.AddObjectTypesToQuery(Item);
+			break;
 		}
+	}
+	if (TrajectoryPreview.GetPoints().Last() != Location.ToVector())
+	{
+		TrajectoryPreview.AddPoint(Location.ToVector(), 1.f, TrajectoryPreviewMinSpacing, true);
+	}
+	TrajectoryPreview.SetDuration(StepIndex * Step);
+}
+void UGrapplingHookComponent::SimulateDeterministicSwingPreview()
+{
+	const float Step = TrajectoryPreview.GetTimeStep();
+	const int32 MaxSteps = Step > 0.f ? FMath::CeilToInt(TrajectoryPreviewMaxTime / Step) : 0;
+	const FGrapplingHookFixed FixedStep = FGrapplingHookFixed::FromFloat(Step);
+	//No swinging force or reel input is predicted
+	const FGrapplingHookFixedVector Acceleration = GetDeterministicSwingAcceleration(FVector::ZeroVector);
 
-		const bool Hit = World->LineTraceSingleByObjectType(OutHit, StartLocation, StartLocation + (Direction * MaxDistance), BlockingQuery, BlockingParams);
-		if (!OutHit.Component.IsValid() || !Hit)
-		{
-			return false;
-		}
-		bPossibleValidHit = OutHit.Distance < BreakDistance && (IsUFlagNotSet(Activation, EGrapplingHookActivation::GA_Swing) || IsSurfaceSwingable(OutHit.ImpactNormal));
-		return true;
+	//The deterministic rope is measured from the owner location when the swing is activated (see ActivateSwing)
+	FGrapplingHookFixedVector Location = FGrapplingHookFixedVector::FromVector(TrajectoryPreview.GetOwnerLocation());
+	FGrapplingHookFixedVector Velocity = FGrapplingHookFixedVector::FromVector(TrajectoryPreview.GetOwnerVelocity());
+	TArray<FGrapplingHookFixedRope> Ropes;
+	FGrapplingHookFixedRope& Rope = Ropes.AddDefaulted_GetRef();
+	Rope.Anchor = FGrapplingHookFixedVector::FromVector(TrajectoryPreview.GetTarget());
+	Rope.Length = (Location - Rope.Anchor).Size();
+
+	TrajectoryPreview.AddPoint(Location.ToVector(), 1.f, TrajectoryPreviewMinSpacing, true);
+	for (int32 StepIndex = 0; StepIndex < MaxSteps; ++StepIndex)
+	{
+		StepDeterministicOwner(Location, Velocity, Acceleration, Ropes, FixedStep);
+		TrajectoryPreview.AddPoint(Location.ToVector(), 1.f, TrajectoryPreviewMinSpacing, false);
 	}
-	return false;
+	if (TrajectoryPreview.GetPoints().Last() != Location.ToVector())
+	{
+		TrajectoryPreview.AddPoint(Location.ToVector(), 1.f, TrajectoryPreviewMinSpacing, true);
+	}
+	TrajectoryPreview.SetDuration(MaxSteps * Step);
+}
+int32 UGrapplingHookComponent::GetSwingSubsteps(const float Deltatime, float& OutSubstepTime) const
+{
+	OutSubstepTime = Deltatime;
+	//Custom physics runs once per physics substep (see UpdateSwing), split as the physics scene does (FPhysSubstepTask::UpdateTime)
+	const UPhysicsSettings* const Settings = UPhysicsSettings::Get();
+	if (!bSubstepSwing || bDeterministic || !Settings || !Settings->bSubstepping || Settings->MaxSubstepDeltaTime <= 0.f)
+	{
+		return 1;
+	}
+	const int32 MaxSubsteps = FMath::Max(Settings->MaxSubsteps, 1);
+	const float FrameTime = FMath::Min(Deltatime, MaxSubsteps * Settings->MaxSubstepDeltaTime);
+	const int32 Substeps = FMath::Clamp(FMath::CeilToInt(FrameTime / Settings->MaxSubstepDeltaTime), 1, MaxSubsteps);
+	OutSubstepTime = FrameTime / Substeps;
+	return Substeps;
 }
 bool UGrapplingHookComponent::IsUFlagSet(const uint8 Flags, const EGrapplingHookActivation Flag) const
 {
@@ -950,56 +4056,391 @@ void UGrapplingHookComponent::TickComponent(float DeltaTime, ELevelTick TickType
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (!Hook || !Owner || !Cable)
+	bCoreFailureThisTick = false;
+	RefreshAnchors();
+
+	if (bDeterministic)
+	{
+		const float StepTime = GetSimulationDeltaTime(DeltaTime);
+		const int32 NumSteps = ConsumeDeterministicSteps(DeltaTime);
+		for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+		{
+			StepDeterministic(StepTime, StepIndex == 0);
+		}
+		//Kept by the last cooldown, lazy release or error flush until its timer fired
+		if (!IsAnyHookTicking() && !HasPendingDeterministicTimers())
+		{
+			SetComponentTickEnabled(false);
+		}
+	}
+	else
+	{
+		(this->*GetStateTable().UpdateHooks)(DeltaTime);
+		UpdateOwnerLaunch(DeltaTime);
+		UpdateSwing(DeltaTime);
+	}
+	if (bRopeCollision)
 	{
-		OnGrappleError.Broadcast(EGrapplingHookError::GE_UpdateCore);
-		StopGrapple();
+		UpdateRopeCollision();
 	}
 
-	bool bValid = true;
-	if (GetGrappleLength(bValid) > BreakDistance)
+	ConsecutiveCoreFailures = bCoreFailureThisTick ? ConsecutiveCoreFailures + 1 : 0;
+	if (MaxConsecutiveCoreFailures > 0 && ConsecutiveCoreFailures >= MaxConsecutiveCoreFailures)
+	{
+		//References are not coming back on their own, stop retrying every frame
+		ConsecutiveCoreFailures = 0;
+		ResetComponentState();
+		SetComponentTickEnabled(false);
+		ReportError(EGrapplingHookError::GE_CoreFailureTickDisabled);
+	}
+}
+const FGrapplingHookStateTable& UGrapplingHookComponent::GetStateTable()
+{
+	//Activation can also be written directly (Blueprints, editor), the table is checked against it
+	if (!bRefreshingStateTable && (!StateTable || StateTable->Activation != Activation))
+	{
+		RefreshStateTable();
+	}
+	return *StateTable;
+}
+void UGrapplingHookComponent::RefreshStateTable()
+{
+	const FGrapplingHookStateTable& NewTable = FindStateTable(Activation);
+	if (StateTable && StateTable != &NewTable && !bRefreshingStateTable)
+	{
+		//The specialized tables have no exit handlers for disabled features, hooks left in their states are interrupted with the previous table
+		bRefreshingStateTable = true;
+		for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+		{
+			if (!NewTable.bEnabled[static_cast<int32>(Hooks[HookIndex].CurrentState)])
+			{
+				StopGrappleAt(HookIndex);
+			}
+		}
+		bRefreshingStateTable = false;
+	}
+	StateTable = &NewTable;
+}
+bool UGrapplingHookComponent::BeginHookUpdate(const int32 HookIndex, const float DeltaTime)
+{
+	const FGrapplingHookInstance& Instance = Hooks[HookIndex];
+	//Hooks still flying or waiting have no update handler
+	if (!StateTable->Update[static_cast<int32>(Instance.CurrentState)])
+	{
+		return false;
+	}
+
+	if (!Instance.Hook || !Owner || !Instance.Cable)
+	{
+		ReportError(EGrapplingHookError::GE_UpdateCore);
+		StopGrappleAt(HookIndex);
+	}
+
+	if (GetHookUpdate(HookIndex, DeltaTime).bBreak)
 	{
-		StopGrapple();
+		StopGrappleAt(HookIndex);
+		FGrapplingHookTelemetry::RecordBreak();
 		OnGrappleBreaked.Broadcast();
 	}
+	return true;
+}
+void UGrapplingHookComponent::UpdateHooksDynamic(const float DeltaTime)
+{
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		if (BeginHookUpdate(HookIndex, DeltaTime))
+		{
+			//The state may have changed after an interruption
+			DispatchHookUpdateDynamic(HookIndex, DeltaTime);
+		}
+	}
+}
+void UGrapplingHookComponent::DispatchHookUpdateDynamic(const int32 HookIndex, const float DeltaTime)
+{
+	const FGrapplingHookStateTable::FUpdateHandler Update = StateTable->Update[static_cast<int32>(Hooks[HookIndex].CurrentState)];
+	if (Update)
+	{
+		(this->*Update)(HookIndex, DeltaTime);
+	}
+}
+void UGrapplingHookComponent::ExitHookDynamic(const int32 HookIndex)
+{
+	const FGrapplingHookStateTable::FExitHandler Exit = StateTable->Exit[static_cast<int32>(Hooks[HookIndex].CurrentState)];
+	if (Exit)
+	{
+		(this->*Exit)(HookIndex);
+	}
+}
+void UGrapplingHookComponent::BuildStateTable(const uint8 Mask, FGrapplingHookStateTable& OutTable)
+{
+	const bool bPull = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Pull)) != 0;
+	const bool bLaunch = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Launch)) != 0;
+	const bool bSwing = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Swing)) != 0;
+
+	OutTable = FGrapplingHookStateTable();
+	OutTable.Activation = Mask;
+	OutTable.bExtending = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Extending)) != 0;
+	OutTable.bRetracting = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Retracting)) != 0;
+	OutTable.bCooldown = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Cooldown)) != 0;
+	OutTable.bEnabled[static_cast<int32>(EGrapplingHookState::GS_Launch)] = bLaunch;
+	OutTable.bEnabled[static_cast<int32>(EGrapplingHookState::GS_Pull)] = bPull;
+	OutTable.bEnabled[static_cast<int32>(EGrapplingHookState::GS_Tug)] = bPull;
+	OutTable.bEnabled[static_cast<int32>(EGrapplingHookState::GS_Swing)] = bSwing;
+	OutTable.UpdateHooks = &UGrapplingHookComponent::UpdateHooksDynamic;
+	OutTable.ExitHook = &UGrapplingHookComponent::ExitHookDynamic;
+
+	//Hooks left in the state of a disabled feature (mask changed while active) are interrupted
+	OutTable.Update[static_cast<int32>(EGrapplingHookState::GS_Launch)] = bLaunch ? &UGrapplingHookComponent::UpdateLaunchState : &UGrapplingHookComponent::UpdateInvalidState;
+	OutTable.Update[static_cast<int32>(EGrapplingHookState::GS_Pull)] = bPull ? &UGrapplingHookComponent::UpdatePullState : &UGrapplingHookComponent::UpdateInvalidState;
+	OutTable.Update[static_cast<int32>(EGrapplingHookState::GS_Tug)] = bPull ? &UGrapplingHookComponent::UpdateTugState : &UGrapplingHookComponent::UpdateInvalidState;
+	OutTable.Update[static_cast<int32>(EGrapplingHookState::GS_Swing)] = bSwing ? &UGrapplingHookComponent::UpdateSwingState : &UGrapplingHookComponent::UpdateInvalidState;
+	OutTable.Update[static_cast<int32>(EGrapplingHookState::GS_Retracting)] = &UGrapplingHookComponent::UpdateRetractState;
+	OutTable.Update[static_cast<int32>(EGrapplingHookState::GS_Missed)] = &UGrapplingHookComponent::UpdateInvalidState;
 
-	switch (CurrentState)
+	//Exit handlers do not depend on the mask in the non specialized tables, they clean up hooks activated before the mask changed
+	OutTable.Exit[static_cast<int32>(EGrapplingHookState::GS_Pull)] = &UGrapplingHookComponent::InterruptPull;
+	OutTable.Exit[static_cast<int32>(EGrapplingHookState::GS_Tug)] = &UGrapplingHookComponent::InterruptTug;
+	OutTable.Exit[static_cast<int32>(EGrapplingHookState::GS_Swing)] = &UGrapplingHookComponent::InterruptSwing;
+	OutTable.Exit[static_cast<int32>(EGrapplingHookState::GS_Extending)] = &UGrapplingHookComponent::ExitExtendingState;
+	OutTable.bInterruptible[static_cast<int32>(EGrapplingHookState::GS_Launch)] = true;
+	OutTable.bInterruptible[static_cast<int32>(EGrapplingHookState::GS_Pull)] = true;
+	OutTable.bInterruptible[static_cast<int32>(EGrapplingHookState::GS_Tug)] = true;
+	OutTable.bInterruptible[static_cast<int32>(EGrapplingHookState::GS_Swing)] = true;
+	OutTable.bInterruptible[static_cast<int32>(EGrapplingHookState::GS_Missed)] = true;
+	OutTable.bInterruptible[static_cast<int32>(EGrapplingHookState::GS_Extending)] = true;
+
+	if (OutTable.bCooldown)
+	{
+		OutTable.Cooldown[static_cast<int32>(EGrapplingHookState::GS_Launch)] = &UGrapplingHookComponent::LaunchCooldown;
+		OutTable.Cooldown[static_cast<int32>(EGrapplingHookState::GS_Pull)] = &UGrapplingHookComponent::PullCooldown;
+		OutTable.Cooldown[static_cast<int32>(EGrapplingHookState::GS_Tug)] = &UGrapplingHookComponent::TugCooldown;
+		OutTable.Cooldown[static_cast<int32>(EGrapplingHookState::GS_Swing)] = &UGrapplingHookComponent::SwingCooldown;
+		OutTable.Cooldown[static_cast<int32>(EGrapplingHookState::GS_Missed)] = &UGrapplingHookComponent::MissedCooldown;
+	}
+}
+FORCEINLINE EGrapplingHookState UGrapplingHookComponent::SelectLandedState(const int32 HookIndex, const FVector& HitNormal, const uint8 Mask)
+{
+	const bool bPull = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Pull)) != 0;
+	const bool bPullable = bPull && IsGrappledObjectTypeIn(HookIndex, PullableObjects);
+	//The pull handle can only be used by one hook at a time
+	if (bPullable && (PullHookIndex == INDEX_NONE || PullHookIndex == HookIndex) && IsGrappledObjectPullable(HookIndex))
+	{
+		return EGrapplingHookState::GS_Pull;
+	}
+	//Tug forces are solved by PhysX, not available to the deterministic simulation
+	if (bPullable && bTugHeavyObjects && !bDeterministic && IsGrappledObjectTuggable(HookIndex))
+	{
+		return EGrapplingHookState::GS_Tug;
+	}
+	const bool bSwingable = IsGrappledObjectTypeIn(HookIndex, SwingableObjects);
+	if ((Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Swing)) != 0)
+	{
+		return bSwingable && IsSurfaceSwingable(HitNormal) ? EGrapplingHookState::GS_Swing : EGrapplingHookState::GS_Missed;
+	}
+	if ((Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Launch)) != 0)
+	{
+		return bSwingable ? EGrapplingHookState::GS_Launch : EGrapplingHookState::GS_Missed;
+	}
+	return EGrapplingHookState::GS_Missed;
+}
+template<uint8 Mask>
+EGrapplingHookState UGrapplingHookComponent::EnterLandedState(const int32 HookIndex, const FVector& HitNormal)
+{
+	//Mask is a constant here, the branches of disabled features are folded away once inlined
+	return SelectLandedState(HookIndex, HitNormal, Mask);
+}
+EGrapplingHookState UGrapplingHookComponent::EnterLandedStateDynamic(const int32 HookIndex, const FVector& HitNormal)
+{
+	return SelectLandedState(HookIndex, HitNormal, Activation);
+}
+template<uint8 Mask>
+void UGrapplingHookComponent::UpdateHooksSpecialized(const float DeltaTime)
+{
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		if (BeginHookUpdate(HookIndex, DeltaTime))
+		{
+			//The state may have changed after an interruption
+			DispatchHookUpdate<Mask>(HookIndex, DeltaTime);
+		}
+	}
+}
+template<uint8 Mask>
+FORCEINLINE void UGrapplingHookComponent::DispatchHookUpdate(const int32 HookIndex, const float DeltaTime)
+{
+	//Mask is a constant here, the branches of disabled features are folded away and their handlers are never called
+	const bool bPull = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Pull)) != 0;
+	const bool bLaunch = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Launch)) != 0;
+	const bool bSwing = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Swing)) != 0;
+	switch (Hooks[HookIndex].CurrentState)
 	{
 	case EGrapplingHookState::GS_Launch:
-		UpdateOwnerLaunch(DeltaTime);
+		if (bLaunch)
+		{
+			UpdateLaunchState(HookIndex, DeltaTime);
+		}
+		else
+		{
+			UpdateInvalidState(HookIndex, DeltaTime);
+		}
 		break;
 	case EGrapplingHookState::GS_Pull:
-		ActivatePull();
-		if (UpdatePulledObject())
+		if (bPull)
+		{
+			UpdatePullState(HookIndex, DeltaTime);
+		}
+		else
+		{
+			UpdateInvalidState(HookIndex, DeltaTime);
+		}
+		break;
+	case EGrapplingHookState::GS_Tug:
+		if (bPull)
+		{
+			UpdateTugState(HookIndex, DeltaTime);
+		}
+		else
 		{
-			StopGrapple();
+			UpdateInvalidState(HookIndex, DeltaTime);
 		}
 		break;
 	case EGrapplingHookState::GS_Swing:
-		if (ActivateSwing())
+		if (bSwing)
 		{
-			UpdateSwing();
+			UpdateSwingState(HookIndex, DeltaTime);
 		}
 		else
 		{
-			StopGrapple();
+			UpdateInvalidState(HookIndex, DeltaTime);
 		}
 		break;
 	case EGrapplingHookState::GS_Retracting:
-		UpdateRetractGrapple(DeltaTime);
+		UpdateRetractState(HookIndex, DeltaTime);
 		break;
 	case EGrapplingHookState::GS_Missed:
-	case EGrapplingHookState::GS_Disabled:
+		UpdateInvalidState(HookIndex, DeltaTime);
+		break;
+	default:
+		break;
+	}
+}
+template<uint8 Mask>
+void UGrapplingHookComponent::ExitHookSpecialized(const int32 HookIndex)
+{
+	//Hooks of disabled features never reach this handler, they are interrupted by RefreshStateTable when the mask changes
+	const bool bPull = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Pull)) != 0;
+	const bool bSwing = (Mask & static_cast<uint8>(EGrapplingHookActivation::GA_Swing)) != 0;
+	switch (Hooks[HookIndex].CurrentState)
+	{
+	case EGrapplingHookState::GS_Pull:
+		if (bPull)
+		{
+			InterruptPull(HookIndex);
+		}
+		break;
+	case EGrapplingHookState::GS_Tug:
+		if (bPull)
+		{
+			InterruptTug(HookIndex);
+		}
+		break;
+	case EGrapplingHookState::GS_Swing:
+		if (bSwing)
+		{
+			InterruptSwing(HookIndex);
+		}
+		break;
 	case EGrapplingHookState::GS_Extending:
-	case EGrapplingHookState::GS_Ready:
+		ExitExtendingState(HookIndex);
+		break;
+	default:
+		break;
+	}
+}
+template<uint8 Mask>
+const FGrapplingHookStateTable& UGrapplingHookComponent::GetSpecializedStateTable()
+{
+	struct FSpecializedStateTable : public FGrapplingHookStateTable
+	{
+		FSpecializedStateTable()
+		{
+			//Update and Exit stay filled as data (updated and interruptible states), the handlers are only called by the non specialized tables
+			BuildStateTable(Mask, *this);
+			UpdateHooks = &UGrapplingHookComponent::UpdateHooksSpecialized<Mask>;
+			ExitHook = &UGrapplingHookComponent::ExitHookSpecialized<Mask>;
+			Enter = &UGrapplingHookComponent::EnterLandedState<Mask>;
+			bSpecialized = true;
+		}
+	};
+	static const FSpecializedStateTable Table;
+	return Table;
+}
+const FGrapplingHookStateTable& UGrapplingHookComponent::FindStateTable(const uint8 Mask)
+{
+	switch (Mask)
+	{
+	case GrapplingHookMaskAll:
+		return GetSpecializedStateTable<GrapplingHookMaskAll>();
+	case GrapplingHookMaskLaunchOnly:
+		return GetSpecializedStateTable<GrapplingHookMaskLaunchOnly>();
+	case GrapplingHookMaskSwingRetractCooldown:
+		return GetSpecializedStateTable<GrapplingHookMaskSwingRetractCooldown>();
 	default:
-		StopGrapple();
 		break;
 	}
+
+	//Other masks share lazily built tables (game thread only)
+	static FGrapplingHookStateTable DynamicTables[256];
+	FGrapplingHookStateTable& Table = DynamicTables[Mask];
+	if (!Table.Enter)
+	{
+		BuildStateTable(Mask, Table);
+		Table.Enter = &UGrapplingHookComponent::EnterLandedStateDynamic;
+	}
+	return Table;
+}
+void UGrapplingHookComponent::UpdateLaunchState(const int32 HookIndex, const float DeltaTime)
+{
+	//Combined with the other launching hooks after the hooks update
+}
+void UGrapplingHookComponent::UpdatePullState(const int32 HookIndex, const float DeltaTime)
+{
+	ActivatePull(HookIndex);
+	if (UpdatePulledObject(HookIndex, DeltaTime))
+	{
+		StopGrappleAt(HookIndex);
+	}
+}
+void UGrapplingHookComponent::UpdateTugState(const int32 HookIndex, const float DeltaTime)
+{
+	if (UpdateTug(HookIndex, DeltaTime))
+	{
+		StopGrappleAt(HookIndex);
+	}
+}
+void UGrapplingHookComponent::UpdateSwingState(const int32 HookIndex, const float DeltaTime)
+{
+	//Rope forces are solved together with the other swinging hooks after the hooks update
+	if (!ActivateSwing(HookIndex))
+	{
+		StopGrappleAt(HookIndex);
+	}
+}
+void UGrapplingHookComponent::UpdateRetractState(const int32 HookIndex, const float DeltaTime)
+{
+	UpdateRetractGrapple(HookIndex, DeltaTime);
+}
+void UGrapplingHookComponent::UpdateInvalidState(const int32 HookIndex, const float DeltaTime)
+{
+	StopGrappleAt(HookIndex);
+}
+void UGrapplingHookComponent::ExitExtendingState(const int32 HookIndex)
+{
+	HookLanded(FVector::ZeroVector, nullptr, HookIndex);
 }
 void UGrapplingHookComponent::OnCheckGrounded()
 {
-	if (CurrentState == EGrapplingHookState::GS_Swing || CurrentState == EGrapplingHookState::GS_Launch)
+	if (IsAnyHookInState(EGrapplingHookState::GS_Swing) || IsAnyHookInState(EGrapplingHookState::GS_Launch))
 	{
 		if (Owner)
 		{
@@ -1008,9 +4449,93 @@ void UGrapplingHookComponent::OnCheckGrounded()
 			{
 				if (MoveComponent->IsMovingOnGround())
 				{
-					StopGrapple();
+					InterruptLaunchAndSwing();
 				}
 			}
 		}
 	}
 }
+void UGrapplingHookComponent::OnGroundedCheckDelayEnd()
+{
+	GroundCheckTimerHandle.Invalidate();
+	if (bGroundedInterruptArmed)
+	{
+		OnCheckGrounded();
+	}
+}
+void UGrapplingHookComponent::OnGroundedGracePeriodEnd()
+{
+	GroundedGraceTimerHandle.Invalidate();
+	bGroundedInterruptArmed = true;
+	//Landing events during the grace period were ignored, unless the grounded check is still pending a single check covers an owner that is already grounded
+	if (!GroundCheckTimerHandle.IsValid())
+	{
+		OnCheckGrounded();
+	}
+}
+void UGrapplingHookComponent::InterruptOnGrounded()
+{
+	if (bGroundedInterruptArmed)
+	{
+		InterruptLaunchAndSwing();
+	}
+}
+void UGrapplingHookComponent::InterruptLaunchAndSwing()
+{
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); ++HookIndex)
+	{
+		if (Hooks[HookIndex].CurrentState == EGrapplingHookState::GS_Swing || Hooks[HookIndex].CurrentState == EGrapplingHookState::GS_Launch)
+		{
+			StopGrappleAt(HookIndex);
+		}
+	}
+}
+void UGrapplingHookComponent::BindOwnerEvents()
+{
+	if (!Owner)
+	{
+		return;
+	}
+	BoundOwner = Owner;
+
+	FScriptDelegate LandedDelegate;
+	LandedDelegate.BindUFunction(this, TEXT("OnOwnerLanded"));
+	BoundOwner->LandedDelegate.AddUnique(LandedDelegate);
+
+	FScriptDelegate MovementModeDelegate;
+	MovementModeDelegate.BindUFunction(this, TEXT("OnOwnerMovementModeChanged"));
+	BoundOwner->MovementModeChangedDelegate.AddUnique(MovementModeDelegate);
+}
+void UGrapplingHookComponent::UnbindOwnerEvents()
+{
+	if (!BoundOwner)
+	{
+		return;
+	}
+
+	FScriptDelegate LandedDelegate;
+	LandedDelegate.BindUFunction(this, TEXT("OnOwnerLanded"));
+	BoundOwner->LandedDelegate.Remove(LandedDelegate);
+
+	FScriptDelegate MovementModeDelegate;
+	MovementModeDelegate.BindUFunction(this, TEXT("OnOwnerMovementModeChanged"));
+	BoundOwner->MovementModeChangedDelegate.Remove(MovementModeDelegate);
+
+	BoundOwner = nullptr;
+}
+void UGrapplingHookComponent::OnOwnerLanded(const FHitResult& Hit)
+{
+	//Landed is broadcasted before the movement mode is switched to a grounded one, the event itself means the owner is grounded
+	InterruptOnGrounded();
+}
+void UGrapplingHookComponent::OnOwnerMovementModeChanged(ACharacter* Character, EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
+{
+	if (Character)
+	{
+		const UCharacterMovementComponent* const MoveComponent = Character->GetCharacterMovement();
+		if (MoveComponent && MoveComponent->IsMovingOnGround())
+		{
+			InterruptOnGrounded();
+		}
+	}
+}
@@ -0,0 +1,99 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookComponentCache.h"
+#include "GameFramework/Actor.h"
+#include "Components/AudioComponent.h"
+#include "PhysicsEngine/PhysicsHandleComponent.h"
+#include "PhysicsEngine/PhysicsConstraintComponent.h"
+#include "../Plugins/Runtime/CableComponent/Source/CableComponent/Classes/CableComponent.h"
+
+FGrapplingHookOwnerComponents::FGrapplingHookOwnerComponents()
+{
+	Audio = nullptr;
+	Handle = nullptr;
+	Constraint = nullptr;
+}
+
+void FGrapplingHookComponentCache::Resolve(const AActor* const Owner, const FName GrapplerName, FGrapplingHookOwnerComponents& OutComponents)
+{
+	OutComponents = FGrapplingHookOwnerComponents();
+	if (!Owner)
+	{
+		return;
+	}
+	const TSet<UActorComponent*>& Components = Owner->GetComponents();
+	FLayout& Layout = Layouts.FindOrAdd(TPair<const UClass*, FName>(Owner->GetClass(), GrapplerName));
+	if (Layout.NumComponents == Components.Num() && ResolveLayout(Layout, Components, OutComponents))
+	{
+		return;
+	}
+	OutComponents = FGrapplingHookOwnerComponents();
+	BuildLayout(Components, Layout, OutComponents);
+}
+void FGrapplingHookComponentCache::Reset()
+{
+	Layouts.Empty();
+}
+UActorComponent* FGrapplingHookComponentCache::GetSlotComponent(const FSlot& Slot, const TSet<UActorComponent*>& Components, const UClass* const Class, bool& bOutValid)
+{
+	if (Slot.Index == INDEX_NONE)
+	{
+		return nullptr;
+	}
+	const FSetElementId Id = FSetElementId::FromInteger(Slot.Index);
+	UActorComponent* const Component = Components.IsValidId(Id) ? Components[Id] : nullptr;
+	if (!Component || Component->GetFName() != Slot.Name || !Component->IsA(Class))
+	{
+		bOutValid = false;
+		return nullptr;
+	}
+	return Component;
+}
+bool FGrapplingHookComponentCache::ResolveLayout(const FLayout& Layout, const TSet<UActorComponent*>& Components, FGrapplingHookOwnerComponents& OutComponents)
+{
+	bool bValid = true;
+	OutComponents.Cables.Reserve(Layout.Cables.Num());
+	for (const FSlot& Slot : Layout.Cables)
+	{
+		OutComponents.Cables.Add(static_cast<UCableComponent*>(GetSlotComponent(Slot, Components, UCableComponent::StaticClass(), bValid)));
+	}
+	OutComponents.Audio = static_cast<UAudioComponent*>(GetSlotComponent(Layout.Audio, Components, UAudioComponent::StaticClass(), bValid));
+	OutComponents.Handle = static_cast<UPhysicsHandleComponent*>(GetSlotComponent(Layout.Handle, Components, UPhysicsHandleComponent::StaticClass(), bValid));
+	OutComponents.Constraint = static_cast<UPhysicsConstraintComponent*>(GetSlotComponent(Layout.Constraint, Components, UPhysicsConstraintComponent::StaticClass(), bValid));
+	return bValid;
+}
+void FGrapplingHookComponentCache::BuildLayout(const TSet<UActorComponent*>& Components, FLayout& OutLayout, FGrapplingHookOwnerComponents& OutComponents)
+{
+	OutLayout = FLayout();
+	OutLayout.NumComponents = Components.Num();
+	//Same order as AActor::GetComponents and AActor::GetComponentByClass
+	for (TSet<UActorComponent*>::TConstIterator It(Components); It; ++It)
+	{
+		UActorComponent* const Component = *It;
+		if (!Component)
+		{
+			continue;
+		}
+		const FSlot Slot(It.GetId().AsInteger(), Component->GetFName());
+		if (UCableComponent* const Cable = Cast<UCableComponent>(Component))
+		{
+			OutLayout.Cables.Add(Slot);
+			OutComponents.Cables.Add(Cable);
+		}
+		if (!OutComponents.Audio && Component->IsA(UAudioComponent::StaticClass()))
+		{
+			OutLayout.Audio = Slot;
+			OutComponents.Audio = static_cast<UAudioComponent*>(Component);
+		}
+		if (!OutComponents.Handle && Component->IsA(UPhysicsHandleComponent::StaticClass()))
+		{
+			OutLayout.Handle = Slot;
+			OutComponents.Handle = static_cast<UPhysicsHandleComponent*>(Component);
+		}
+		if (!OutComponents.Constraint && Component->IsA(UPhysicsConstraintComponent::StaticClass()))
+		{
+			OutLayout.Constraint = Slot;
+			OutComponents.Constraint = static_cast<UPhysicsConstraintComponent*>(Component);
+		}
+	}
+}
@@ -0,0 +1,31 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookEasing.h"
+#include "Curves/CurveFloat.h"
+
+FGrapplingHookEasingTable::FGrapplingHookEasingTable()
+{
+	Bake(nullptr);
+}
+void FGrapplingHookEasingTable::Bake(const UCurveFloat* const Curve)
+{
+	BakedCurve = Curve;
+	bLinear = Curve == nullptr;
+
+	float MinTime = 0.f;
+	float MaxTime = 1.f;
+	if (Curve)
+	{
+		Curve->GetTimeRange(MinTime, MaxTime);
+	}
+	for (int32 Sample = 0; Sample <= NumSamples; ++Sample)
+	{
+		const float Alpha = static_cast<float>(Sample) / NumSamples;
+		Samples[Sample] = Curve ? Curve->GetFloatValue(FMath::Lerp(MinTime, MaxTime, Alpha)) : Alpha;
+		FixedSamples[Sample] = static_cast<int32>(static_cast<double>(Samples[Sample]) * FGrapplingHookRetractClock::One);
+	}
+}
+const UCurveFloat* FGrapplingHookEasingTable::GetBakedCurve() const
+{
+	return BakedCurve;
+}
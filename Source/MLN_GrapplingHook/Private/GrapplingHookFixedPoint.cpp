@@ -0,0 +1,79 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookFixedPoint.h"
+
+/* Integer square root (floor)
+*/
+static uint64 GrapplingHookIntegerSqrt(uint64 Value)
+{
+	uint64 Result = 0;
+	uint64 Bit = uint64(1) << 62;
+	while (Bit > Value)
+	{
+		Bit >>= 2;
+	}
+	while (Bit != 0)
+	{
+		if (Value >= Result + Bit)
+		{
+			Value -= Result + Bit;
+			Result = (Result >> 1) + Bit;
+		}
+		else
+		{
+			Result >>= 1;
+		}
+		Bit >>= 2;
+	}
+	return Result;
+}
+
+FGrapplingHookFixed FGrapplingHookFixed::Sqrt(const FGrapplingHookFixed Value)
+{
+	if (Value.Raw <= 0)
+	{
+		return FGrapplingHookFixed();
+	}
+	//sqrt(Raw / One) * One == sqrt(Raw * One), values too big to be scaled first lose the lowest fractional bits
+	const uint64 Raw = static_cast<uint64>(Value.Raw);
+	if (Raw < (uint64(1) << (62 - FracBits)))
+	{
+		return FromRaw(static_cast<int64>(GrapplingHookIntegerSqrt(Raw << FracBits)));
+	}
+	return FromRaw(static_cast<int64>(GrapplingHookIntegerSqrt(Raw) << (FracBits / 2)));
+}
+FGrapplingHookFixed FGrapplingHookFixed::CosDegrees(const FGrapplingHookFixed Degrees)
+{
+	static const int64 PiRaw = 205887;
+	static const int64 HalfTurn = 180 * OneRaw;
+	static const int64 FullTurn = 360 * OneRaw;
+
+	//Reduced to [0, 90] degrees: the cosine is even, periodic and cos(180 - x) = -cos(x)
+	int64 Angle = Degrees.Raw % FullTurn;
+	if (Angle < 0)
+	{
+		Angle += FullTurn;
+	}
+	if (Angle > HalfTurn)
+	{
+		Angle = FullTurn - Angle;
+	}
+	bool bNegate = false;
+	if (Angle > HalfTurn / 2)
+	{
+		Angle = HalfTurn - Angle;
+		bNegate = true;
+	}
+
+	//Taylor series up to x^10, its truncation error is below the fixed point resolution in [0, pi / 2]
+	const int64 Radians = (Angle * PiRaw) / HalfTurn;
+	const int64 RadiansSquared = MulRaw(Radians, Radians);
+	int64 Term = OneRaw;
+	int64 Sum = OneRaw;
+	for (int64 Order = 2; Order <= 10; Order += 2)
+	{
+		Term = -MulRaw(Term, RadiansSquared) / ((Order - 1) * Order);
+		Sum += Term;
+	}
+	return FromRaw(bNegate ? -Sum : Sum);
+}
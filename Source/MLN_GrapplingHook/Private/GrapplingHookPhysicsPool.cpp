@@ -0,0 +1,158 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookPhysicsPool.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "PhysicsEngine/PhysicsHandleComponent.h"
+#include "PhysicsEngine/PhysicsConstraintComponent.h"
+
+static TAutoConsoleVariable<int32> CVarGrapplingHookPhysicsPoolPrewarm(
+	TEXT("GrapplingHook.PhysicsPool.Prewarm"),
+	4,
+	TEXT("Number of swing constraints and pull handles created in advance by the grappling hook physics pool of a world (expected number of concurrent grapples)"));
+
+FGrapplingHookPhysicsPoolStats::FGrapplingHookPhysicsPoolStats()
+{
+	ActiveConstraints = 0;
+	FreeConstraints = 0;
+	PeakConstraints = 0;
+	ActiveHandles = 0;
+	FreeHandles = 0;
+	PeakHandles = 0;
+}
+
+FGrapplingHookPhysicsPool::FGrapplingHookPhysicsPool(UWorld* const InWorld)
+{
+	World = InWorld;
+}
+AActor* FGrapplingHookPhysicsPool::GetPoolActor()
+{
+	if (PoolActor.IsValid())
+	{
+		return PoolActor.Get();
+	}
+	if (!World || World->bIsTearingDown)
+	{
+		return nullptr;
+	}
+	Constraints.Free.Reset();
+	Handles.Free.Reset();
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = MakeUniqueObjectName(World->PersistentLevel, AActor::StaticClass(), TEXT("GrapplingHookPhysicsPool"));
+	SpawnParams.ObjectFlags |= RF_Transient;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	PoolActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	return PoolActor.Get();
+}
+template<typename ComponentType>
+ComponentType* FGrapplingHookPhysicsPool::CreateComponent()
+{
+	AActor* const Actor = GetPoolActor();
+	if (!Actor)
+	{
+		return nullptr;
+	}
+	ComponentType* const Component = NewObject<ComponentType>(Actor, NAME_None, RF_Transient);
+	Component->RegisterComponent();
+	return Component;
+}
+template<typename ComponentType>
+ComponentType* FGrapplingHookPhysicsPool::Lease(TEntries<ComponentType>& Entries)
+{
+	//Free components are destroyed along with the pool actor
+	if (!PoolActor.IsValid())
+	{
+		Entries.Free.Reset();
+	}
+	ComponentType* const Component = Entries.Free.Num() > 0 ? Entries.Free.Pop(false) : CreateComponent<ComponentType>();
+	if (Component)
+	{
+		++Entries.Active;
+		Entries.Peak = FMath::Max(Entries.Peak, Entries.Active);
+	}
+	return Component;
+}
+template<typename ComponentType>
+void FGrapplingHookPhysicsPool::Return(TEntries<ComponentType>& Entries, ComponentType* const Component)
+{
+	if (!Component)
+	{
+		return;
+	}
+	Entries.Active = FMath::Max(Entries.Active - 1, 0);
+	if (PoolActor.IsValid() && Component->GetOwner() == PoolActor.Get() && !Component->IsPendingKill())
+	{
+		Entries.Free.Add(Component);
+	}
+}
+void FGrapplingHookPhysicsPool::Prewarm(const int32 NumConstraints, const int32 NumHandles)
+{
+	while (Constraints.Free.Num() + Constraints.Active < NumConstraints)
+	{
+		UPhysicsConstraintComponent* const Constraint = CreateComponent<UPhysicsConstraintComponent>();
+		if (!Constraint)
+		{
+			return;
+		}
+		Constraints.Free.Add(Constraint);
+	}
+	while (Handles.Free.Num() + Handles.Active < NumHandles)
+	{
+		UPhysicsHandleComponent* const Handle = CreateComponent<UPhysicsHandleComponent>();
+		if (!Handle)
+		{
+			return;
+		}
+		//Free handles do not need to tick
+		Handle->SetComponentTickEnabled(false);
+		Handles.Free.Add(Handle);
+	}
+}
+void FGrapplingHookPhysicsPool::Prewarm()
+{
+	const int32 Count = FMath::Max(CVarGrapplingHookPhysicsPoolPrewarm.GetValueOnGameThread(), 0);
+	Prewarm(Count, Count);
+}
+UPhysicsConstraintComponent* FGrapplingHookPhysicsPool::LeaseConstraint()
+{
+	return Lease(Constraints);
+}
+void FGrapplingHookPhysicsPool::ReturnConstraint(UPhysicsConstraintComponent* const Constraint)
+{
+	if (Constraint && !Constraint->IsPendingKill())
+	{
+		Constraint->SetConstrainedComponents(nullptr, NAME_None, nullptr, NAME_None);
+	}
+	Return(Constraints, Constraint);
+}
+UPhysicsHandleComponent* FGrapplingHookPhysicsPool::LeaseHandle()
+{
+	UPhysicsHandleComponent* const Handle = Lease(Handles);
+	if (Handle)
+	{
+		Handle->SetComponentTickEnabled(true);
+	}
+	return Handle;
+}
+void FGrapplingHookPhysicsPool::ReturnHandle(UPhysicsHandleComponent* const Handle)
+{
+	if (Handle && !Handle->IsPendingKill())
+	{
+		Handle->ReleaseComponent();
+		Handle->SetComponentTickEnabled(false);
+	}
+	Return(Handles, Handle);
+}
+FGrapplingHookPhysicsPoolStats FGrapplingHookPhysicsPool::GetStats() const
+{
+	FGrapplingHookPhysicsPoolStats Stats;
+	Stats.ActiveConstraints = Constraints.Active;
+	Stats.FreeConstraints = Constraints.Free.Num();
+	Stats.PeakConstraints = Constraints.Peak;
+	Stats.ActiveHandles = Handles.Active;
+	Stats.FreeHandles = Handles.Free.Num();
+	Stats.PeakHandles = Handles.Peak;
+	return Stats;
+}
@@ -0,0 +1,126 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookSnapshot.h"
+#include "GrapplingHookComponent.h"
+#include "Components/SceneComponent.h"
+
+FGrapplingHookSnapshot::FGrapplingHookSnapshot()
+	: Location(FVector::ZeroVector)
+	, RetractStartLocation(FVector::ZeroVector)
+	, RetractClock(0)
+	, RetractClockRate(0.f)
+	, RopeLength(0.f)
+	, CooldownRemaining(0.f)
+	, State(static_cast<uint8>(EGrapplingHookState::GS_Ready))
+	, PreRetractingState(static_cast<uint8>(EGrapplingHookState::GS_Ready))
+	, Flags(0)
+{
+	Direction[0] = MAX_int16;
+	Direction[1] = 0;
+	Direction[2] = 0;
+}
+void FGrapplingHookSnapshot::SetDirection(const FVector& InDirection)
+{
+	Direction[0] = static_cast<int16>(FMath::RoundToInt(FMath::Clamp(InDirection.X, -1.f, 1.f) * MAX_int16));
+	Direction[1] = static_cast<int16>(FMath::RoundToInt(FMath::Clamp(InDirection.Y, -1.f, 1.f) * MAX_int16));
+	Direction[2] = static_cast<int16>(FMath::RoundToInt(FMath::Clamp(InDirection.Z, -1.f, 1.f) * MAX_int16));
+}
+FVector FGrapplingHookSnapshot::GetDirection() const
+{
+	const FVector Quantized(Direction[0], Direction[1], Direction[2]);
+	return Quantized.GetSafeNormal(SMALL_NUMBER, FVector::ForwardVector);
+}
+FArchive& operator<<(FArchive& Ar, FGrapplingHookSnapshot& Snapshot)
+{
+	//The anchor is serialized as an object reference, save game archives store it by path
+	UObject* AnchorObject = Snapshot.Anchor.Get();
+	Ar << AnchorObject;
+	if (Ar.IsLoading())
+	{
+		Snapshot.Anchor = Cast<USceneComponent>(AnchorObject);
+	}
+	Ar << Snapshot.Location;
+	Ar << Snapshot.RetractStartLocation;
+	Ar << Snapshot.RetractClock;
+	Ar << Snapshot.RetractClockRate;
+	Ar << Snapshot.RopeLength;
+	Ar << Snapshot.CooldownRemaining;
+	Ar << Snapshot.Direction[0];
+	Ar << Snapshot.Direction[1];
+	Ar << Snapshot.Direction[2];
+	Ar << Snapshot.State;
+	Ar << Snapshot.PreRetractingState;
+	Ar << Snapshot.Flags;
+	return Ar;
+}
+
+FGrapplingHookSnapshotRing::FGrapplingHookSnapshotRing()
+	: NumFrames(0)
+	, HooksPerFrame(0)
+	, Head(0)
+	, Count(0)
+{
+}
+void FGrapplingHookSnapshotRing::Init(const int32 InNumFrames, const int32 InHooksPerFrame)
+{
+	NumFrames = FMath::Max(InNumFrames, 0);
+	HooksPerFrame = FMath::Max(InHooksPerFrame, 0);
+	Snapshots.Reset();
+	Snapshots.SetNum(NumFrames * HooksPerFrame);
+	FrameHooks.Reset();
+	FrameHooks.SetNumZeroed(NumFrames);
+	Reset();
+}
+void FGrapplingHookSnapshotRing::Reset()
+{
+	Head = 0;
+	Count = 0;
+}
+void FGrapplingHookSnapshotRing::Capture(const UGrapplingHookComponent& Component)
+{
+	if (NumFrames == 0)
+	{
+		return;
+	}
+	FGrapplingHookSnapshot* const Frame = Snapshots.GetData() + Head * HooksPerFrame;
+	FrameHooks[Head] = Component.CaptureSnapshot(Frame, HooksPerFrame);
+	Head = (Head + 1) % NumFrames;
+	Count = FMath::Min(Count + 1, NumFrames);
+}
+bool FGrapplingHookSnapshotRing::Restore(UGrapplingHookComponent& Component, const int32 FramesAgo) const
+{
+	int32 NumHooks = 0;
+	const FGrapplingHookSnapshot* const Frame = GetFrame(FramesAgo, NumHooks);
+	return Frame && Component.RestoreSnapshot(Frame, NumHooks);
+}
+bool FGrapplingHookSnapshotRing::Rewind(UGrapplingHookComponent& Component, const int32 FramesAgo)
+{
+	if (FramesAgo < 0 || FramesAgo >= Count)
+	{
+		return false;
+	}
+	const bool bRestored = Restore(Component, FramesAgo);
+	//The restored frame becomes the latest one
+	Head = (Head - FramesAgo + NumFrames) % NumFrames;
+	Count -= FramesAgo;
+	return bRestored;
+}
+int32 FGrapplingHookSnapshotRing::Num() const
+{
+	return Count;
+}
+const FGrapplingHookSnapshot* FGrapplingHookSnapshotRing::GetFrame(const int32 FramesAgo, int32& OutNumHooks) const
+{
+	if (FramesAgo < 0 || FramesAgo >= Count)
+	{
+		OutNumHooks = 0;
+		return nullptr;
+	}
+	const int32 FrameIndex = GetFrameIndex(FramesAgo);
+	OutNumHooks = FrameHooks[FrameIndex];
+	return Snapshots.GetData() + FrameIndex * HooksPerFrame;
+}
+int32 FGrapplingHookSnapshotRing::GetFrameIndex(const int32 FramesAgo) const
+{
+	return (Head - 1 - FramesAgo + 2 * NumFrames) % NumFrames;
+}
@@ -0,0 +1,339 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookTelemetry.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Misc/DateTime.h"
+#include "Containers/Ticker.h"
+#include "Async/Async.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/Class.h"
+
+static int32 GGrapplingHookTelemetry = 0;
+static FAutoConsoleVariableRef CVarGrapplingHookTelemetry(
+	TEXT("GrapplingHook.Telemetry"),
+	GGrapplingHookTelemetry,
+	TEXT("If not 0 grappling hook events (state times, misses, breaks, errors, launch distances, cooldowns) are recorded and periodically written to Saved/GrapplingHook/"));
+
+static float GGrapplingHookTelemetryFlushInterval = 60.f;
+static FAutoConsoleVariableRef CVarGrapplingHookTelemetryFlushInterval(
+	TEXT("GrapplingHook.Telemetry.FlushInterval"),
+	GGrapplingHookTelemetryFlushInterval,
+	TEXT("Seconds between two writes of the grappling hook telemetry files (values below 1 disable the periodic writes)"));
+
+static int32 GGrapplingHookTelemetryFormat = 0;
+static FAutoConsoleVariableRef CVarGrapplingHookTelemetryFormat(
+	TEXT("GrapplingHook.Telemetry.Format"),
+	GGrapplingHookTelemetryFormat,
+	TEXT("Format of the grappling hook telemetry files: 0 JSON, 1 CSV, 2 both"));
+
+static FAutoConsoleCommand GrapplingHookTelemetryFlushCommand(
+	TEXT("GrapplingHook.Telemetry.Flush"),
+	TEXT("Writes the grappling hook telemetry files now"),
+	FConsoleCommandDelegate::CreateStatic(&FGrapplingHookTelemetry::Flush));
+
+/* Per thread counters storage (invalid sentinel while not allocated, 0 is a valid slot index)
+*/
+static const uint32 GrapplingHookTelemetryInvalidTlsSlot = 0xFFFFFFFF;
+static uint32 GrapplingHookTelemetryTlsSlot = GrapplingHookTelemetryInvalidTlsSlot;
+static TArray<FGrapplingHookTelemetryCounters*> GrapplingHookTelemetryBlocks;
+static FCriticalSection GrapplingHookTelemetryBlocksLock;
+static FDelegateHandle GrapplingHookTelemetryTickerHandle;
+static FDelegateHandle GrapplingHookTelemetryPreExitHandle;
+static float GrapplingHookTelemetryTimeSinceFlush = 0.f;
+static FString GrapplingHookTelemetrySession;
+/* Last write started on a background thread
+*/
+static TFuture<void> GrapplingHookTelemetryPendingWrite;
+/* Names of the state and error values, resolved on the game thread by the first flush
+*/
+static TArray<FString> GrapplingHookTelemetryStateNames;
+static TArray<FString> GrapplingHookTelemetryErrorNames;
+
+static const int32 GrapplingHookTelemetryNumValues = sizeof(FGrapplingHookTelemetryCounters) / sizeof(int64);
+static_assert(sizeof(FGrapplingHookTelemetryCounters) % sizeof(int64) == 0, "FGrapplingHookTelemetryCounters must only contain int64 values");
+
+void FGrapplingHookTelemetry::Startup()
+{
+	if (FPlatformTLS::IsValidTlsSlot(GrapplingHookTelemetryTlsSlot))
+	{
+		return;
+	}
+	GrapplingHookTelemetryTlsSlot = FPlatformTLS::AllocTlsSlot();
+	GrapplingHookTelemetrySession = FDateTime::Now().ToString();
+	GrapplingHookTelemetryTimeSinceFlush = 0.f;
+	GrapplingHookTelemetryTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&FGrapplingHookTelemetry::OnFlushTicker), 1.f);
+	GrapplingHookTelemetryPreExitHandle = FCoreDelegates::OnPreExit.AddStatic(&FGrapplingHookTelemetry::OnPreExit);
+}
+void FGrapplingHookTelemetry::Shutdown()
+{
+	if (!FPlatformTLS::IsValidTlsSlot(GrapplingHookTelemetryTlsSlot))
+	{
+		return;
+	}
+	FTicker::GetCoreTicker().RemoveTicker(GrapplingHookTelemetryTickerHandle);
+	FCoreDelegates::OnPreExit.Remove(GrapplingHookTelemetryPreExitHandle);
+	//The last flush was started on engine pre exit, only its completion is awaited here
+	if (GrapplingHookTelemetryPendingWrite.IsValid())
+	{
+		GrapplingHookTelemetryPendingWrite.Wait();
+		GrapplingHookTelemetryPendingWrite = TFuture<void>();
+	}
+
+	FScopeLock Lock(&GrapplingHookTelemetryBlocksLock);
+	for (FGrapplingHookTelemetryCounters* const Block : GrapplingHookTelemetryBlocks)
+	{
+		delete Block;
+	}
+	GrapplingHookTelemetryBlocks.Empty();
+	FPlatformTLS::FreeTlsSlot(GrapplingHookTelemetryTlsSlot);
+	GrapplingHookTelemetryTlsSlot = GrapplingHookTelemetryInvalidTlsSlot;
+}
+bool FGrapplingHookTelemetry::IsEnabled()
+{
+	return GGrapplingHookTelemetry != 0;
+}
+FGrapplingHookTelemetryCounters* FGrapplingHookTelemetry::GetThreadCounters()
+{
+	if (!FPlatformTLS::IsValidTlsSlot(GrapplingHookTelemetryTlsSlot))
+	{
+		return nullptr;
+	}
+	FGrapplingHookTelemetryCounters* Block = static_cast<FGrapplingHookTelemetryCounters*>(FPlatformTLS::GetTlsValue(GrapplingHookTelemetryTlsSlot));
+	if (!Block)
+	{
+		//Once per thread, the only locked path of the recording
+		Block = new FGrapplingHookTelemetryCounters();
+		FMemory::Memzero(Block, sizeof(FGrapplingHookTelemetryCounters));
+		FPlatformTLS::SetTlsValue(GrapplingHookTelemetryTlsSlot, Block);
+		FScopeLock Lock(&GrapplingHookTelemetryBlocksLock);
+		GrapplingHookTelemetryBlocks.Add(Block);
+	}
+	return Block;
+}
+void FGrapplingHookTelemetry::RecordValue(FGrapplingHookTelemetryHistogram& Histogram, const uint32 Value)
+{
+	//Only the owning thread writes its counters: plain increments, gathering reads whole aligned 64 bit values and an event recorded meanwhile is in the next flush
+	++Histogram.Buckets[FGrapplingHookTelemetryHistogram::GetBucket(Value)];
+	++Histogram.Count;
+	Histogram.Sum += Value;
+}
+void FGrapplingHookTelemetry::RecordStateExit(const EGrapplingHookState State, const double Seconds)
+{
+	FGrapplingHookTelemetryCounters* const Counters = IsEnabled() ? GetThreadCounters() : nullptr;
+	if (Counters)
+	{
+		RecordValue(Counters->StateTime[static_cast<int32>(State)], static_cast<uint32>(FMath::Clamp(Seconds * 1000.0, 0.0, static_cast<double>(MAX_uint32))));
+	}
+}
+void FGrapplingHookTelemetry::RecordStateEnter(const EGrapplingHookState State)
+{
+	FGrapplingHookTelemetryCounters* const Counters = IsEnabled() ? GetThreadCounters() : nullptr;
+	if (Counters)
+	{
+		++Counters->StateEnters[static_cast<int32>(State)];
+		if (State == EGrapplingHookState::GS_Missed)
+		{
+			++Counters->Misses;
+		}
+	}
+}
+void FGrapplingHookTelemetry::RecordError(const EGrapplingHookError Error)
+{
+	FGrapplingHookTelemetryCounters* const Counters = IsEnabled() ? GetThreadCounters() : nullptr;
+	if (Counters && Error < EGrapplingHookError::GE_MAX)
+	{
+		++Counters->Errors[static_cast<int32>(Error)];
+	}
+}
+void FGrapplingHookTelemetry::RecordLaunch()
+{
+	FGrapplingHookTelemetryCounters* const Counters = IsEnabled() ? GetThreadCounters() : nullptr;
+	if (Counters)
+	{
+		++Counters->Launches;
+	}
+}
+void FGrapplingHookTelemetry::RecordBreak()
+{
+	FGrapplingHookTelemetryCounters* const Counters = IsEnabled() ? GetThreadCounters() : nullptr;
+	if (Counters)
+	{
+		++Counters->Breaks;
+	}
+}
+void FGrapplingHookTelemetry::RecordLaunchDistance(const float Distance)
+{
+	FGrapplingHookTelemetryCounters* const Counters = IsEnabled() ? GetThreadCounters() : nullptr;
+	if (Counters)
+	{
+		RecordValue(Counters->LaunchDistance, static_cast<uint32>(FMath::Clamp(Distance, 0.f, static_cast<float>(MAX_int32))));
+	}
+}
+void FGrapplingHookTelemetry::RecordCooldown(const float Seconds)
+{
+	FGrapplingHookTelemetryCounters* const Counters = IsEnabled() ? GetThreadCounters() : nullptr;
+	if (Counters)
+	{
+		RecordValue(Counters->CooldownWait, static_cast<uint32>(FMath::Clamp(Seconds * 1000.f, 0.f, static_cast<float>(MAX_int32))));
+	}
+}
+void FGrapplingHookTelemetry::RecordLaunchLatency(const double Seconds, const int32 Frames)
+{
+	FGrapplingHookTelemetryCounters* const Counters = IsEnabled() ? GetThreadCounters() : nullptr;
+	if (Counters)
+	{
+		RecordValue(Counters->LaunchLatency, static_cast<uint32>(FMath::Clamp(Seconds * 1000.0, 0.0, static_cast<double>(MAX_int32))));
+		RecordValue(Counters->LaunchLatencyFrames, static_cast<uint32>(FMath::Max(Frames, 0)));
+	}
+}
+void FGrapplingHookTelemetry::Gather(FGrapplingHookTelemetryCounters& OutCounters)
+{
+	FMemory::Memzero(&OutCounters, sizeof(FGrapplingHookTelemetryCounters));
+	int64* const Target = reinterpret_cast<int64*>(&OutCounters);
+	FScopeLock Lock(&GrapplingHookTelemetryBlocksLock);
+	for (FGrapplingHookTelemetryCounters* const Block : GrapplingHookTelemetryBlocks)
+	{
+		int64* const Source = reinterpret_cast<int64*>(Block);
+		for (int32 Index = 0; Index < GrapplingHookTelemetryNumValues; ++Index)
+		{
+			Target[Index] += FPlatformAtomics::AtomicRead(&Source[Index]);
+		}
+	}
+}
+void FGrapplingHookTelemetry::Flush()
+{
+	if (!FPlatformTLS::IsValidTlsSlot(GrapplingHookTelemetryTlsSlot))
+	{
+		return;
+	}
+	//Enum objects are looked up once, on the game thread
+	if (GrapplingHookTelemetryStateNames.Num() == 0)
+	{
+		const UEnum* const StateEnum = FindObject<UEnum>(ANY_PACKAGE, TEXT("EGrapplingHookState"), true);
+		for (int32 State = 0; State < FGrapplingHookTelemetryCounters::NumStates; ++State)
+		{
+			GrapplingHookTelemetryStateNames.Add(StateEnum ? StateEnum->GetNameStringByValue(State) : FString::FromInt(State));
+		}
+		const UEnum* const ErrorEnum = FindObject<UEnum>(ANY_PACKAGE, TEXT("EGrapplingHookError"), true);
+		for (int32 Error = 0; Error < FGrapplingHookTelemetryCounters::NumErrors; ++Error)
+		{
+			GrapplingHookTelemetryErrorNames.Add(ErrorEnum ? ErrorEnum->GetNameStringByValue(Error) : FString::FromInt(Error));
+		}
+	}
+	FGrapplingHookTelemetryCounters Counters;
+	Gather(Counters);
+	Write(Counters);
+}
+bool FGrapplingHookTelemetry::OnFlushTicker(float DeltaTime)
+{
+	GrapplingHookTelemetryTimeSinceFlush += DeltaTime;
+	if (GGrapplingHookTelemetry != 0 && GGrapplingHookTelemetryFlushInterval >= 1.f && GrapplingHookTelemetryTimeSinceFlush >= GGrapplingHookTelemetryFlushInterval)
+	{
+		GrapplingHookTelemetryTimeSinceFlush = 0.f;
+		Flush();
+	}
+	return true;
+}
+void FGrapplingHookTelemetry::OnPreExit()
+{
+	if (GGrapplingHookTelemetry != 0)
+	{
+		Flush();
+	}
+}
+void FGrapplingHookTelemetry::Write(const FGrapplingHookTelemetryCounters& Counters)
+{
+	const FString BasePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GrapplingHook"), FString::Printf(TEXT("Telemetry_%s"), *GrapplingHookTelemetrySession));
+	TArray<TPair<FString, FString>> Files;
+	if (GGrapplingHookTelemetryFormat != 1)
+	{
+		Files.Emplace(BasePath + TEXT(".json"), ToJson(Counters));
+	}
+	if (GGrapplingHookTelemetryFormat != 0)
+	{
+		Files.Emplace(BasePath + TEXT(".csv"), ToCsv(Counters));
+	}
+
+	//File access is kept off the game thread, writes of the same files are serialized
+	TFunction<void()> WriteFiles = [Files]()
+	{
+		for (const TPair<FString, FString>& File : Files)
+		{
+			FFileHelper::SaveStringToFile(File.Value, *File.Key);
+		}
+	};
+	if (GrapplingHookTelemetryPendingWrite.IsValid())
+	{
+		GrapplingHookTelemetryPendingWrite.Wait();
+	}
+	GrapplingHookTelemetryPendingWrite = Async(EAsyncExecution::ThreadPool, MoveTemp(WriteFiles));
+}
+static FString GetGrapplingHookHistogramJson(const FGrapplingHookTelemetryHistogram& Histogram)
+{
+	FString Buckets;
+	for (int32 Bucket = 0; Bucket < FGrapplingHookTelemetryHistogram::NumBuckets; ++Bucket)
+	{
+		Buckets += FString::Printf(Bucket == 0 ? TEXT("%lld") : TEXT(", %lld"), Histogram.Buckets[Bucket]);
+	}
+	return FString::Printf(TEXT("{ \"Count\": %lld, \"Sum\": %lld, \"Buckets\": [%s] }"), Histogram.Count, Histogram.Sum, *Buckets);
+}
+FString FGrapplingHookTelemetry::ToJson(const FGrapplingHookTelemetryCounters& Counters)
+{
+	const double Launches = static_cast<double>(FMath::Max<int64>(Counters.Launches, 1));
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(TEXT("\t\"Session\": \"%s\",\n"), *GrapplingHookTelemetrySession);
+	Json += FString::Printf(TEXT("\t\"Launches\": %lld,\n\t\"Misses\": %lld,\n\t\"MissRate\": %f,\n\t\"Breaks\": %lld,\n\t\"BreakRate\": %f,\n"),
+		Counters.Launches, Counters.Misses, Counters.Misses / Launches, Counters.Breaks, Counters.Breaks / Launches);
+
+	Json += TEXT("\t\"States\": {\n");
+	for (int32 State = 0; State < FGrapplingHookTelemetryCounters::NumStates; ++State)
+	{
+		Json += FString::Printf(TEXT("\t\t\"%s\": { \"Enters\": %lld, \"TimeMs\": %s }%s\n"), *GrapplingHookTelemetryStateNames[State],
+			Counters.StateEnters[State], *GetGrapplingHookHistogramJson(Counters.StateTime[State]), State + 1 < FGrapplingHookTelemetryCounters::NumStates ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("\t},\n\t\"Errors\": {\n");
+	for (int32 Error = 0; Error < FGrapplingHookTelemetryCounters::NumErrors; ++Error)
+	{
+		Json += FString::Printf(TEXT("\t\t\"%s\": %lld%s\n"), *GrapplingHookTelemetryErrorNames[Error],
+			Counters.Errors[Error], Error + 1 < FGrapplingHookTelemetryCounters::NumErrors ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("\t},\n");
+	Json += FString::Printf(TEXT("\t\"LaunchDistanceCm\": %s,\n"), *GetGrapplingHookHistogramJson(Counters.LaunchDistance));
+	Json += FString::Printf(TEXT("\t\"CooldownWaitMs\": %s,\n"), *GetGrapplingHookHistogramJson(Counters.CooldownWait));
+	Json += FString::Printf(TEXT("\t\"LaunchLatencyMs\": %s,\n"), *GetGrapplingHookHistogramJson(Counters.LaunchLatency));
+	Json += FString::Printf(TEXT("\t\"LaunchLatencyFrames\": %s\n"), *GetGrapplingHookHistogramJson(Counters.LaunchLatencyFrames));
+	Json += TEXT("}\n");
+	return Json;
+}
+static void AppendGrapplingHookHistogramCsv(FString& Csv, const TCHAR* const Metric, const FString& Key, const FGrapplingHookTelemetryHistogram& Histogram)
+{
+	Csv += FString::Printf(TEXT("%s,%s,Count,%lld\n%s,%s,Sum,%lld\n"), Metric, *Key, Histogram.Count, Metric, *Key, Histogram.Sum);
+	for (int32 Bucket = 0; Bucket < FGrapplingHookTelemetryHistogram::NumBuckets; ++Bucket)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,Bucket%d,%lld\n"), Metric, *Key, Bucket, Histogram.Buckets[Bucket]);
+	}
+}
+FString FGrapplingHookTelemetry::ToCsv(const FGrapplingHookTelemetryCounters& Counters)
+{
+	FString Csv = TEXT("Metric,Key,Field,Value\n");
+	Csv += FString::Printf(TEXT("Launches,,Count,%lld\nMisses,,Count,%lld\nBreaks,,Count,%lld\n"), Counters.Launches, Counters.Misses, Counters.Breaks);
+	for (int32 State = 0; State < FGrapplingHookTelemetryCounters::NumStates; ++State)
+	{
+		const FString& Name = GrapplingHookTelemetryStateNames[State];
+		Csv += FString::Printf(TEXT("StateEnters,%s,Count,%lld\n"), *Name, Counters.StateEnters[State]);
+		AppendGrapplingHookHistogramCsv(Csv, TEXT("StateTimeMs"), Name, Counters.StateTime[State]);
+	}
+	for (int32 Error = 0; Error < FGrapplingHookTelemetryCounters::NumErrors; ++Error)
+	{
+		Csv += FString::Printf(TEXT("Errors,%s,Count,%lld\n"), *GrapplingHookTelemetryErrorNames[Error], Counters.Errors[Error]);
+	}
+	AppendGrapplingHookHistogramCsv(Csv, TEXT("LaunchDistanceCm"), FString(), Counters.LaunchDistance);
+	AppendGrapplingHookHistogramCsv(Csv, TEXT("CooldownWaitMs"), FString(), Counters.CooldownWait);
+	AppendGrapplingHookHistogramCsv(Csv, TEXT("LaunchLatencyMs"), FString(), Counters.LaunchLatency);
+	AppendGrapplingHookHistogramCsv(Csv, TEXT("LaunchLatencyFrames"), FString(), Counters.LaunchLatencyFrames);
+	return Csv;
+}
@@ -0,0 +1,245 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookTimerWheel.h"
+
+FGrapplingHookTimerWheel::FGrapplingHookTimerWheel(const float InResolution)
+{
+	Resolution = FMath::Max(InResolution, KINDA_SMALL_NUMBER);
+	Now = 0.0;
+	CurrentTick = 0;
+	NumActiveTimers = 0;
+	for (int32 Slot = 0; Slot < NumLevels * SlotsPerLevel; ++Slot)
+	{
+		Slots[Slot] = INDEX_NONE;
+	}
+}
+FGrapplingHookTimerHandle FGrapplingHookTimerWheel::SetTimer(const FSimpleDelegate& Callback, const float Delay, const bool bLoop)
+{
+	FGrapplingHookTimerHandle Handle;
+	if (Delay <= 0.f)
+	{
+		return Handle;
+	}
+
+	const int32 Index = AllocateTimer();
+	FTimer& Timer = Timers[Index];
+	Timer.Callback = Callback;
+	Timer.StartTime = Now;
+	Timer.ExpireTime = Now + FMath::Min(static_cast<double>(Delay), GetMaxDelay());
+	Timer.Interval = bLoop ? Delay : 0.f;
+	Schedule(Index, CurrentTick + 1);
+
+	Handle.Index = Index;
+	Handle.Generation = Timer.Generation;
+	return Handle;
+}
+void FGrapplingHookTimerWheel::ClearTimer(FGrapplingHookTimerHandle& Handle)
+{
+	if (IsHandleActive(Handle))
+	{
+		Unlink(Handle.Index);
+		ReleaseTimer(Handle.Index);
+	}
+	Handle.Invalidate();
+}
+bool FGrapplingHookTimerWheel::SetTimeLeft(const FGrapplingHookTimerHandle& Handle, const float TimeLeft)
+{
+	if (!IsHandleActive(Handle) || TimeLeft <= 0.f)
+	{
+		return false;
+	}
+	//Also valid for a timer expired during the current Advance, it is not fired once linked again
+	Unlink(Handle.Index);
+	Timers[Handle.Index].ExpireTime = Now + FMath::Min(static_cast<double>(TimeLeft), GetMaxDelay());
+	Schedule(Handle.Index, CurrentTick + 1);
+	return true;
+}
+bool FGrapplingHookTimerWheel::IsTimerActive(const FGrapplingHookTimerHandle& Handle) const
+{
+	return IsHandleActive(Handle);
+}
+bool FGrapplingHookTimerWheel::GetTimerInfo(const FGrapplingHookTimerHandle& Handle, float& OutTimeLeft, float& OutTimeElapsed) const
+{
+	if (!IsHandleActive(Handle))
+	{
+		OutTimeLeft = -1.f;
+		OutTimeElapsed = -1.f;
+		return false;
+	}
+	const FTimer& Timer = Timers[Handle.Index];
+	OutTimeLeft = static_cast<float>(FMath::Max(Timer.ExpireTime - Now, 0.0));
+	OutTimeElapsed = static_cast<float>(Now - Timer.StartTime);
+	return true;
+}
+void FGrapplingHookTimerWheel::Advance(const float DeltaTime)
+{
+	if (DeltaTime > 0.f)
+	{
+		Now += DeltaTime;
+	}
+
+	const uint64 TargetTick = static_cast<uint64>(Now / Resolution);
+	while (CurrentTick < TargetTick)
+	{
+		++CurrentTick;
+
+		//Higher levels are cascaded first, so that their timers can end up in the lower level slots cascaded right after
+		int32 TopLevel = 0;
+		while (TopLevel + 1 < NumLevels && (CurrentTick & ((uint64(1) << (SlotBits * (TopLevel + 1))) - 1)) == 0)
+		{
+			++TopLevel;
+		}
+		for (int32 Level = TopLevel; Level > 0; --Level)
+		{
+			Cascade(Level);
+		}
+
+		int32& Head = Slots[static_cast<int32>(CurrentTick & (SlotsPerLevel - 1))];
+		while (Head != INDEX_NONE)
+		{
+			const int32 Index = Head;
+			Unlink(Index);
+			FGrapplingHookTimerHandle& Handle = Expired[Expired.AddUninitialized()];
+			Handle.Index = Index;
+			Handle.Generation = Timers[Index].Generation;
+		}
+	}
+
+	//Callbacks can freely set or clear timers, expired handles are validated again before firing
+	for (int32 ExpiredIndex = 0; ExpiredIndex < Expired.Num(); ++ExpiredIndex)
+	{
+		const FGrapplingHookTimerHandle Handle = Expired[ExpiredIndex];
+		if (!IsHandleActive(Handle) || Timers[Handle.Index].Slot != INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FSimpleDelegate Callback = Timers[Handle.Index].Callback;
+		FTimer& Timer = Timers[Handle.Index];
+		if (Timer.Interval > 0.f)
+		{
+			Timer.StartTime = Timer.ExpireTime;
+			Timer.ExpireTime = FMath::Max(Timer.ExpireTime + Timer.Interval, Now);
+			Schedule(Handle.Index, CurrentTick + 1);
+		}
+		else
+		{
+			ReleaseTimer(Handle.Index);
+		}
+		Callback.ExecuteIfBound();
+	}
+	Expired.Reset();
+}
+int32 FGrapplingHookTimerWheel::GetNumActiveTimers() const
+{
+	return NumActiveTimers;
+}
+double FGrapplingHookTimerWheel::GetTime() const
+{
+	return Now;
+}
+double FGrapplingHookTimerWheel::GetMaxDelay() const
+{
+	//Delays longer than the wheel span would alias with the current top level slot
+	return static_cast<double>((uint64(1) << (SlotBits * NumLevels)) - 2) * Resolution;
+}
+int32 FGrapplingHookTimerWheel::AllocateTimer()
+{
+	int32 Index = INDEX_NONE;
+	if (FreeTimers.Num() > 0)
+	{
+		Index = FreeTimers.Pop(false);
+	}
+	else
+	{
+		Index = Timers.AddDefaulted();
+	}
+	FTimer& Timer = Timers[Index];
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = INDEX_NONE;
+	Timer.Slot = INDEX_NONE;
+	Timer.bActive = true;
+	++NumActiveTimers;
+	return Index;
+}
+void FGrapplingHookTimerWheel::ReleaseTimer(const int32 Index)
+{
+	FTimer& Timer = Timers[Index];
+	Timer.Callback.Unbind();
+	Timer.bActive = false;
+	++Timer.Generation;
+	FreeTimers.Add(Index);
+	--NumActiveTimers;
+}
+bool FGrapplingHookTimerWheel::IsHandleActive(const FGrapplingHookTimerHandle& Handle) const
+{
+	return Timers.IsValidIndex(Handle.Index) && Timers[Handle.Index].bActive && Timers[Handle.Index].Generation == Handle.Generation;
+}
+void FGrapplingHookTimerWheel::Schedule(const int32 Index, const uint64 MinTick)
+{
+	FTimer& Timer = Timers[Index];
+	uint64 ExpireTick = static_cast<uint64>(FMath::CeilToDouble(Timer.ExpireTime / Resolution));
+	if (ExpireTick < MinTick)
+	{
+		ExpireTick = MinTick;
+	}
+	Timer.ExpireTick = ExpireTick;
+
+	//The timer goes in the lowest level whose upper bits match the current tick, it will be cascaded down when the wheel reaches its slot
+	int32 Level = 0;
+	while (Level + 1 < NumLevels && (ExpireTick >> (SlotBits * (Level + 1))) != (CurrentTick >> (SlotBits * (Level + 1))))
+	{
+		++Level;
+	}
+	const int32 SlotIndex = static_cast<int32>((ExpireTick >> (SlotBits * Level)) & (SlotsPerLevel - 1));
+	Link(Index, Level * SlotsPerLevel + SlotIndex);
+}
+void FGrapplingHookTimerWheel::Link(const int32 Index, const int32 Slot)
+{
+	FTimer& Timer = Timers[Index];
+	Timer.Slot = Slot;
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = Slots[Slot];
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = Index;
+	}
+	Slots[Slot] = Index;
+}
+void FGrapplingHookTimerWheel::Unlink(const int32 Index)
+{
+	FTimer& Timer = Timers[Index];
+	if (Timer.Slot == INDEX_NONE)
+	{
+		return;
+	}
+	if (Timer.Prev != INDEX_NONE)
+	{
+		Timers[Timer.Prev].Next = Timer.Next;
+	}
+	else
+	{
+		Slots[Timer.Slot] = Timer.Next;
+	}
+	if (Timer.Next != INDEX_NONE)
+	{
+		Timers[Timer.Next].Prev = Timer.Prev;
+	}
+	Timer.Prev = INDEX_NONE;
+	Timer.Next = INDEX_NONE;
+	Timer.Slot = INDEX_NONE;
+}
+void FGrapplingHookTimerWheel::Cascade(const int32 Level)
+{
+	const int32 Slot = Level * SlotsPerLevel + static_cast<int32>((CurrentTick >> (SlotBits * Level)) & (SlotsPerLevel - 1));
+	int32 Index = Slots[Slot];
+	Slots[Slot] = INDEX_NONE;
+	while (Index != INDEX_NONE)
+	{
+		const int32 Next = Timers[Index].Next;
+		Timers[Index].Slot = INDEX_NONE;
+		//Cascading happens before the current slot is drained, timers expiring this tick can still be linked to it
+		Schedule(Index, CurrentTick);
+		Index = Next;
+	}
+}
@@ -0,0 +1,89 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookTrajectory.h"
+
+FGrapplingHookTrajectory::FGrapplingHookTrajectory()
+	: OwnerLocation(FVector::ZeroVector)
+	, OwnerVelocity(FVector::ZeroVector)
+	, Target(FVector::ZeroVector)
+	, TimeStep(0.f)
+	, Duration(0.f)
+	, State(0)
+	, bValid(false)
+{
+}
+void FGrapplingHookTrajectory::Reset(const uint8 InState, const FVector& InOwnerLocation, const FVector& InOwnerVelocity, const FVector& InTarget, const float InTimeStep)
+{
+	//Allocations are kept, a path of the same size never allocates
+	Points.Reset();
+	StartWeights.Reset();
+	State = InState;
+	OwnerLocation = InOwnerLocation;
+	OwnerVelocity = InOwnerVelocity;
+	Target = InTarget;
+	TimeStep = InTimeStep;
+	Duration = 0.f;
+	bValid = true;
+}
+void FGrapplingHookTrajectory::Invalidate()
+{
+	Points.Reset();
+	StartWeights.Reset();
+	bValid = false;
+}
+void FGrapplingHookTrajectory::AddPoint(const FVector& Point, const float StartWeight, const float MinSpacing, const bool bForce)
+{
+	if (!bForce && Points.Num() > 0 && FVector::DistSquared(Point, Points.Last()) < FMath::Square(MinSpacing))
+	{
+		return;
+	}
+	Points.Add(Point);
+	StartWeights.Add(StartWeight);
+}
+void FGrapplingHookTrajectory::Shift(const FVector& InOwnerLocation, const FVector& InTarget)
+{
+	const FVector StartDelta = InOwnerLocation - OwnerLocation;
+	const FVector TargetDelta = InTarget - Target;
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		Points[Index] += StartDelta * StartWeights[Index] + TargetDelta * (1.f - StartWeights[Index]);
+	}
+	OwnerLocation = InOwnerLocation;
+	Target = InTarget;
+}
+void FGrapplingHookTrajectory::SetDuration(const float InDuration)
+{
+	Duration = InDuration;
+}
+bool FGrapplingHookTrajectory::IsValid() const
+{
+	return bValid;
+}
+uint8 FGrapplingHookTrajectory::GetState() const
+{
+	return State;
+}
+const FVector& FGrapplingHookTrajectory::GetOwnerLocation() const
+{
+	return OwnerLocation;
+}
+const FVector& FGrapplingHookTrajectory::GetOwnerVelocity() const
+{
+	return OwnerVelocity;
+}
+const FVector& FGrapplingHookTrajectory::GetTarget() const
+{
+	return Target;
+}
+float FGrapplingHookTrajectory::GetTimeStep() const
+{
+	return TimeStep;
+}
+float FGrapplingHookTrajectory::GetDuration() const
+{
+	return Duration;
+}
+const TArray<FVector>& FGrapplingHookTrajectory::GetPoints() const
+{
+	return Points;
+}
@@ -0,0 +1,247 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "GrapplingHookWorldData.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+static TMap<const UWorld*, TUniquePtr<FGrapplingHookWorldData>> GrapplingHookWorlds;
+
+static TAutoConsoleVariable<int32> CVarGrapplingHookParallelUpdate(
+	TEXT("GrapplingHook.ParallelUpdate"),
+	1,
+	TEXT("If not 0 the grappling hook update compute phase runs in parallel on the task graph, otherwise on the game thread only"));
+
+static TAutoConsoleVariable<int32> CVarGrapplingHookUpdateWorkers(
+	TEXT("GrapplingHook.UpdateWorkers"),
+	0,
+	TEXT("Maximum number of task graph workers used by the parallel update compute phase (0 lets the task graph use all of them). Used to measure the scaling of the compute phase with the core count"));
+
+static TAutoConsoleVariable<int32> CVarGrapplingHookDeferredInitializationsPerFrame(
+	TEXT("GrapplingHook.DeferredInitializationsPerFrame"),
+	8,
+	TEXT("Maximum number of grappling hook components initialized per frame when their initialization is deferred (values below 1 initialize one component per frame)"));
+
+/* Batches with less hooks than this are computed on the game thread, the task dispatch would cost more than the math itself
+*/
+static const int32 GrapplingHookMinParallelBatch = 64;
+
+void FGrapplingHookUpdateBatch::Reset()
+{
+	Components.Reset();
+	Params.Reset();
+	Inputs.Reset();
+	Results.Reset();
+}
+
+void FGrapplingHookWorldTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target)
+	{
+		Target->Tick(DeltaTime);
+	}
+}
+FString FGrapplingHookWorldTickFunction::DiagnosticMessage()
+{
+	return TEXT("FGrapplingHookWorldTickFunction");
+}
+
+FGrapplingHookWorldData::FGrapplingHookWorldData(UWorld* const InWorld)
+	: PhysicsPool(InWorld)
+{
+	World = InWorld;
+	LastComputeSeconds = 0.0;
+	PendingInitializationsHead = 0;
+
+	TickFunction.Target = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.bTickEvenWhenPaused = false;
+	TickFunction.bHighPriority = false;
+	TickFunction.bRunOnAnyThread = false;
+	TickFunction.TickGroup = ETickingGroup::TG_PrePhysics;
+	if (World && World->PersistentLevel)
+	{
+		TickFunction.RegisterTickFunction(World->PersistentLevel);
+	}
+}
+FGrapplingHookWorldData::~FGrapplingHookWorldData()
+{
+	for (UGrapplingHookComponent* const Grappler : Grapplers)
+	{
+		Grappler->PrimaryComponentTick.RemovePrerequisite(World, TickFunction);
+	}
+	Grapplers.Empty();
+	PendingInitializations.Empty();
+	PendingInitializationsHead = 0;
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+	TickFunction.Target = nullptr;
+}
+FGrapplingHookWorldData* FGrapplingHookWorldData::Get(UWorld* const World)
+{
+	//No new data is created for worlds being torn down, their cleanup may already have happened
+	if (!World || World->bIsTearingDown)
+	{
+		return Find(World);
+	}
+	TUniquePtr<FGrapplingHookWorldData>& Data = GrapplingHookWorlds.FindOrAdd(World);
+	if (!Data.IsValid())
+	{
+		Data = MakeUnique<FGrapplingHookWorldData>(World);
+	}
+	return Data.Get();
+}
+FGrapplingHookWorldData* FGrapplingHookWorldData::Find(const UWorld* const World)
+{
+	const TUniquePtr<FGrapplingHookWorldData>* const Data = GrapplingHookWorlds.Find(World);
+	return Data ? Data->Get() : nullptr;
+}
+void FGrapplingHookWorldData::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	GrapplingHookWorlds.Remove(World);
+}
+void FGrapplingHookWorldData::ReleaseAll()
+{
+	GrapplingHookWorlds.Empty();
+}
+FGrapplingHookTimerWheel& FGrapplingHookWorldData::GetTimerWheel()
+{
+	return TimerWheel;
+}
+FGrapplingHookComponentCache& FGrapplingHookWorldData::GetComponentCache()
+{
+	return ComponentCache;
+}
+FGrapplingHookPhysicsPool& FGrapplingHookWorldData::GetPhysicsPool()
+{
+	return PhysicsPool;
+}
+double FGrapplingHookWorldData::GetLastComputeSeconds() const
+{
+	return LastComputeSeconds;
+}
+void FGrapplingHookWorldData::QueueInitialization(UGrapplingHookComponent* const Grappler)
+{
+	if (!Grappler)
+	{
+		return;
+	}
+	for (int32 Index = PendingInitializationsHead; Index < PendingInitializations.Num(); ++Index)
+	{
+		if (PendingInitializations[Index] == Grappler)
+		{
+			return;
+		}
+	}
+	PendingInitializations.Add(Grappler);
+}
+void FGrapplingHookWorldData::RegisterGrappler(UGrapplingHookComponent* const Grappler)
+{
+	if (Grappler && !Grapplers.Contains(Grappler))
+	{
+		Grapplers.Add(Grappler);
+		Grappler->PrimaryComponentTick.AddPrerequisite(World, TickFunction);
+	}
+}
+void FGrapplingHookWorldData::UnregisterGrappler(UGrapplingHookComponent* const Grappler)
+{
+	//Removed entries are nulled, the queue order and the head index stay valid
+	for (int32 Index = PendingInitializationsHead; Index < PendingInitializations.Num(); ++Index)
+	{
+		if (PendingInitializations[Index] == Grappler)
+		{
+			PendingInitializations[Index] = nullptr;
+		}
+	}
+	if (Grappler && Grapplers.RemoveSwap(Grappler) > 0)
+	{
+		Grappler->PrimaryComponentTick.RemovePrerequisite(World, TickFunction);
+	}
+}
+void FGrapplingHookWorldData::Tick(const float DeltaTime)
+{
+	TimerWheel.Advance(DeltaTime);
+	UpdatePendingInitializations();
+	UpdateGrapplers(DeltaTime);
+}
+void FGrapplingHookWorldData::UpdatePendingInitializations()
+{
+	const int32 Budget = FMath::Max(CVarGrapplingHookDeferredInitializationsPerFrame.GetValueOnGameThread(), 1);
+	int32 Count = 0;
+	while (Count < Budget && PendingInitializationsHead < PendingInitializations.Num())
+	{
+		//Dequeued one at a time, an initialization may unregister (null) other components or queue new ones
+		UGrapplingHookComponent* const Grappler = PendingInitializations[PendingInitializationsHead++];
+		if (Grappler)
+		{
+			Grappler->InitializeFromOwner();
+			++Count;
+		}
+	}
+	//Dequeued entries are removed in one pass per frame
+	if (PendingInitializationsHead > 0)
+	{
+		PendingInitializations.RemoveAt(0, PendingInitializationsHead, false);
+		PendingInitializationsHead = 0;
+	}
+}
+void FGrapplingHookWorldData::UpdateGrapplers(const float DeltaTime)
+{
+	//Gather (game thread): UObjects are only read here
+	Batch.Reset();
+	for (UGrapplingHookComponent* const Grappler : Grapplers)
+	{
+		if (Grappler->IsComponentTickEnabled())
+		{
+			Grappler->GatherUpdateBatch(DeltaTime, Batch);
+		}
+	}
+
+	const int32 NumInputs = Batch.Inputs.Num();
+	if (NumInputs == 0)
+	{
+		LastComputeSeconds = 0.0;
+		return;
+	}
+
+	//Compute (any thread): pure math over the gathered snapshots, every task writes its own result only
+	const double ComputeStart = FPlatformTime::Seconds();
+	Batch.Results.SetNum(NumInputs, false);
+	const bool bSingleThread = CVarGrapplingHookParallelUpdate.GetValueOnGameThread() == 0 || NumInputs < GrapplingHookMinParallelBatch;
+	const int32 MaxWorkers = CVarGrapplingHookUpdateWorkers.GetValueOnGameThread();
+	if (bSingleThread || MaxWorkers <= 0)
+	{
+		ParallelFor(NumInputs, [this](const int32 Index)
+		{
+			const FGrapplingHookUpdateInput& Input = Batch.Inputs[Index];
+			Input.Compute(Batch.Params[Input.ParamsIndex], Batch.Results[Index]);
+		}, bSingleThread);
+	}
+	else
+	{
+		//One contiguous range per worker, so that no more than MaxWorkers tasks run at the same time
+		const int32 NumChunks = FMath::Min(MaxWorkers, NumInputs);
+		const int32 ChunkSize = FMath::DivideAndRoundUp(NumInputs, NumChunks);
+		ParallelFor(NumChunks, [this, NumInputs, ChunkSize](const int32 Chunk)
+		{
+			const int32 End = FMath::Min((Chunk + 1) * ChunkSize, NumInputs);
+			for (int32 Index = Chunk * ChunkSize; Index < End; ++Index)
+			{
+				const FGrapplingHookUpdateInput& Input = Batch.Inputs[Index];
+				Input.Compute(Batch.Params[Input.ParamsIndex], Batch.Results[Index]);
+			}
+		}, NumChunks == 1);
+	}
+	LastComputeSeconds = FPlatformTime::Seconds() - ComputeStart;
+
+	//Results are applied by the components themselves during their tick (game thread)
+	for (int32 Index = 0; Index < NumInputs; ++Index)
+	{
+		const FGrapplingHookUpdateInput& Input = Batch.Inputs[Index];
+		Batch.Components[Input.ParamsIndex]->SetHookUpdate(Input.HookIndex, Batch.Results[Index]);
+	}
+}
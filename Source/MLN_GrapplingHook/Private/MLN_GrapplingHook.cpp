@@ -1,18 +1,32 @@
 // Copyright 1998-2018 Epic Games, Inc. All Rights Reserved.
 
 #include "MLN_GrapplingHook.h"
+#include "GrapplingHookWorldData.h"
+#include "GrapplingHookClassLoader.h"
+#include "GrapplingHookTelemetry.h"
+#include "GrapplingHookBenchmark.h"
+#include "Engine/World.h"
 
 #define LOCTEXT_NAMESPACE "FMLN_GrapplingHookModule"
 
+DEFINE_LOG_CATEGORY(LogGrapplingHook);
+
 void FMLN_GrapplingHookModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&FGrapplingHookWorldData::OnWorldCleanup);
+	FGrapplingHookTelemetry::Startup();
 }
 
 void FMLN_GrapplingHookModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FGrapplingHookBenchmark::Stop();
+	FGrapplingHookWorldData::ReleaseAll();
+	FGrapplingHookClassLoader::ReleaseAll();
+	FGrapplingHookTelemetry::Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
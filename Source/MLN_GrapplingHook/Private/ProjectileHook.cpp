@@ -67,6 +67,7 @@ void AProjectileHook::OnStopped(const FHitResult& Hit)
 	InterruptProjectileMovement(false);
 
 	OnHookStopped.Broadcast(Hit.ImpactNormal, Hit.Component.Get());
+	OnHookStoppedBy.Broadcast(Hit.ImpactNormal, Hit.Component.Get(), this);
 
 	if (CollisionComponent)
 	{
@@ -95,6 +96,53 @@ void AProjectileHook::InterruptProjectileMovement(const bool bLaunchStoppedEvent
 		ProjectileMovement->StopSimulating(Hit);
 	}
 }
+void AProjectileHook::RestartProjectileMovement(const FTransform& Transform)
+{
+	ReleaseContrainedBody();
+	SetActorLocationAndRotation(Transform.GetLocation(), Transform.GetRotation(), false, (FHitResult*)nullptr, ETeleportType::TeleportPhysics);
+
+	if (ProjectileMovement && CollisionComponent)
+	{
+		FScriptDelegate Delegate;
+		Delegate.BindUFunction(this, TEXT("OnStopped"));
+		ProjectileMovement->OnProjectileStop.AddUnique(Delegate);
+
+		ProjectileMovement->SetUpdatedComponent(CollisionComponent);
+		ProjectileMovement->Velocity = Transform.GetRotation().GetForwardVector() * ProjectileMovement->InitialSpeed;
+		ProjectileMovement->UpdateComponentVelocity();
+	}
+	SetActorTickEnabled(true);
+}
+void AProjectileHook::PlaceStopped(const FTransform& Transform, USceneComponent* const Parent)
+{
+	InterruptProjectileMovement(false);
+	ReleaseContrainedBody();
+	SetActorLocationAndRotation(Transform.GetLocation(), Transform.GetRotation(), false, (FHitResult*)nullptr, ETeleportType::TeleportPhysics);
+
+	if (CollisionComponent)
+	{
+		CollisionComponent->SetCollisionEnabled(ECollisionEnabled::Type::NoCollision);
+	}
+
+	if (Parent)
+	{
+		FAttachmentTransformRules Rules(EAttachmentRule::KeepWorld, EAttachmentRule::KeepWorld, EAttachmentRule::KeepWorld, true);
+		AttachToComponent(Parent, Rules);
+	}
+}
+void AProjectileHook::SetHookCollision(const FCollisionResponseContainer& Responses, AActor* const IgnoredActor)
+{
+	if (!CollisionComponent)
+	{
+		return;
+	}
+	CollisionComponent->SetCollisionResponseToChannels(Responses);
+	CollisionComponent->ClearMoveIgnoreActors();
+	if (IgnoredActor)
+	{
+		CollisionComponent->IgnoreActorWhenMoving(IgnoredActor, true);
+	}
+}
 void AProjectileHook::StartSimulation(UCableComponent* const InCable)
 {
 	if (Cable)
@@ -0,0 +1,111 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+#include "Engine/World.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+
+namespace GrapplingHookAimAssistTests
+{
+	static const float DeltaTime = 1.f / 60.f;
+	static const float Distance = 1000.f;
+	static const int32 MaxFrames = 10;
+	static const FVector Start(0.f, 0.f, 500.f);
+
+	/* Requests the aim assist toward a target at the given offset from the aim direction and ticks until its hit is available
+	*@param OutFrames Frames ticked until the hit was available
+	*@param OutRing Outermost ring traced by the sweep
+	*/
+	static bool RunAimAssist(FAutomationTestBase& Test, const FVector& TargetOffset, const bool bRingByRing, int32& OutFrames, int32& OutRing)
+	{
+		FGrapplingHookTestWorld TestWorld;
+		UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector::ZeroVector);
+		if (!Test.TestNotNull(TEXT("Grappler"), Grappler))
+		{
+			return false;
+		}
+		//Aiming traces query the blocking object types, no swing so that any surface is a possible valid hit
+		Grappler->Activation = static_cast<uint8>(EGrapplingHookActivation::GA_Launch);
+		Grappler->AimAssistConeDegrees = 6.f;
+		Grappler->AimAssistRings = 2;
+		Grappler->bAimAssistRingByRing = bRingByRing;
+		AStaticMeshActor* const Box = Cast<AStaticMeshActor>(TestWorld.SpawnBox(Start + FVector(Distance, 0.f, 0.f) + TargetOffset, FVector(60.f)));
+		if (!Test.TestNotNull(TEXT("Target"), Box))
+		{
+			return false;
+		}
+		Box->GetStaticMeshComponent()->SetCollisionObjectType(ECollisionChannel::ECC_Pawn);
+
+		const FVector Direction = FVector::ForwardVector;
+		FHitResult Hit;
+		bool bPossibleValidHit = false;
+		OutFrames = 0;
+		Grappler->RequestAimAssist(Start, Direction, 5000.f, false);
+		while (!Grappler->GetAimAssistHit(Hit, bPossibleValidHit) && OutFrames < MaxFrames)
+		{
+			TestWorld.Tick(DeltaTime);
+			++OutFrames;
+		}
+		const FGrapplingHookAimAssist& AimAssist = FGrapplingHookTestAccess::GetAimAssist(Grappler);
+		Test.TestTrue(TEXT("Aim assist selected a possible valid hit"), bPossibleValidHit && Hit.GetActor() == Box);
+		OutRing = AimAssist.GetSweepRing();
+
+		//An aim change of a fraction of the ring spacing reuses the sweep
+		const FVector MovedStart = Start + FVector(0.f, 5.f, 0.f);
+		const FVector TurnedDirection = FRotator(0.f, 0.5f, 0.f).RotateVector(Direction);
+		Test.TestTrue(TEXT("Sweep reused"), AimAssist.CanReuse(MovedStart, TurnedDirection, 5000.f, false, TestWorld.GetWorld()->GetTimeSeconds(), Grappler->AimAssistReuseDistance, Grappler->AimAssistReuseDegrees, Grappler->AimAssistReuseTime));
+		return true;
+	}
+
+	//Target on the aim direction, then one only the first ring reaches (its rays are 3 degrees off the aim direction)
+	static const FVector TargetOffsets[] = { FVector(0.f, 0.f, 0.f), FVector(0.f, 52.f, 0.f) };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookAimAssistRingsTest, "GrapplingHook.AimAssist.RingByRing", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookAimAssistRingsTest::RunTest(const FString& Parameters)
+{
+	using namespace GrapplingHookAimAssistTests;
+
+	const int32 ExpectedRings[] = { 0, 1 };
+	int32 Frames[2] = { 0, 0 };
+	for (int32 TargetIndex = 0; TargetIndex < 2; ++TargetIndex)
+	{
+		int32 Ring = INDEX_NONE;
+		if (!RunAimAssist(*this, TargetOffsets[TargetIndex], true, Frames[TargetIndex], Ring))
+		{
+			return false;
+		}
+		//Outer rings are traced only when the inner ones found no possible valid hit
+		TestEqual(TEXT("Last ring traced by the sweep"), Ring, ExpectedRings[TargetIndex]);
+	}
+	TestTrue(TEXT("Every outer ring traced adds a frame"), Frames[1] > Frames[0]);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookAimAssistBatchTest, "GrapplingHook.AimAssist.SingleBatch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookAimAssistBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace GrapplingHookAimAssistTests;
+
+	int32 Frames[2] = { 0, 0 };
+	for (int32 TargetIndex = 0; TargetIndex < 2; ++TargetIndex)
+	{
+		int32 Ring = INDEX_NONE;
+		if (!RunAimAssist(*this, TargetOffsets[TargetIndex], false, Frames[TargetIndex], Ring))
+		{
+			return false;
+		}
+		TestEqual(TEXT("All the rings traced by the sweep"), Ring, 2);
+	}
+	//The hit of an outer ring is available as soon as the one of the aim direction
+	TestEqual(TEXT("Frames until an outer ring hit"), Frames[1], Frames[0]);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,84 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+#include "ProjectileHook.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookChainTest, "GrapplingHook.Chain.ZeroGap", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookChainTest::RunTest(const FString& Parameters)
+{
+	static const float DeltaTime = 1.f / 60.f;
+	static const int32 MaxLandingFrames = 60;
+
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector(0.f, 0.f, 300.f));
+	if (!TestNotNull(TEXT("Grappler"), Grappler))
+	{
+		return false;
+	}
+	Grappler->Activation = static_cast<uint8>(EGrapplingHookActivation::GA_Swing);
+	Grappler->bChainHooks = true;
+	//Wall in front of the cable, every hook fired lands on it
+	TestWorld.SpawnBox(FVector(600.f, 0.f, 300.f), FVector(20.f, 400.f, 400.f));
+	TArray<FGrapplingHookInstance>& Hooks = FGrapplingHookTestAccess::GetHooks(Grappler);
+
+	const auto Land = [&]()
+	{
+		for (int32 Frame = 0; Frame < MaxLandingFrames && Hooks[0].CurrentState == EGrapplingHookState::GS_Extending; ++Frame)
+		{
+			TestWorld.Tick(DeltaTime);
+		}
+		return Hooks[0].CurrentState == EGrapplingHookState::GS_Swing;
+	};
+	const auto CountActors = [&TestWorld]()
+	{
+		int32 NumActors = 0;
+		for (TActorIterator<AActor> It(TestWorld.GetWorld()); It; ++It)
+		{
+			++NumActors;
+		}
+		return NumActors;
+	};
+
+	//First launch spawns the hook, the first chain grows the containers used by every chain after it
+	Grappler->LaunchGrapple();
+	AProjectileHook* const Hook = Hooks[0].Hook;
+	if (!TestNotNull(TEXT("Launched hook"), Hook) || !TestTrue(TEXT("Launched hook landed"), Land()))
+	{
+		return false;
+	}
+	Grappler->LaunchGrapple();
+	if (!TestTrue(TEXT("First chained hook landed"), Land()))
+	{
+		return false;
+	}
+
+	//Chained from the swing: the same hook is fired again within the launch call, nothing is allocated, spawned or destroyed
+	const int32 NumActors = CountActors();
+	int32 Allocations = 0;
+	{
+		FGrapplingHookAllocationCounter Counter;
+		Grappler->LaunchGrapple();
+		Allocations = Counter.GetAllocations();
+	}
+	TestEqual(TEXT("Allocations of a chained launch"), Allocations, 0);
+	TestEqual(TEXT("Chained hook is extending once the launch call returns"), Hooks[0].CurrentState, EGrapplingHookState::GS_Extending);
+	TestTrue(TEXT("Chained hook reused"), Hooks[0].Hook == Hook && !Hook->IsPendingKill());
+	TestFalse(TEXT("Chained hook flying"), Hook->ProjectileMovement->Velocity.IsNearlyZero());
+	TestEqual(TEXT("No actor spawned or destroyed by the chain"), CountActors(), NumActors);
+
+	//No retract nor cooldown frame between the two grapples
+	TestTrue(TEXT("Chained hook landed"), Land());
+	TestEqual(TEXT("No actor spawned or destroyed until the chained hook landed"), CountActors(), NumActors);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,205 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+#include "ProjectileHook.h"
+#include "MLN_GrapplingHook.h"
+#include "Engine/World.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "../Plugins/Runtime/CableComponent/Source/CableComponent/Classes/CableComponent.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookCollisionContactsTest, "GrapplingHook.Collision.HookContacts", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookCollisionContactsTest::RunTest(const FString& Parameters)
+{
+	static const int32 NumIrrelevant = 32;
+	static const int32 MaxFrames = 400;
+	//Slow enough for the hook to end a frame inside every box it touches (10 units per frame, boxes 20 units thick)
+	static const float HookSpeed = 1200.f;
+	static const float FrameTime = 1.f / 120.f;
+
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector::ZeroVector);
+	if (!TestNotNull(TEXT("Grappler"), Grappler))
+	{
+		return false;
+	}
+	UCableComponent* const Cable = FGrapplingHookTestAccess::GetHooks(Grappler)[0].Cable;
+	if (!TestNotNull(TEXT("Cable"), Cable))
+	{
+		return false;
+	}
+
+	//Irrelevant geometry (vehicles, destructibles) along the hook path, then the grapple target
+	for (int32 Index = 0; Index < NumIrrelevant; ++Index)
+	{
+		AStaticMeshActor* const Box = Cast<AStaticMeshActor>(TestWorld.SpawnBox(FVector(200.f + Index * 50.f, 0.f, 0.f), FVector(20.f)));
+		if (Box)
+		{
+			Box->GetStaticMeshComponent()->SetCollisionObjectType((Index % 2) == 0 ? ECollisionChannel::ECC_Vehicle : ECollisionChannel::ECC_Destructible);
+			Box->GetStaticMeshComponent()->SetGenerateOverlapEvents(true);
+		}
+	}
+	AStaticMeshActor* const Target = Cast<AStaticMeshActor>(TestWorld.SpawnBox(FVector(200.f + NumIrrelevant * 50.f + 100.f, 0.f, 0.f), FVector(20.f, 400.f, 400.f)));
+	if (!TestNotNull(TEXT("Target"), Target))
+	{
+		return false;
+	}
+
+	//Without filter every channel reports contacts, the irrelevant ones as overlaps so the hook keeps flying to the target
+	FCollisionResponseContainer Unfiltered;
+	Unfiltered.SetAllChannels(ECollisionResponse::ECR_Overlap);
+	Unfiltered.SetResponse(Target->GetStaticMeshComponent()->GetCollisionObjectType(), ECollisionResponse::ECR_Block);
+	FCollisionResponseContainer HookResponses;
+	FGrapplingHookTestAccess::BuildHookCollisionResponses(Grappler, HookResponses);
+
+	//The hook is launched as the component does, its collision component contacts are gathered every frame
+	const FCollisionResponseContainer* const Responses[] = { &Unfiltered, nullptr };
+	int32 Contacts[2];
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		AProjectileHook* const Hook = FGrapplingHookTestAccess::SpawnHook(Grappler, 0);
+		if (!TestNotNull(TEXT("Hook"), Hook))
+		{
+			return false;
+		}
+		if (Responses[Index])
+		{
+			Hook->SetHookCollision(*Responses[Index], Grappler->GetOwner());
+		}
+		Hook->StartSimulation(Cable);
+		Hook->ProjectileMovement->InitialSpeed = HookSpeed;
+		Hook->RestartProjectileMovement(FTransform(FRotator::ZeroRotator, FVector(100.f, 0.f, 0.f)));
+
+		TSet<UPrimitiveComponent*> Touched;
+		TArray<UPrimitiveComponent*> Overlapping;
+		for (int32 Frame = 0; Frame < MaxFrames && !Hook->GetRootComponent()->GetAttachParent(); ++Frame)
+		{
+			TestWorld.Tick(FrameTime);
+			Hook->CollisionComponent->GetOverlappingComponents(Overlapping);
+			Touched.Append(Overlapping);
+		}
+		USceneComponent* const StoppedOn = Hook->GetRootComponent()->GetAttachParent();
+		if (StoppedOn)
+		{
+			Touched.Add(Cast<UPrimitiveComponent>(StoppedOn));
+		}
+		Contacts[Index] = Touched.Num();
+		TestTrue(FString::Printf(TEXT("Hook %d stopped on the grapple target"), Index), StoppedOn == Target->GetStaticMeshComponent());
+
+		Hook->StartSimulation(nullptr);
+		Hook->Destroy();
+	}
+
+	UE_LOG(LogGrapplingHook, Display, TEXT("Hook contacts along the path: %d reporting all channels, %d with the hook responses"), Contacts[0], Contacts[1]);
+	TestEqual(TEXT("Every box is a contact without filter"), Contacts[0], NumIrrelevant + 1);
+	TestEqual(TEXT("Only the grapple target is a contact with the hook responses"), Contacts[1], 1);
+	TestEqual(TEXT("Blocking objects still stop the hook"), HookResponses.GetResponse(ECollisionChannel::ECC_Pawn), ECollisionResponse::ECR_Block);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookRopeContactsTest, "GrapplingHook.Collision.RopeContacts", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookRopeContactsTest::RunTest(const FString& Parameters)
+{
+	static const int32 Spans = 4;
+
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector(0.f, 0.f, 300.f));
+	if (!TestNotNull(TEXT("Grappler"), Grappler))
+	{
+		return false;
+	}
+	TArray<FGrapplingHookInstance>& Hooks = FGrapplingHookTestAccess::GetHooks(Grappler);
+	UCableComponent* const Cable = Hooks[0].Cable;
+	if (!TestNotNull(TEXT("Cable"), Cable))
+	{
+		return false;
+	}
+	//Straight cable through a wall, its particles are laid out from the cable start to its end when registered
+	Cable->EndLocation = FVector(400.f, 0.f, 0.f);
+	Cable->SetCollisionObjectType(ECollisionChannel::ECC_PhysicsBody);
+	Cable->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Block);
+	Cable->ReregisterComponent();
+	AStaticMeshActor* const Wall = Cast<AStaticMeshActor>(TestWorld.SpawnBox(FVector(200.f, 0.f, 300.f), FVector(20.f, 200.f, 200.f)));
+	if (!TestNotNull(TEXT("Wall"), Wall))
+	{
+		return false;
+	}
+	UStaticMeshComponent* const WallMesh = Wall->GetStaticMeshComponent();
+	Grappler->RopeCollisionSpans = Spans;
+	Grappler->RopeCollisionReuseDistance = 2.f;
+
+	//Spans are swept again without moving the cable, as if they moved
+	const auto SweepAgain = [&Hooks, Grappler]()
+	{
+		for (FGrapplingHookRopeContact& Contact : Hooks[0].RopeContacts)
+		{
+			Contact.bSwept = false;
+		}
+		FGrapplingHookTestAccess::UpdateRopeCollision(Grappler, 0, Spans);
+	};
+
+	TArray<FVector> Contacts;
+	FGrapplingHookTestAccess::UpdateRopeCollision(Grappler, 0, Spans);
+	TestTrue(TEXT("The wall is a rope contact"), Grappler->GetRopeContacts(Contacts, 0) > 0);
+	TestFalse(TEXT("The cable particle collision is disabled by default"), Cable->bEnableCollision);
+
+	//The rendered cable goes through the contacts instead: hidden from the frame, route cables from the cable start to the first contact and on
+	const TArray<UCableComponent*>& RouteCables = Hooks[0].RopeRouteCables;
+	TestTrue(TEXT("Cable routed through the contacts"), Hooks[0].bRopeRouted && !Cable->bRenderInMainPass);
+	if (TestTrue(TEXT("Route cables"), Contacts.Num() > 0 && RouteCables.Num() > Contacts.Num() && RouteCables[0] != nullptr))
+	{
+		TestTrue(TEXT("First route cable visible"), RouteCables[0]->IsVisible());
+		TestTrue(TEXT("First route cable starts at the cable start"), RouteCables[0]->GetComponentLocation().Equals(Cable->GetComponentLocation(), 1.f));
+		TestTrue(TEXT("First route cable ends at the first contact"), (RouteCables[0]->GetComponentLocation() + RouteCables[0]->EndLocation).Equals(Contacts[0], 1.f));
+	}
+
+	//A previous contact that stopped blocking the cable channel is not reused
+	WallMesh->SetCollisionResponseToChannel(Cable->GetCollisionObjectType(), ECollisionResponse::ECR_Ignore);
+	SweepAgain();
+	TestEqual(TEXT("Wall ignoring the cable channel"), Grappler->GetRopeContacts(Contacts, 0), 0);
+	TestTrue(TEXT("Cable rendered again without contacts"), !Hooks[0].bRopeRouted && Cable->bRenderInMainPass);
+	TestTrue(TEXT("Route cables hidden without contacts"), RouteCables.Num() == 0 || !RouteCables[0]->IsVisible());
+	WallMesh->SetCollisionResponseToChannel(Cable->GetCollisionObjectType(), ECollisionResponse::ECR_Block);
+	SweepAgain();
+	TestTrue(TEXT("Wall blocking the cable channel again"), Grappler->GetRopeContacts(Contacts, 0) > 0);
+
+	//Nor one the cable responses ignore
+	Cable->SetCollisionResponseToChannel(WallMesh->GetCollisionObjectType(), ECollisionResponse::ECR_Ignore);
+	SweepAgain();
+	TestEqual(TEXT("Cable ignoring the wall object type"), Grappler->GetRopeContacts(Contacts, 0), 0);
+	Cable->SetCollisionResponseToChannel(WallMesh->GetCollisionObjectType(), ECollisionResponse::ECR_Block);
+
+	//A blocker nearer to the cable start than the previous contact becomes the contact
+	AStaticMeshActor* const Blocker = Cast<AStaticMeshActor>(TestWorld.SpawnBox(FVector(100.f, 0.f, 300.f), FVector(20.f, 200.f, 200.f)));
+	if (!TestNotNull(TEXT("Blocker"), Blocker))
+	{
+		return false;
+	}
+	SweepAgain();
+	const FGrapplingHookRopeContact* FirstContact = nullptr;
+	for (const FGrapplingHookRopeContact& Contact : Hooks[0].RopeContacts)
+	{
+		if (Contact.bContact)
+		{
+			FirstContact = &Contact;
+			break;
+		}
+	}
+	TestTrue(TEXT("Nearer blocker is the first contact"), FirstContact && FirstContact->Component.Get() == Blocker->GetStaticMeshComponent());
+
+	Grappler->bRopeContactCableCollision = true;
+	SweepAgain();
+	TestTrue(TEXT("The cable particle collision is enabled on contact when requested"), Cable->bEnableCollision);
+	TestTrue(TEXT("Cable not routed with the cable particle collision"), !Hooks[0].bRopeRouted && Cable->bRenderInMainPass);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
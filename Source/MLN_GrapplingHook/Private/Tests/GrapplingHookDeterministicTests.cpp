@@ -0,0 +1,192 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+#include "GrapplingHookFixedPoint.h"
+#include "MLN_GrapplingHook.h"
+#include "Curves/CurveFloat.h"
+#include "Math/RandomStream.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "../Plugins/Runtime/CableComponent/Source/CableComponent/Classes/CableComponent.h"
+
+namespace GrapplingHookDeterministicTests
+{
+	static const int32 NumLifecycles = 100000;
+	static const int32 MaxPhaseSteps = 600;
+	static const int32 MaxLifecycleSteps = 2000;
+	static const int32 GarbageInterval = 1000;
+	static const float Step = 1.f / 30.f;
+	/* Combined hash of all the lifecycles, recorded from the reference build. Every build must produce it, whatever the compiler and the platform
+	*@note 0 until recorded: the test reports the hash to record instead of comparing it
+	*/
+	static const uint32 ReferenceHash = 0u;
+
+	/* Random integer location in [-Range, Range], integer only so that the inputs are the same on every platform
+	*/
+	static FVector RandomLocation(FRandomStream& Random, const uint32 Range)
+	{
+		const auto Coordinate = [&Random, Range]() { return static_cast<float>(static_cast<int32>(Random.GetUnsignedInt() % (2 * Range + 1)) - static_cast<int32>(Range)); };
+		const float X = Coordinate();
+		const float Y = Coordinate();
+		const float Z = Coordinate();
+		return FVector(X, Y, Z);
+	}
+
+	/* Spawns a grapple target ignored by the owner capsule (the owner reaches the anchor instead of being stopped by it), simulating physics if pullable
+	*/
+	static UStaticMeshComponent* SpawnTarget(FGrapplingHookTestWorld& TestWorld, const FVector& Size, const bool bPullable)
+	{
+		AActor* const Box = TestWorld.SpawnBox(FVector(0.f, 0.f, -100000.f), Size);
+		UStaticMeshComponent* const Mesh = Box ? Cast<UStaticMeshComponent>(Box->GetRootComponent()) : nullptr;
+		if (!Mesh)
+		{
+			return nullptr;
+		}
+		if (bPullable)
+		{
+			Mesh->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+			Mesh->SetEnableGravity(false);
+			Mesh->SetMassOverrideInKg(NAME_None, 1.f);
+			Mesh->SetSimulatePhysics(true);
+		}
+		Mesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Ignore);
+		return Mesh;
+	}
+
+	/* Runs a random launch, pull or swing lifecycle with the deterministic steps of the component: the hook is fired at a random target, flies, lands,
+	* runs its state (a swing is stopped after a random number of steps), retracts and cools down until it is ready again.
+	* Returns the combined state hash of every simulated step
+	*@param bOutFinished False if the hook was not ready again within MaxLifecycleSteps
+	*/
+	static uint32 RunLifecycle(const int32 Lifecycle, UGrapplingHookComponent* const Grappler, UStaticMeshComponent* const Wall, UStaticMeshComponent* const Pullable, UCurveFloat* const Curve, bool& bOutFinished)
+	{
+		static const EGrapplingHookActivation Features[] = { EGrapplingHookActivation::GA_Launch, EGrapplingHookActivation::GA_Pull, EGrapplingHookActivation::GA_Swing };
+
+		FRandomStream Random(Lifecycle);
+		ACharacter* const Character = CastChecked<ACharacter>(Grappler->GetOwner());
+		UCableComponent* const Cable = Grappler->GetHookCable(0);
+		const TArray<FGrapplingHookInstance>& Hooks = FGrapplingHookTestAccess::GetHooks(Grappler);
+		uint32 Hash = FGrapplingHookStateHash::Combine(FGrapplingHookStateHash::Seed, static_cast<int64>(Lifecycle));
+
+		const uint32 Kind = Random.GetUnsignedInt() % 3;
+		Grappler->Activation = static_cast<uint8>(Features[Kind] | EGrapplingHookActivation::GA_Extending | EGrapplingHookActivation::GA_Retracting | EGrapplingHookActivation::GA_Cooldown);
+		Grappler->RetractDuration = 0.2f + (Random.GetUnsignedInt() % 100) * 0.01f;
+		Grappler->SetRetractCurve((Lifecycle & 1) != 0 ? Curve : nullptr);
+
+		//Owner standing still in the air, aimed upward at a random target in front of it
+		UCharacterMovementComponent* const MoveComponent = Character->GetCharacterMovement();
+		Character->SetActorLocation(RandomLocation(Random, 5000), false, nullptr, ETeleportType::TeleportPhysics);
+		MoveComponent->StopMovementImmediately();
+		MoveComponent->SetMovementMode(EMovementMode::MOVE_Falling);
+		const float Pitch = static_cast<float>(30 + Random.GetUnsignedInt() % 61);
+		const float Yaw = static_cast<float>(Random.GetUnsignedInt() % 360);
+		Cable->SetWorldRotation(FRotator(Pitch, Yaw, 0.f));
+		const float Distance = static_cast<float>(300 + Random.GetUnsignedInt() % 1500);
+		UStaticMeshComponent* const Target = Kind == 1 ? Pullable : Wall;
+		UStaticMeshComponent* const Unused = Kind == 1 ? Wall : Pullable;
+		Target->SetWorldLocation(Cable->GetComponentLocation() + Cable->GetForwardVector() * Distance, false, nullptr, ETeleportType::TeleportPhysics);
+		Unused->SetWorldLocation(FVector(0.f, 0.f, -100000.f), false, nullptr, ETeleportType::TeleportPhysics);
+
+		Grappler->LaunchGrappleAt(0);
+		const int32 StopStep = Kind == 2 ? 30 + static_cast<int32>(Random.GetUnsignedInt() % 300) : MaxPhaseSteps;
+		bOutFinished = false;
+		for (int32 StepIndex = 0; StepIndex < MaxLifecycleSteps && !bOutFinished; ++StepIndex)
+		{
+			if (StepIndex == StopStep)
+			{
+				Grappler->StopGrapple();
+			}
+			FGrapplingHookTestAccess::StepDeterministic(Grappler, Step);
+			int32 Frame = 0;
+			Hash = FGrapplingHookStateHash::Combine(Hash, static_cast<int64>(static_cast<uint32>(Grappler->GetDeterministicStateHash(Frame))));
+			bOutFinished = Hooks[0].CurrentState == EGrapplingHookState::GS_Ready;
+		}
+		return Hash;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookDeterministicHashTest, "GrapplingHook.Deterministic.LifecycleHash", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookDeterministicHashTest::RunTest(const FString& Parameters)
+{
+	using namespace GrapplingHookDeterministicTests;
+
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector::ZeroVector);
+	UStaticMeshComponent* const Wall = SpawnTarget(TestWorld, FVector(400.f, 400.f, 400.f), false);
+	UStaticMeshComponent* const Pullable = SpawnTarget(TestWorld, FVector(50.f, 50.f, 50.f), true);
+	if (!TestNotNull(TEXT("Grappler"), Grappler) || !TestNotNull(TEXT("Wall"), Wall) || !TestNotNull(TEXT("Pullable"), Pullable))
+	{
+		return false;
+	}
+	Grappler->bDeterministic = true;
+	Grappler->DeterministicTimeStep = Step;
+	Grappler->MissedCooldown = 0.1f;
+	Grappler->LaunchCooldown = 0.1f;
+	Grappler->PullCooldown = 0.1f;
+	Grappler->SwingCooldown = 0.1f;
+
+	//Descending section: the fixed point easing interpolates negative deltas
+	UCurveFloat* const Curve = NewObject<UCurveFloat>(GetTransientPackage());
+	Curve->FloatCurve.AddKey(0.f, 0.f);
+	Curve->FloatCurve.AddKey(0.4f, 1.2f);
+	Curve->FloatCurve.AddKey(0.7f, 0.9f);
+	Curve->FloatCurve.AddKey(1.f, 1.f);
+	Curve->AddToRoot();
+
+	const double Start = FPlatformTime::Seconds();
+	uint32 Hash = FGrapplingHookStateHash::Seed;
+	int32 NumUnfinished = 0;
+	for (int32 Lifecycle = 0; Lifecycle < NumLifecycles; ++Lifecycle)
+	{
+		bool bFinished = false;
+		Hash = FGrapplingHookStateHash::Combine(Hash, static_cast<int64>(RunLifecycle(Lifecycle, Grappler, Wall, Pullable, Curve, bFinished)));
+		NumUnfinished += bFinished ? 0 : 1;
+		//Every lifecycle spawns and destroys an hook
+		if ((Lifecycle + 1) % GarbageInterval == 0)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+	Curve->RemoveFromRoot();
+	UE_LOG(LogGrapplingHook, Display, TEXT("Deterministic hash of %d lifecycles: %08x (%.2f s)"), NumLifecycles, Hash, FPlatformTime::Seconds() - Start);
+
+	TestEqual(TEXT("Lifecycles back to ready"), NumUnfinished, 0);
+	if (ReferenceHash == 0u)
+	{
+		AddError(FString::Printf(TEXT("No reference lifecycle hash recorded, set ReferenceHash to %08x from the reference build"), Hash));
+	}
+	else
+	{
+		TestEqual(TEXT("Lifecycle hash matches the hash of the reference build"), Hash, ReferenceHash);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookFixedPointTest, "GrapplingHook.Deterministic.FixedPoint", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookFixedPointTest::RunTest(const FString& Parameters)
+{
+	const int64 One = FGrapplingHookFixed::OneRaw;
+	//Truncated toward zero, symmetric for negative operands
+	TestEqual(TEXT("-1.5 * 1.5"), FGrapplingHookFixed::MulRaw(-3 * One / 2, 3 * One / 2), -9 * One / 4);
+	TestEqual(TEXT("Smallest negative product"), FGrapplingHookFixed::MulRaw(-1, 1), static_cast<int64>(0));
+	TestEqual(TEXT("-7 / 2"), FGrapplingHookFixed::DivRaw(-7 * One, 2 * One), -7 * One / 2);
+	TestEqual(TEXT("1 / -3"), FGrapplingHookFixed::DivRaw(One, -3 * One), -(One / 3));
+	//Divisors above 2^47 overflowed the scaled remainder
+	const int64 Big = static_cast<int64>(1) << 50;
+	TestEqual(TEXT("Big / (Big + One)"), FGrapplingHookFixed::DivRaw(Big, Big + One), One - 1);
+	TestEqual(TEXT("(Big - 1) / Big"), FGrapplingHookFixed::DivRaw(Big - 1, Big), One - 1);
+	TestEqual(TEXT("Division by zero"), FGrapplingHookFixed::DivRaw(One, 0), static_cast<int64>(0));
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
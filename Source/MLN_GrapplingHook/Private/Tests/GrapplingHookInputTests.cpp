@@ -0,0 +1,52 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookLaunchBufferTest, "GrapplingHook.Input.LaunchBuffer", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookLaunchBufferTest::RunTest(const FString& Parameters)
+{
+	static const float DeltaTime = 1.f / 60.f;
+	static const int32 BufferedFrames = 3;
+
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector(0.f, 0.f, 300.f));
+	if (!TestNotNull(TEXT("Grappler"), Grappler))
+	{
+		return false;
+	}
+	Grappler->InputBufferWindow = 0.2f;
+	TArray<FGrapplingHookInstance>& Hooks = FGrapplingHookTestAccess::GetHooks(Grappler);
+	float LatencyMs = 0.f;
+	int32 LatencyFrames = 0;
+
+	//Input pressed during the cooldown, which outlasts the buffer window: the input is discarded
+	Hooks[0].CurrentState = EGrapplingHookState::GS_Disabled;
+	Grappler->LaunchGrapple();
+	TestTrue(TEXT("Launch input buffered during the cooldown"), Grappler->IsLaunchBuffered());
+	TestWorld.Tick(DeltaTime, FMath::CeilToInt(Grappler->InputBufferWindow / DeltaTime) + 1);
+	TestFalse(TEXT("Buffered launch expired after the buffer window"), Grappler->IsLaunchBuffered());
+	FGrapplingHookTestAccess::EnableHook(Grappler, 0);
+	TestEqual(TEXT("Expired launch input is not performed"), Hooks[0].CurrentState, EGrapplingHookState::GS_Ready);
+	TestFalse(TEXT("No launch latency measured"), Grappler->GetLastLaunchLatency(LatencyMs, LatencyFrames));
+
+	//Input pressed a few frames before the end of the cooldown: the hook is launched as soon as it is ready
+	Hooks[0].CurrentState = EGrapplingHookState::GS_Disabled;
+	Grappler->LaunchGrapple();
+	TestWorld.Tick(DeltaTime, BufferedFrames);
+	TestTrue(TEXT("Launch input still buffered within the buffer window"), Grappler->IsLaunchBuffered());
+	FGrapplingHookTestAccess::EnableHook(Grappler, 0);
+	TestFalse(TEXT("Buffered launch consumed"), Grappler->IsLaunchBuffered());
+	TestNotEqual(TEXT("Hook launched when ready"), Hooks[0].CurrentState, EGrapplingHookState::GS_Ready);
+	//The latency runs from the input to the launch, the frames the input waited in the buffer included
+	TestTrue(TEXT("Launch latency measured"), Grappler->GetLastLaunchLatency(LatencyMs, LatencyFrames));
+	TestEqual(TEXT("Launch latency frames"), LatencyFrames, BufferedFrames);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,72 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+#include "ProjectileHook.h"
+#include "Components/AudioComponent.h"
+#include "../Plugins/Runtime/CableComponent/Source/CableComponent/Classes/CableComponent.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookLazySubobjectsTest, "GrapplingHook.Lazy.Subobjects", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookLazySubobjectsTest::RunTest(const FString& Parameters)
+{
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector(0.f, 0.f, 100.f));
+	if (!TestNotNull(TEXT("Grappler"), Grappler))
+	{
+		return false;
+	}
+	//The cable set up by the owner is not lazy, the component creates its own
+	TArray<FGrapplingHookInstance>& Hooks = FGrapplingHookTestAccess::GetHooks(Grappler);
+	UCableComponent* const OwnerCable = Hooks[0].Cable;
+	Hooks[0].Cable = nullptr;
+	Grappler->bLazySubobjects = true;
+	Grappler->bUsePhysicsPool = false;
+	Grappler->LazyIdleTime = 0.5f;
+
+	//The saved memory is an estimate: the properties size of every missing subobject class
+	const int32 CableSize = UCableComponent::StaticClass()->GetPropertiesSize();
+	const int32 AudioSize = UAudioComponent::StaticClass()->GetPropertiesSize();
+	TestNull(TEXT("No audio before the first sound"), Grappler->GetAudioComponent());
+	TestEqual(TEXT("Estimated memory saved while released"), Grappler->GetLazyMemorySaved(), CableSize + AudioSize);
+
+	//First use creates them
+	AProjectileHook* const Hook = FGrapplingHookTestAccess::SpawnHook(Grappler, 0);
+	UCableComponent* const LazyCable = Hooks[0].Cable;
+	TestNotNull(TEXT("Hook spawned"), Hook);
+	TestTrue(TEXT("Cable created on launch"), LazyCable && LazyCable != OwnerCable && LazyCable->IsRegistered());
+	TestTrue(TEXT("Lazy cable flagged"), Hooks[0].bLazyCable);
+	FGrapplingHookTestAccess::CreateLazyAudio(Grappler);
+	UAudioComponent* const LazyAudio = Grappler->GetAudioComponent();
+	TestTrue(TEXT("Audio created on the first sound"), LazyAudio && LazyAudio->IsRegistered());
+	TestEqual(TEXT("Nothing saved while created"), Grappler->GetLazyMemorySaved(), 0);
+	if (Hook)
+	{
+		Hook->Destroy();
+	}
+
+	//Destroyed after the idle time with all hooks ready
+	FGrapplingHookTestAccess::ScheduleLazyRelease(Grappler);
+	TestWorld.Tick(0.1f, 2);
+	TestTrue(TEXT("Cable kept before the idle time"), Hooks[0].Cable == LazyCable);
+	TestWorld.Tick(0.1f, 5);
+	TestNull(TEXT("Cable released after the idle time"), Hooks[0].Cable);
+	TestNull(TEXT("Audio released after the idle time"), Grappler->GetAudioComponent());
+	TestFalse(TEXT("Released cable destroyed"), IsValid(LazyCable));
+	TestFalse(TEXT("Released audio destroyed"), IsValid(LazyAudio));
+	TestEqual(TEXT("Estimated memory saved again"), Grappler->GetLazyMemorySaved(), CableSize + AudioSize);
+
+	//DestroyLazySubobjects only destroys what the component created
+	Hooks[0].Cable = OwnerCable;
+	FGrapplingHookTestAccess::CreateLazyAudio(Grappler);
+	FGrapplingHookTestAccess::DestroyLazySubobjects(Grappler);
+	TestTrue(TEXT("Owner cable kept"), Hooks[0].Cable == OwnerCable && OwnerCable->IsRegistered());
+	TestNull(TEXT("Lazy audio destroyed"), Grappler->GetAudioComponent());
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,120 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookWorldData.h"
+#include "GrapplingHookPhysicsPool.h"
+#include "Engine/World.h"
+#include "Components/StaticMeshComponent.h"
+#include "PhysicsEngine/PhysicsHandleComponent.h"
+#include "PhysicsEngine/PhysicsConstraintComponent.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookPhysicsPoolReuseTest, "GrapplingHook.PhysicsPool.Reuse", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookPhysicsPoolReuseTest::RunTest(const FString& Parameters)
+{
+	FGrapplingHookTestWorld TestWorld;
+	FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Get(TestWorld.GetWorld());
+	if (!TestNotNull(TEXT("World data"), WorldData))
+	{
+		return false;
+	}
+	FGrapplingHookPhysicsPool& Pool = WorldData->GetPhysicsPool();
+
+	//A returned constraint is leased again, a new one is only created while all are leased
+	UPhysicsConstraintComponent* const First = Pool.LeaseConstraint();
+	if (!TestNotNull(TEXT("Leased constraint"), First))
+	{
+		return false;
+	}
+	Pool.ReturnConstraint(First);
+	TestEqual(TEXT("Returned constraint is free"), Pool.GetStats().FreeConstraints, 1);
+	TestTrue(TEXT("Free constraint is leased again"), Pool.LeaseConstraint() == First);
+	UPhysicsConstraintComponent* const Second = Pool.LeaseConstraint();
+	TestTrue(TEXT("New constraint while all are leased"), Second && Second != First);
+	FGrapplingHookPhysicsPoolStats Stats = Pool.GetStats();
+	TestEqual(TEXT("Active constraints"), Stats.ActiveConstraints, 2);
+	TestEqual(TEXT("Free constraints"), Stats.FreeConstraints, 0);
+	TestEqual(TEXT("Peak constraints"), Stats.PeakConstraints, 2);
+	Pool.ReturnConstraint(First);
+	Pool.ReturnConstraint(Second);
+	Stats = Pool.GetStats();
+	TestEqual(TEXT("No active constraint"), Stats.ActiveConstraints, 0);
+	TestEqual(TEXT("All constraints free"), Stats.FreeConstraints, 2);
+	TestEqual(TEXT("Peak constraints kept"), Stats.PeakConstraints, 2);
+
+	//Handles are released and stop ticking when returned
+	AActor* const Box = TestWorld.SpawnBox(FVector(0.f, 0.f, 200.f), FVector(50.f));
+	UPrimitiveComponent* const BoxComponent = Box ? Cast<UPrimitiveComponent>(Box->GetRootComponent()) : nullptr;
+	UPhysicsHandleComponent* const Handle = Pool.LeaseHandle();
+	if (!TestNotNull(TEXT("Leased handle"), Handle) || !TestNotNull(TEXT("Grabbed box"), BoxComponent))
+	{
+		return false;
+	}
+	TestTrue(TEXT("Leased handle ticks"), Handle->IsComponentTickEnabled());
+	Handle->GrabComponentAtLocation(BoxComponent, NAME_None, BoxComponent->GetComponentLocation());
+	Pool.ReturnHandle(Handle);
+	TestNull(TEXT("Returned handle released its component"), Handle->GrabbedComponent);
+	TestFalse(TEXT("Returned handle does not tick"), Handle->IsComponentTickEnabled());
+	TestTrue(TEXT("Free handle is leased again"), Pool.LeaseHandle() == Handle);
+	Pool.ReturnHandle(Handle);
+
+	//Prewarm counts the leased components, only the missing ones are created
+	Pool.LeaseConstraint();
+	Pool.Prewarm(4, 3);
+	Stats = Pool.GetStats();
+	TestEqual(TEXT("Prewarmed free constraints"), Stats.FreeConstraints, 3);
+	TestEqual(TEXT("Prewarmed free handles"), Stats.FreeHandles, 3);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookPhysicsPoolTeardownTest, "GrapplingHook.PhysicsPool.Teardown", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookPhysicsPoolTeardownTest::RunTest(const FString& Parameters)
+{
+	const UWorld* DestroyedWorld = nullptr;
+	TWeakObjectPtr<UPhysicsConstraintComponent> LeasedConstraint;
+	TWeakObjectPtr<UPhysicsHandleComponent> FreeHandle;
+	TWeakObjectPtr<AActor> PoolActor;
+	{
+		FGrapplingHookTestWorld TestWorld;
+		DestroyedWorld = TestWorld.GetWorld();
+		FGrapplingHookWorldData* const WorldData = FGrapplingHookWorldData::Get(TestWorld.GetWorld());
+		if (!TestNotNull(TEXT("World data"), WorldData))
+		{
+			return false;
+		}
+		FGrapplingHookPhysicsPool& Pool = WorldData->GetPhysicsPool();
+
+		//Components of a destroyed pool actor are not reused, the pool spawns a new actor
+		UPhysicsConstraintComponent* const Lost = Pool.LeaseConstraint();
+		if (!TestNotNull(TEXT("Leased constraint"), Lost))
+		{
+			return false;
+		}
+		AActor* const LostActor = Lost->GetOwner();
+		LostActor->Destroy();
+		Pool.ReturnConstraint(Lost);
+		TestEqual(TEXT("Constraint of a destroyed pool actor is not kept"), Pool.GetStats().FreeConstraints, 0);
+		UPhysicsConstraintComponent* const Replacement = Pool.LeaseConstraint();
+		TestTrue(TEXT("New pool actor spawned"), Replacement && Replacement != Lost && Replacement->GetOwner() != LostActor);
+
+		//A leased and a free component are left in the world when it is torn down
+		LeasedConstraint = Replacement;
+		UPhysicsHandleComponent* const Handle = Pool.LeaseHandle();
+		Pool.ReturnHandle(Handle);
+		FreeHandle = Handle;
+		PoolActor = Replacement ? Replacement->GetOwner() : nullptr;
+		TestTrue(TEXT("Pool actor alive"), PoolActor.IsValid());
+	}
+
+	TestNull(TEXT("World data released with the world"), FGrapplingHookWorldData::Find(DestroyedWorld));
+	TestFalse(TEXT("Pool actor destroyed with the world"), PoolActor.IsValid());
+	TestFalse(TEXT("Leased constraint destroyed with the world"), LeasedConstraint.IsValid());
+	TestFalse(TEXT("Free handle destroyed with the world"), FreeHandle.IsValid());
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,119 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GrapplingHookComponent.h"
+#include "GrapplingHookEasing.h"
+#include "MLN_GrapplingHook.h"
+#include "Curves/CurveFloat.h"
+#include "UObject/Package.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookRetractClockTest, "GrapplingHook.Retract.ClockDuration", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookRetractClockTest::RunTest(const FString& Parameters)
+{
+	const float Durations[] = { 0.1f, 0.5f, 1.f, 2.f };
+	const float FrameRates[] = { 30.f, 60.f, 144.f, 240.f };
+	for (const float Duration : Durations)
+	{
+		for (const float FrameRate : FrameRates)
+		{
+			const float Rate = FGrapplingHookRetractClock::GetRate(Duration);
+			uint32 Clock = 0;
+			int32 Frames = 0;
+			while (Clock < FGrapplingHookRetractClock::One && Frames < 100000)
+			{
+				Clock = FGrapplingHookRetractClock::Advance(Clock, Rate, 1.f / FrameRate);
+				++Frames;
+			}
+			//A retract ends within one frame of its duration
+			const float Expected = Duration * FrameRate;
+			TestTrue(FString::Printf(TEXT("%.2f s retract at %.0f Hz ends in %d frames (expected %.1f)"), Duration, FrameRate, Frames, Expected), FMath::Abs(Frames - Expected) <= 1.f);
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookRetractBenchmark, "GrapplingHook.Benchmark.Retract", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FGrapplingHookRetractBenchmark::RunTest(const FString& Parameters)
+{
+	static const int32 NumRetracts = 1000;
+	static const float DeltaTime = 1.f / 60.f;
+
+	UCurveFloat* const Curve = NewObject<UCurveFloat>(GetTransientPackage());
+	Curve->FloatCurve.AddKey(0.f, 0.f);
+	Curve->FloatCurve.AddKey(0.5f, 0.8f);
+	Curve->FloatCurve.AddKey(1.f, 1.f);
+	FGrapplingHookEasingTable CurveEasing;
+	CurveEasing.Bake(Curve);
+	FGrapplingHookEasingTable LinearEasing;
+	LinearEasing.Bake(nullptr);
+
+	FGrapplingHookUpdateParams Params;
+	Params.BreakDistance = 10000.f;
+	Params.RetractDistanceTollerance = 1.f;
+
+	TArray<FGrapplingHookUpdateInput> Inputs;
+	TArray<FGrapplingHookUpdateResult> Results;
+	Inputs.SetNum(NumRetracts);
+	Results.SetNum(NumRetracts);
+	const FGrapplingHookEasingTable* const Easings[] = { &LinearEasing, &CurveEasing };
+	const TCHAR* const EasingNames[] = { TEXT("linear"), TEXT("curve") };
+	for (int32 EasingIndex = 0; EasingIndex < 2; ++EasingIndex)
+	{
+		Params.RetractEasing = Easings[EasingIndex];
+		for (int32 Index = 0; Index < NumRetracts; ++Index)
+		{
+			//Staggered lengths and durations, the retracts end on different frames
+			FGrapplingHookUpdateInput& Input = Inputs[Index];
+			Input.State = EGrapplingHookState::GS_Retracting;
+			Input.DeltaTime = DeltaTime;
+			Input.StartLocation = FVector(0.f, 0.f, 100.f);
+			Input.RetractStartLocation = Input.StartLocation + FVector(500.f + Index, 0.f, 0.f);
+			Input.EndLocation = Input.RetractStartLocation;
+			Input.HookLocation = Input.RetractStartLocation;
+			Input.RetractClock = 0;
+			Input.RetractClockRate = FGrapplingHookRetractClock::GetRate(0.25f + (Index % 16) * 0.05f);
+		}
+
+		int32 Frames = 0;
+		int32 Active = NumRetracts;
+		const double Start = FPlatformTime::Seconds();
+		while (Active > 0 && Frames < 1000)
+		{
+			Active = 0;
+			for (int32 Index = 0; Index < NumRetracts; ++Index)
+			{
+				FGrapplingHookUpdateInput& Input = Inputs[Index];
+				if (Input.State != EGrapplingHookState::GS_Retracting)
+				{
+					continue;
+				}
+				FGrapplingHookUpdateResult& Result = Results[Index];
+				Input.Compute(Params, Result);
+				//Applied the same way as the component does
+				Input.RetractClock = Result.RetractClock;
+				Input.EndLocation += Result.RetractLocation - Input.HookLocation;
+				Input.HookLocation = Result.RetractLocation;
+				if (Result.bRetractOver || Result.RetractClock >= FGrapplingHookRetractClock::One)
+				{
+					Input.State = EGrapplingHookState::GS_Ready;
+				}
+				else
+				{
+					++Active;
+				}
+			}
+			++Frames;
+		}
+		const double Seconds = FPlatformTime::Seconds() - Start;
+		TestEqual(TEXT("All retracts end"), Active, 0);
+		UE_LOG(LogGrapplingHook, Display, TEXT("%d simultaneous retracts (%s easing): %d frames, %.3f ms per frame"),
+			NumRetracts, EasingNames[EasingIndex], Frames, Seconds * 1000.0 / FMath::Max(Frames, 1));
+	}
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
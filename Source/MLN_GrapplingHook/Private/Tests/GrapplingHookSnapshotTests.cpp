@@ -0,0 +1,117 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+#include "GrapplingHookSnapshot.h"
+#include "MLN_GrapplingHook.h"
+#include "Components/SceneComponent.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookSnapshotRingTest, "GrapplingHook.Snapshot.RingRestore", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookSnapshotRingTest::RunTest(const FString& Parameters)
+{
+	static const float DeltaTime = 1.f / 60.f;
+	static const int32 MaxLandingFrames = 60;
+	static const int32 RetractFrames = 3;
+
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector(0.f, 0.f, 300.f));
+	if (!TestNotNull(TEXT("Grappler"), Grappler))
+	{
+		return false;
+	}
+	Grappler->Activation = static_cast<uint8>(EGrapplingHookActivation::GA_Launch);
+	TestWorld.SpawnBox(FVector(600.f, 0.f, 300.f), FVector(20.f, 400.f, 400.f));
+	TArray<FGrapplingHookInstance>& Hooks = FGrapplingHookTestAccess::GetHooks(Grappler);
+
+	FGrapplingHookSnapshotRing Ring;
+	Ring.Init(8, Grappler->GetHookCount());
+
+	//The captured frame is the state the component is restored to, it is captured again after the restore and compared
+	const auto TestRestored = [this, Grappler, &Ring](const TCHAR* const What, const int32 FramesAgo)
+	{
+		int32 NumHooks = 0;
+		const FGrapplingHookSnapshot* const Frame = Ring.GetFrame(FramesAgo, NumHooks);
+		FGrapplingHookSnapshot Restored;
+		if (!TestNotNull(What, Frame) || !TestTrue(FString::Printf(TEXT("%s: hook captured"), What), NumHooks > 0 && Grappler->CaptureHookSnapshot(0, Restored)))
+		{
+			return;
+		}
+		TestEqual(FString::Printf(TEXT("%s: state"), What), Restored.State, Frame->State);
+		TestEqual(FString::Printf(TEXT("%s: state before retracting"), What), Restored.PreRetractingState, Frame->PreRetractingState);
+		TestEqual(FString::Printf(TEXT("%s: flags"), What), Restored.Flags, Frame->Flags);
+		TestTrue(FString::Printf(TEXT("%s: anchor"), What), Restored.Anchor == Frame->Anchor);
+		TestTrue(FString::Printf(TEXT("%s: hook location"), What), Restored.Location.Equals(Frame->Location, 0.01f));
+		TestTrue(FString::Printf(TEXT("%s: hook direction"), What), Restored.GetDirection().Equals(Frame->GetDirection(), 0.001f));
+		TestTrue(FString::Printf(TEXT("%s: retract start"), What), Restored.RetractStartLocation.Equals(Frame->RetractStartLocation));
+		TestEqual(FString::Printf(TEXT("%s: retract clock"), What), Restored.RetractClock, Frame->RetractClock);
+		TestEqual(FString::Printf(TEXT("%s: retract clock rate"), What), Restored.RetractClockRate, Frame->RetractClockRate);
+		TestEqual(FString::Printf(TEXT("%s: rope length"), What), Restored.RopeLength, Frame->RopeLength);
+		TestEqual(FString::Printf(TEXT("%s: cooldown"), What), Restored.CooldownRemaining, Frame->CooldownRemaining);
+	};
+
+	//Landed hook, launching the owner
+	Grappler->LaunchGrapple();
+	for (int32 Frame = 0; Frame < MaxLandingFrames && Hooks[0].CurrentState == EGrapplingHookState::GS_Extending; ++Frame)
+	{
+		TestWorld.Tick(DeltaTime);
+	}
+	if (!TestEqual(TEXT("Hook landed"), Hooks[0].CurrentState, EGrapplingHookState::GS_Launch))
+	{
+		return false;
+	}
+	Ring.Capture(*Grappler);
+
+	//Then retracting, one frame captured per tick
+	Grappler->StopGrapple();
+	for (int32 Frame = 0; Frame < RetractFrames; ++Frame)
+	{
+		TestWorld.Tick(DeltaTime);
+		Ring.Capture(*Grappler);
+	}
+	TestEqual(TEXT("Captured frames"), Ring.Num(), RetractFrames + 1);
+	TestEqual(TEXT("Hook retracting"), Hooks[0].CurrentState, EGrapplingHookState::GS_Retracting);
+
+	//Back to the landed hook, the anchor and the launch state are rebuilt
+	TestTrue(TEXT("Landed frame restored"), Ring.Restore(*Grappler, RetractFrames));
+	TestRestored(TEXT("Landed frame"), RetractFrames);
+	TestTrue(TEXT("Hook anchored again"), Hooks[0].Anchor.IsValid());
+
+	//Forward again to the latest retracting frame
+	TestTrue(TEXT("Latest frame restored"), Ring.Restore(*Grappler, 0));
+	TestRestored(TEXT("Latest frame"), 0);
+
+	//Rewound a frame at a time within the retract, as the rewind mechanic does every frame (the first restore within the retract is not measured)
+	Ring.Restore(*Grappler, 1);
+	Ring.Restore(*Grappler, 0);
+	int32 Allocations = 0;
+	bool bRestored = false;
+	{
+		FGrapplingHookAllocationCounter Counter;
+		bRestored = Ring.Restore(*Grappler, 1);
+		Allocations = Counter.GetAllocations();
+	}
+	TestTrue(TEXT("Previous frame restored"), bRestored);
+	TestRestored(TEXT("Previous frame"), 1);
+	TestEqual(TEXT("Allocations of a frame restore"), Allocations, 0);
+
+	//Restoring across an attachment change goes through the engine attachment, its allocations are only reported
+	{
+		FGrapplingHookAllocationCounter Counter;
+		Ring.Restore(*Grappler, RetractFrames);
+		Allocations = Counter.GetAllocations();
+	}
+	UE_LOG(LogGrapplingHook, Display, TEXT("Snapshot restore from retracting to landed: %d allocations"), Allocations);
+
+	//Rewinding drops the frames captured after the restored one
+	TestTrue(TEXT("Rewound to the landed frame"), Ring.Rewind(*Grappler, RetractFrames));
+	TestEqual(TEXT("Frames left after the rewind"), Ring.Num(), 1);
+	TestRestored(TEXT("Rewound frame"), 0);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
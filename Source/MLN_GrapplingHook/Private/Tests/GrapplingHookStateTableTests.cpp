@@ -0,0 +1,114 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+#include "GrapplingHookStateTable.h"
+#include "MLN_GrapplingHook.h"
+#include "ProjectileHook.h"
+#include "Engine/World.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookStateTableTest, "GrapplingHook.StateTable.Specialized", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookStateTableTest::RunTest(const FString& Parameters)
+{
+	const uint8 Masks[] = { static_cast<uint8>(EGrapplingHookActivation::GA_All), static_cast<uint8>(EGrapplingHookActivation::GA_Launch) };
+	for (const uint8 Mask : Masks)
+	{
+		const FGrapplingHookStateTable& Specialized = FGrapplingHookTestAccess::FindStateTable(Mask);
+		FGrapplingHookStateTable Dynamic;
+		FGrapplingHookTestAccess::BuildStateTable(Mask, Dynamic);
+		TestTrue(TEXT("Common masks use a specialized table"), Specialized.bSpecialized);
+		TestTrue(TEXT("Specialized update handler"), Specialized.UpdateHooks != Dynamic.UpdateHooks);
+		TestTrue(TEXT("Specialized exit handler"), Specialized.ExitHook != Dynamic.ExitHook);
+		for (int32 State = 0; State < FGrapplingHookStateTable::NumStates; ++State)
+		{
+			TestEqual(TEXT("Same enabled states"), Specialized.bEnabled[State], Dynamic.bEnabled[State]);
+			TestEqual(TEXT("Same interruptible states"), Specialized.bInterruptible[State], Dynamic.bInterruptible[State]);
+		}
+	}
+	TestFalse(TEXT("Launch only mask disables pull"), FGrapplingHookTestAccess::FindStateTable(static_cast<uint8>(EGrapplingHookActivation::GA_Launch)).bEnabled[static_cast<int32>(EGrapplingHookState::GS_Pull)]);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookStateDispatchBenchmark, "GrapplingHook.Benchmark.StateDispatch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FGrapplingHookStateDispatchBenchmark::RunTest(const FString& Parameters)
+{
+	static const int32 NumHooks = 1000;
+	static const int32 Iterations = 1000;
+	static const float DeltaTime = 1.f / 60.f;
+
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector::ZeroVector);
+	if (!TestNotNull(TEXT("Grappler"), Grappler))
+	{
+		return false;
+	}
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AProjectileHook* const Hook = TestWorld.GetWorld()->SpawnActor<AProjectileHook>(AProjectileHook::StaticClass(), FVector(0.f, 0.f, 500.f), FRotator::ZeroRotator, SpawnParams);
+	if (!TestNotNull(TEXT("Hook"), Hook))
+	{
+		return false;
+	}
+
+	//Launching hooks have an empty update handler: only the dispatch is measured
+	TArray<FGrapplingHookInstance>& Hooks = FGrapplingHookTestAccess::GetHooks(Grappler);
+	UCableComponent* const Cable = Hooks[0].Cable;
+	Hooks.SetNum(NumHooks);
+	for (FGrapplingHookInstance& Instance : Hooks)
+	{
+		Instance.Hook = Hook;
+		Instance.Cable = Cable;
+		Instance.CurrentState = EGrapplingHookState::GS_Launch;
+	}
+
+	const uint8 Mask = static_cast<uint8>(EGrapplingHookActivation::GA_All);
+	const FGrapplingHookStateTable& Specialized = FGrapplingHookTestAccess::FindStateTable(Mask);
+	FGrapplingHookStateTable Dynamic;
+	FGrapplingHookTestAccess::BuildStateTable(Mask, Dynamic);
+	//The switch based dispatch (no table) is the baseline
+	const FGrapplingHookStateTable* const Tables[] = { nullptr, &Dynamic, &Specialized };
+	double Seconds[3];
+	for (int32 TableIndex = 0; TableIndex < 3; ++TableIndex)
+	{
+		const FGrapplingHookStateTable* const Table = Tables[TableIndex];
+		auto Dispatch = [Grappler, Table]()
+		{
+			if (Table)
+			{
+				FGrapplingHookTestAccess::UpdateHooks(Grappler, *Table, DeltaTime);
+			}
+			else
+			{
+				FGrapplingHookTestAccess::UpdateHooksSwitch(Grappler, DeltaTime);
+			}
+		};
+		//Warm up, the update results are computed once per frame then reused
+		Dispatch();
+		const double Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Dispatch();
+		}
+		Seconds[TableIndex] = FPlatformTime::Seconds() - Start;
+	}
+	for (const FGrapplingHookInstance& Instance : Hooks)
+	{
+		TestEqual(TEXT("Launching hooks are not interrupted"), Instance.CurrentState, EGrapplingHookState::GS_Launch);
+	}
+	Hooks.SetNum(1);
+	Hooks[0].Hook = nullptr;
+	Hooks[0].CurrentState = EGrapplingHookState::GS_Ready;
+	Hook->Destroy();
+
+	const double Updates = static_cast<double>(NumHooks) * Iterations;
+	UE_LOG(LogGrapplingHook, Display, TEXT("State dispatch (%d hooks x %d updates): switch %.2f ns/hook, dynamic %.2f ns/hook, specialized %.2f ns/hook"),
+		NumHooks, Iterations, Seconds[0] * 1e9 / Updates, Seconds[1] * 1e9 / Updates, Seconds[2] * 1e9 / Updates);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,218 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+#include "MLN_GrapplingHook.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+#include "PhysicsEngine/PhysicsConstraintComponent.h"
+#include "GameFramework/Actor.h"
+
+namespace GrapplingHookSwingTests
+{
+	static const float Gravity = -980.f;
+	static const float RopeLength = 500.f;
+
+	/* Swings a rope pendulum released horizontally for the given time, with the swing frames of the given component (runtime substeps and order)
+	*@param OutEnergyDrift Energy change at the end of the swing, as a fraction of the energy of a fall of RopeLength
+	*@param OutMaxStretch Maximum length the rope was stretched by
+	*@param OutSubsteps Number of substeps the frames were split in
+	*/
+	static void SwingPendulum(UGrapplingHookComponent* const Grappler, const float FrameRate, const float Duration, float& OutEnergyDrift, float& OutMaxStretch, int32& OutSubsteps)
+	{
+		const float DeltaTime = 1.f / FrameRate;
+		const int32 Steps = FMath::RoundToInt(Duration * FrameRate);
+
+		TArray<FGrapplingHookSwingRope>& Ropes = FGrapplingHookTestAccess::GetSwingRopes(Grappler);
+		Ropes.Reset();
+		FGrapplingHookSwingRope& Rope = Ropes.AddDefaulted_GetRef();
+		Rope.LocalStart = FVector::ZeroVector;
+		Rope.Anchor = FVector::ZeroVector;
+		Rope.Length = RopeLength;
+		Rope.HookIndex = 0;
+		Rope.bConstrained = false;
+
+		FVector Location(RopeLength, 0.f, 0.f);
+		FVector Velocity = FVector::ZeroVector;
+		const float StartEnergy = -Gravity * Location.Z;
+		OutMaxStretch = 0.f;
+		OutSubsteps = 0;
+		for (int32 Step = 0; Step < Steps; ++Step)
+		{
+			OutSubsteps = FGrapplingHookTestAccess::SwingFrame(Grappler, Location, Velocity, Gravity, DeltaTime);
+			OutMaxStretch = FMath::Max(OutMaxStretch, Location.Size() - RopeLength);
+		}
+		Ropes.Reset();
+		const float Energy = 0.5f * Velocity.SizeSquared() - Gravity * Location.Z;
+		OutEnergyDrift = (Energy - StartEnergy) / (-Gravity * RopeLength);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookSwingEnergyTest, "GrapplingHook.Swing.EnergyDrift", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookSwingEnergyTest::RunTest(const FString& Parameters)
+{
+	using namespace GrapplingHookSwingTests;
+
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector::ZeroVector);
+	if (!TestNotNull(TEXT("Grappler"), Grappler))
+	{
+		return false;
+	}
+	Grappler->bSubstepSwing = true;
+
+	//Physics substepping as a project enables it, the low frame rates are split in several substeps
+	UPhysicsSettings* const Settings = UPhysicsSettings::Get();
+	const bool bPreviousSubstepping = Settings->bSubstepping;
+	const float PreviousMaxSubstepDeltaTime = Settings->MaxSubstepDeltaTime;
+	const int32 PreviousMaxSubsteps = Settings->MaxSubsteps;
+	Settings->bSubstepping = true;
+	Settings->MaxSubstepDeltaTime = 1.f / 60.f;
+	Settings->MaxSubsteps = 6;
+
+	const float FrameRates[] = { 20.f, 60.f, 144.f };
+	float MinDrift = BIG_NUMBER;
+	float MaxDrift = -BIG_NUMBER;
+	for (const float FrameRate : FrameRates)
+	{
+		float Drift;
+		float Stretch;
+		int32 Substeps;
+		SwingPendulum(Grappler, FrameRate, 10.f, Drift, Stretch, Substeps);
+		TestTrue(FString::Printf(TEXT("Energy drift after 10 s at %.0f Hz (%d substeps) is %.4f"), FrameRate, Substeps, Drift), FMath::Abs(Drift) <= 0.05f);
+		TestTrue(FString::Printf(TEXT("Rope stretch at %.0f Hz (%d substeps) is %.2f"), FrameRate, Substeps, Stretch), Stretch <= RopeLength * 0.02f);
+		MinDrift = FMath::Min(MinDrift, Drift);
+		MaxDrift = FMath::Max(MaxDrift, Drift);
+		if (FrameRate < 60.f)
+		{
+			TestTrue(FString::Printf(TEXT("%.0f Hz frames are substepped"), FrameRate), Substeps > 1);
+		}
+	}
+
+	Settings->bSubstepping = bPreviousSubstepping;
+	Settings->MaxSubstepDeltaTime = PreviousMaxSubstepDeltaTime;
+	Settings->MaxSubsteps = PreviousMaxSubsteps;
+
+	//The stretch correction is a rate per second, the swing does not get stiffer or softer with the frame rate
+	TestTrue(FString::Printf(TEXT("Energy drift spread between frame rates is %.4f"), MaxDrift - MinDrift), MaxDrift - MinDrift <= 0.03f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookReelBenchmark, "GrapplingHook.Benchmark.Reel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FGrapplingHookReelBenchmark::RunTest(const FString& Parameters)
+{
+	static const int32 NumRopes = 8;
+	static const int32 Frames = 20000;
+	static const int32 Substeps = 4;
+	static const int32 ReelFrames = 60;
+	static const float DeltaTime = 1.f / 60.f;
+
+	FGrapplingHookTestWorld TestWorld;
+	UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(FVector::ZeroVector);
+	if (!TestNotNull(TEXT("Grappler"), Grappler))
+	{
+		return false;
+	}
+	Grappler->ReelInSpeed = 500.f;
+	Grappler->ReelOutSpeed = 500.f;
+	Grappler->MinRopeLength = 100.f;
+	Grappler->BreakDistance = 5000.f;
+
+	//Swinging hooks anchored around the owner, solved together as in the multiple ropes path
+	TArray<FGrapplingHookInstance>& Hooks = FGrapplingHookTestAccess::GetHooks(Grappler);
+	TArray<FGrapplingHookSwingRope>& Ropes = FGrapplingHookTestAccess::GetSwingRopes(Grappler);
+	Hooks.SetNum(NumRopes);
+	Ropes.SetNum(NumRopes);
+	for (int32 Index = 0; Index < NumRopes; ++Index)
+	{
+		Hooks[Index].CurrentState = EGrapplingHookState::GS_Swing;
+		Hooks[Index].bActivatedSwing = true;
+		Hooks[Index].RopeLength = 1000.f;
+		FGrapplingHookSwingRope& Rope = Ropes[Index];
+		Rope.LocalStart = FVector::ZeroVector;
+		Rope.Anchor = FRotator(60.f, Index * 360.f / NumRopes, 0.f).Vector() * 1000.f;
+		Rope.Length = 1000.f;
+		Rope.HookIndex = Index;
+		Rope.bConstrained = false;
+	}
+
+	//The first rope is held by the swing constraint in the last phase, its frame is moved with its reeled length
+	AActor* const AnchorBox = TestWorld.SpawnBox(Ropes[0].Anchor, FVector(20.f));
+	UPrimitiveComponent* const AnchorComponent = AnchorBox ? Cast<UPrimitiveComponent>(AnchorBox->GetRootComponent()) : nullptr;
+	if (!TestNotNull(TEXT("Anchor"), AnchorComponent))
+	{
+		return false;
+	}
+
+	const FTransform BodyTransform(FVector::ZeroVector);
+	const FVector Velocity(0.f, 300.f, 0.f);
+	static const int32 NumPhases = 3;
+	const TCHAR* const PhaseNames[] = { TEXT("fixed length"), TEXT("reeling"), TEXT("reeling constrained") };
+	double Seconds[NumPhases][2];
+	for (int32 Phase = 0; Phase < NumPhases; ++Phase)
+	{
+		float FrameLength = 0.f;
+		if (Phase == 2)
+		{
+			Ropes[0].Length = 1000.f;
+			Hooks[0].RopeLength = 1000.f;
+			Hooks[0].GrappledObject = AnchorComponent;
+			FGrapplingHookTestAccess::LandHook(Grappler, 0, EGrapplingHookState::GS_Swing, AnchorComponent, Ropes[0].Anchor);
+			FGrapplingHookTestAccess::ConstrainSwing(Grappler, 0);
+			Ropes[0].bConstrained = true;
+			const UPhysicsConstraintComponent* const Constraint = Grappler->GetSwingConstraintComponent();
+			if (!TestNotNull(TEXT("Swing constraint"), Constraint))
+			{
+				return false;
+			}
+			FrameLength = Constraint->ConstraintInstance.Pos2.Size();
+		}
+		for (int32 Half = 0; Half < 2; ++Half)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < Frames / 2; ++Frame)
+			{
+				//Reels in then out continuously, the ropes never reach MinRopeLength or BreakDistance
+				if (Phase > 0)
+				{
+					Grappler->ReelRope((Frame / ReelFrames) % 2 == 0 ? 1.f : -1.f);
+				}
+				FGrapplingHookTestAccess::StepSwingFrame(Grappler, BodyTransform, Velocity, DeltaTime, Substeps);
+			}
+			Seconds[Phase][Half] = FPlatformTime::Seconds() - Start;
+		}
+		if (Phase > 0)
+		{
+			TestNotEqual(TEXT("Reeled rope length"), Ropes[0].Length, 1000.f);
+			TestTrue(TEXT("Reeled rope within the length limits"), Ropes[0].Length > Grappler->MinRopeLength && Ropes[0].Length < Grappler->BreakDistance);
+		}
+		if (Phase == 2)
+		{
+			//Lengths reeled by the last frame substeps are stored, and the frame moved, by the next frame
+			Grappler->ReelRope(0.f);
+			FGrapplingHookTestAccess::StepSwingFrame(Grappler, BodyTransform, Velocity, DeltaTime, Substeps);
+			const float FrameMove = Grappler->GetSwingConstraintComponent()->ConstraintInstance.Pos2.Size() - FrameLength;
+			TestTrue(FString::Printf(TEXT("Constraint frame moved with the reeled length (%.2f for %.2f)"), FrameMove, Hooks[0].RopeLength - 1000.f), FMath::IsNearlyEqual(FrameMove, Hooks[0].RopeLength - 1000.f, 1.f));
+		}
+	}
+	FGrapplingHookTestAccess::ReleaseSwingConstraint(Grappler);
+	Ropes.Reset();
+	Hooks.SetNum(1);
+	Hooks[0].GrappledObject = nullptr;
+	Hooks[0].Anchor.Reset();
+	Hooks[0].CurrentState = EGrapplingHookState::GS_Ready;
+	Hooks[0].bActivatedSwing = false;
+
+	for (int32 Phase = 0; Phase < NumPhases; ++Phase)
+	{
+		UE_LOG(LogGrapplingHook, Display, TEXT("Swing reel (%d ropes x %d substeps) %s: %.2f ns/frame first half, %.2f ns/frame second half"),
+			NumRopes, Substeps, PhaseNames[Phase], Seconds[Phase][0] * 2e9 / Frames, Seconds[Phase][1] * 2e9 / Frames);
+	}
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,52 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GrapplingHookTelemetry.h"
+#include "MLN_GrapplingHook.h"
+#include "HAL/IConsoleManager.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookTelemetryBenchmark, "GrapplingHook.Benchmark.Telemetry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+bool FGrapplingHookTelemetryBenchmark::RunTest(const FString& Parameters)
+{
+	static const int32 Iterations = 100000;
+	static const int32 EventsPerIteration = 6;
+	//Events must stay cheap enough to be recorded in shipping builds
+	static const double MaxNanosecondsPerEvent = 1000.0;
+
+	IConsoleVariable* const TelemetryVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("GrapplingHook.Telemetry"));
+	if (!TestNotNull(TEXT("Telemetry console variable"), TelemetryVariable))
+	{
+		return false;
+	}
+	const int32 PreviousTelemetry = TelemetryVariable->GetInt();
+	TelemetryVariable->Set(1, ECVF_SetByCode);
+	TestTrue(TEXT("Telemetry enabled"), FGrapplingHookTelemetry::IsEnabled());
+
+	//First event of the thread allocates its counters, it is not part of the measure
+	FGrapplingHookTelemetry::RecordLaunch();
+
+	const double Start = FPlatformTime::Seconds();
+	for (int32 Event = 0; Event < Iterations; ++Event)
+	{
+		const EGrapplingHookState State = static_cast<EGrapplingHookState>(Event % static_cast<int32>(EGrapplingHookState::GS_MAX));
+		FGrapplingHookTelemetry::RecordStateEnter(State);
+		FGrapplingHookTelemetry::RecordStateExit(State, (Event % 2000) * 0.001);
+		FGrapplingHookTelemetry::RecordLaunch();
+		FGrapplingHookTelemetry::RecordLaunchDistance(static_cast<float>(Event % 5000));
+		FGrapplingHookTelemetry::RecordCooldown((Event % 100) * 0.01f);
+		FGrapplingHookTelemetry::RecordError(static_cast<EGrapplingHookError>(Event % static_cast<int32>(EGrapplingHookError::GE_MAX)));
+	}
+	const int32 NumEvents = Iterations * EventsPerIteration;
+	const double Nanoseconds = (FPlatformTime::Seconds() - Start) * 1e9 / NumEvents;
+	TelemetryVariable->Set(PreviousTelemetry, ECVF_SetByCode);
+
+	UE_LOG(LogGrapplingHook, Display, TEXT("Telemetry (%d events): %.2f ns/event"), NumEvents, Nanoseconds);
+	TestTrue(FString::Printf(TEXT("Telemetry event cost %.2f ns is below %.0f ns"), Nanoseconds, MaxNanosecondsPerEvent), Nanoseconds < MaxNanosecondsPerEvent);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
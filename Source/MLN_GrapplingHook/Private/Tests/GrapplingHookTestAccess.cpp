@@ -0,0 +1,174 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "Tests/GrapplingHookTestAccess.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "../Plugins/Runtime/CableComponent/Source/CableComponent/Classes/CableComponent.h"
+
+FGrapplingHookAllocationCounter::FGrapplingHookAllocationCounter()
+	: Inner(GMalloc)
+	, ThreadId(FPlatformTLS::GetCurrentThreadId())
+	, Allocations(0)
+{
+	GMalloc = this;
+}
+FGrapplingHookAllocationCounter::~FGrapplingHookAllocationCounter()
+{
+	GMalloc = Inner;
+}
+int32 FGrapplingHookAllocationCounter::GetAllocations() const
+{
+	return Allocations;
+}
+void FGrapplingHookAllocationCounter::CountAllocation()
+{
+	//Other threads keep allocating while the counted code runs, only the counted thread is measured
+	if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+	{
+		++Allocations;
+	}
+}
+void* FGrapplingHookAllocationCounter::Malloc(SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation();
+	return Inner->Malloc(Count, Alignment);
+}
+void* FGrapplingHookAllocationCounter::TryMalloc(SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation();
+	return Inner->TryMalloc(Count, Alignment);
+}
+void* FGrapplingHookAllocationCounter::Realloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation();
+	return Inner->Realloc(Original, Count, Alignment);
+}
+void* FGrapplingHookAllocationCounter::TryRealloc(void* Original, SIZE_T Count, uint32 Alignment)
+{
+	CountAllocation();
+	return Inner->TryRealloc(Original, Count, Alignment);
+}
+void FGrapplingHookAllocationCounter::Free(void* Original)
+{
+	Inner->Free(Original);
+}
+SIZE_T FGrapplingHookAllocationCounter::QuickSize(SIZE_T Count, uint32 Alignment)
+{
+	return Inner->QuickSize(Count, Alignment);
+}
+bool FGrapplingHookAllocationCounter::GetAllocationSize(void* Original, SIZE_T& SizeOut)
+{
+	return Inner->GetAllocationSize(Original, SizeOut);
+}
+void FGrapplingHookAllocationCounter::Trim()
+{
+	Inner->Trim();
+}
+void FGrapplingHookAllocationCounter::SetupTLSCachesOnCurrentThread()
+{
+	Inner->SetupTLSCachesOnCurrentThread();
+}
+void FGrapplingHookAllocationCounter::ClearAndDisableTLSCachesOnCurrentThread()
+{
+	Inner->ClearAndDisableTLSCachesOnCurrentThread();
+}
+void FGrapplingHookAllocationCounter::UpdateStats()
+{
+	Inner->UpdateStats();
+}
+void FGrapplingHookAllocationCounter::GetAllocatorStats(FGenericMemoryStats& OutStats)
+{
+	Inner->GetAllocatorStats(OutStats);
+}
+void FGrapplingHookAllocationCounter::DumpAllocatorStats(FOutputDevice& Ar)
+{
+	Inner->DumpAllocatorStats(Ar);
+}
+bool FGrapplingHookAllocationCounter::IsInternallyThreadSafe() const
+{
+	return Inner->IsInternallyThreadSafe();
+}
+bool FGrapplingHookAllocationCounter::ValidateHeap()
+{
+	return Inner->ValidateHeap();
+}
+const TCHAR* FGrapplingHookAllocationCounter::GetDescriptiveName()
+{
+	return Inner->GetDescriptiveName();
+}
+
+FGrapplingHookTestWorld::FGrapplingHookTestWorld()
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	Context.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+}
+FGrapplingHookTestWorld::~FGrapplingHookTestWorld()
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+}
+UWorld* FGrapplingHookTestWorld::GetWorld() const
+{
+	return World;
+}
+UGrapplingHookComponent* FGrapplingHookTestWorld::SpawnGrappler(const FVector& Location)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ACharacter* const Character = World->SpawnActor<ACharacter>(ACharacter::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+	if (!Character)
+	{
+		return nullptr;
+	}
+	//Spawned characters have no controller, their movement would not run without it
+	Character->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+
+	UCableComponent* const Cable = NewObject<UCableComponent>(Character, TEXT("TestCable"));
+	Cable->SetupAttachment(Character->GetCapsuleComponent());
+	Cable->RegisterComponent();
+
+	//Registered on an actor that already begun play: the component begins play and initializes from its owner here
+	UGrapplingHookComponent* const Grappler = NewObject<UGrapplingHookComponent>(Character, TEXT("TestGrappler"));
+	Grappler->bDeferInitialization = false;
+	Grappler->RegisterComponent();
+	return Grappler;
+}
+AActor* FGrapplingHookTestWorld::SpawnBox(const FVector& Location, const FVector& Size)
+{
+	UStaticMesh* const Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AStaticMeshActor* const Actor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator, SpawnParams);
+	if (Actor)
+	{
+		//Engine cube, 100 units wide
+		UStaticMeshComponent* const Mesh = Actor->GetStaticMeshComponent();
+		Mesh->SetMobility(EComponentMobility::Movable);
+		Mesh->SetStaticMesh(Cube);
+		Mesh->SetWorldScale3D(Size / 100.f);
+	}
+	return Actor;
+}
+void FGrapplingHookTestWorld::Tick(const float DeltaTime, const int32 Frames)
+{
+	for (int32 Frame = 0; Frame < Frames; ++Frame)
+	{
+		//Per frame caches (update compute results, aim assist) are keyed on the frame counter, advanced by the engine loop outside of tests
+		++GFrameCounter;
+		World->Tick(ELevelTick::LEVELTICK_All, DeltaTime);
+	}
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,294 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/MemoryBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GrapplingHookComponent.h"
+#include "GrapplingHookStateTable.h"
+
+class UWorld;
+
+/*
+* Access to the internals of UGrapplingHookComponent used by the automation tests of the plugin
+*/
+struct FGrapplingHookTestAccess
+{
+	static TArray<FGrapplingHookInstance>& GetHooks(UGrapplingHookComponent* const Grappler)
+	{
+		return Grappler->Hooks;
+	}
+	static const FGrapplingHookStateTable& FindStateTable(const uint8 Mask)
+	{
+		return UGrapplingHookComponent::FindStateTable(Mask);
+	}
+	static void BuildStateTable(const uint8 Mask, FGrapplingHookStateTable& OutTable)
+	{
+		UGrapplingHookComponent::BuildStateTable(Mask, OutTable);
+	}
+	static void BuildHookCollisionResponses(const UGrapplingHookComponent* const Grappler, FCollisionResponseContainer& OutResponses)
+	{
+		Grappler->BuildHookCollisionResponses(OutResponses);
+	}
+	static FVector SolveSwingRopeVelocity(const FTransform& BodyTransform, const FVector& Velocity, const TArray<FGrapplingHookSwingRope>& Ropes, const float DeltaTime)
+	{
+		return UGrapplingHookComponent::SolveSwingRopeVelocity(BodyTransform, Velocity, Ropes, DeltaTime);
+	}
+	static TArray<FGrapplingHookSwingRope>& GetSwingRopes(UGrapplingHookComponent* const Grappler)
+	{
+		return Grappler->SubstepSwingRopes;
+	}
+	/* Runs the reel and rope steps of a swinging frame of the given component, split in the given number of substeps
+	*/
+	static FVector StepSwingFrame(UGrapplingHookComponent* const Grappler, const FTransform& BodyTransform, const FVector& Velocity, const float DeltaTime, const int32 Substeps)
+	{
+		Grappler->BeginSwingReel();
+		FVector NewVelocity = Velocity;
+		for (int32 Substep = 0; Substep < Substeps; ++Substep)
+		{
+			NewVelocity = Grappler->StepSwingRopes(BodyTransform, NewVelocity, DeltaTime / Substeps);
+		}
+		return NewVelocity;
+	}
+	/* Runs a swinging frame of the given component as the physics scene does: split in the runtime substeps, each one solving the ropes, then applying gravity and moving the body
+	*@return Number of substeps the frame was split in
+	*/
+	static int32 SwingFrame(UGrapplingHookComponent* const Grappler, FVector& InOutLocation, FVector& InOutVelocity, const float GravityZ, const float DeltaTime)
+	{
+		float SubstepTime = DeltaTime;
+		const int32 Substeps = Grappler->GetSwingSubsteps(DeltaTime, SubstepTime);
+		Grappler->BeginSwingReel();
+		for (int32 Substep = 0; Substep < Substeps; ++Substep)
+		{
+			InOutVelocity = Grappler->StepSwingRopes(FTransform(InOutLocation), InOutVelocity, SubstepTime);
+			InOutVelocity.Z += GravityZ * SubstepTime;
+			InOutLocation += InOutVelocity * SubstepTime;
+		}
+		return Substeps;
+	}
+	/* Constrains the owner to the given swinging hook with the swing constraint, as a single swinging rope does
+	*/
+	static void ConstrainSwing(UGrapplingHookComponent* const Grappler, const int32 HookIndex)
+	{
+		Grappler->ConstrainSwing(HookIndex);
+	}
+	static void ReleaseSwingConstraint(UGrapplingHookComponent* const Grappler)
+	{
+		Grappler->ReleaseSwingConstraint();
+	}
+	static void StepDeterministicOwner(FGrapplingHookFixedVector& InOutLocation, FGrapplingHookFixedVector& InOutVelocity, const FGrapplingHookFixedVector& Acceleration, const TArray<FGrapplingHookFixedRope>& Ropes, const FGrapplingHookFixed Step)
+	{
+		UGrapplingHookComponent::StepDeterministicOwner(InOutLocation, InOutVelocity, Acceleration, Ropes, Step);
+	}
+	/* Runs a single deterministic simulation step of the given component, outside of its tick
+	*/
+	static void StepDeterministic(UGrapplingHookComponent* const Grappler, const float StepTime)
+	{
+		Grappler->StepDeterministic(StepTime, false);
+	}
+	/* Puts the given hook in the given landed state, anchored to the given component at the given location (the hook flight is skipped)
+	*/
+	static void LandHook(UGrapplingHookComponent* const Grappler, const int32 HookIndex, const EGrapplingHookState State, USceneComponent* const Anchor, const FVector& Location)
+	{
+		FGrapplingHookInstance& Instance = Grappler->Hooks[HookIndex];
+		Instance.CurrentState = State;
+		Instance.Anchor = Anchor;
+		Instance.AnchorRelativeLocation = Anchor->GetComponentTransform().InverseTransformPosition(Location);
+		Instance.AnchorLocation = Location;
+	}
+	static void UpdateRopeCollision(UGrapplingHookComponent* const Grappler, const int32 HookIndex, const int32 MaxSweeps)
+	{
+		Grappler->UpdateRopeCollision(HookIndex, MaxSweeps);
+	}
+	/* Ends the cooldown of the given hook, as its cooldown timer does
+	*/
+	static void EnableHook(UGrapplingHookComponent* const Grappler, const int32 HookIndex)
+	{
+		Grappler->OnEnableHook(HookIndex);
+	}
+	/* Spawns the hook actor of the given hook, as a launch does (lazy cables are created here)
+	*/
+	static AProjectileHook* SpawnHook(UGrapplingHookComponent* const Grappler, const int32 HookIndex)
+	{
+		return Grappler->SpawnHook(HookIndex);
+	}
+	/* Creates the lazy audio component, as the first sound played does
+	*/
+	static void CreateLazyAudio(UGrapplingHookComponent* const Grappler)
+	{
+		Grappler->CreateLazyAudio();
+	}
+	static void ScheduleLazyRelease(UGrapplingHookComponent* const Grappler)
+	{
+		Grappler->ScheduleLazyRelease();
+	}
+	static void DestroyLazySubobjects(UGrapplingHookComponent* const Grappler)
+	{
+		Grappler->DestroyLazySubobjects();
+	}
+	static const FGrapplingHookAimAssist& GetAimAssist(const UGrapplingHookComponent* const Grappler)
+	{
+		return Grappler->AimAssist;
+	}
+	/* Updates all the hooks of the given component with the UpdateHooks handler of the given table
+	*/
+	static void UpdateHooks(UGrapplingHookComponent* const Grappler, const FGrapplingHookStateTable& Table, const float DeltaTime)
+	{
+		Grappler->StateTable = &Table;
+		(Grappler->*Table.UpdateHooks)(DeltaTime);
+	}
+	/* Updates all the hooks of the given component with the switch based dispatch the state tables replaced (state and Activation bits tested for every hook), kept as benchmark baseline
+	*/
+	static void UpdateHooksSwitch(UGrapplingHookComponent* const Grappler, const float DeltaTime)
+	{
+		for (int32 HookIndex = 0; HookIndex < Grappler->Hooks.Num(); ++HookIndex)
+		{
+			switch (Grappler->Hooks[HookIndex].CurrentState)
+			{
+			case EGrapplingHookState::GS_Launch:
+			case EGrapplingHookState::GS_Pull:
+			case EGrapplingHookState::GS_Tug:
+			case EGrapplingHookState::GS_Swing:
+			case EGrapplingHookState::GS_Retracting:
+			case EGrapplingHookState::GS_Missed:
+				break;
+			case EGrapplingHookState::GS_Ready:
+			case EGrapplingHookState::GS_Disabled:
+			case EGrapplingHookState::GS_Extending:
+			default:
+				continue;
+			}
+
+			const FGrapplingHookInstance& Instance = Grappler->Hooks[HookIndex];
+			if (!Instance.Hook || !Grappler->Owner || !Instance.Cable)
+			{
+				Grappler->ReportError(EGrapplingHookError::GE_UpdateCore);
+				Grappler->StopGrappleAt(HookIndex);
+			}
+			if (Grappler->GetHookUpdate(HookIndex, DeltaTime).bBreak)
+			{
+				Grappler->StopGrappleAt(HookIndex);
+				Grappler->OnGrappleBreaked.Broadcast();
+			}
+
+			switch (Grappler->Hooks[HookIndex].CurrentState)
+			{
+			case EGrapplingHookState::GS_Launch:
+				if (Grappler->IsUFlagSet(Grappler->Activation, EGrapplingHookActivation::GA_Launch))
+				{
+					Grappler->UpdateLaunchState(HookIndex, DeltaTime);
+				}
+				else
+				{
+					Grappler->UpdateInvalidState(HookIndex, DeltaTime);
+				}
+				break;
+			case EGrapplingHookState::GS_Pull:
+				if (Grappler->IsUFlagSet(Grappler->Activation, EGrapplingHookActivation::GA_Pull))
+				{
+					Grappler->UpdatePullState(HookIndex, DeltaTime);
+				}
+				else
+				{
+					Grappler->UpdateInvalidState(HookIndex, DeltaTime);
+				}
+				break;
+			case EGrapplingHookState::GS_Tug:
+				if (Grappler->IsUFlagSet(Grappler->Activation, EGrapplingHookActivation::GA_Pull))
+				{
+					Grappler->UpdateTugState(HookIndex, DeltaTime);
+				}
+				else
+				{
+					Grappler->UpdateInvalidState(HookIndex, DeltaTime);
+				}
+				break;
+			case EGrapplingHookState::GS_Swing:
+				if (Grappler->IsUFlagSet(Grappler->Activation, EGrapplingHookActivation::GA_Swing))
+				{
+					Grappler->UpdateSwingState(HookIndex, DeltaTime);
+				}
+				else
+				{
+					Grappler->UpdateInvalidState(HookIndex, DeltaTime);
+				}
+				break;
+			case EGrapplingHookState::GS_Retracting:
+				Grappler->UpdateRetractState(HookIndex, DeltaTime);
+				break;
+			case EGrapplingHookState::GS_Missed:
+				Grappler->UpdateInvalidState(HookIndex, DeltaTime);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+};
+
+/*
+* Counts the allocations made by the thread that created it while it is alive, by putting itself in front of GMalloc
+*/
+class FGrapplingHookAllocationCounter : public FMalloc
+{
+public:
+	FGrapplingHookAllocationCounter();
+	virtual ~FGrapplingHookAllocationCounter();
+
+	/* Returns the number of Malloc and Realloc calls of the counted thread so far
+	*/
+	int32 GetAllocations() const;
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override;
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override;
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override;
+	virtual void Free(void* Original) override;
+	virtual SIZE_T QuickSize(SIZE_T Count, uint32 Alignment) override;
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override;
+	virtual void Trim() override;
+	virtual void SetupTLSCachesOnCurrentThread() override;
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
+	virtual void UpdateStats() override;
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override;
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override;
+	virtual bool IsInternallyThreadSafe() const override;
+	virtual bool ValidateHeap() override;
+	virtual const TCHAR* GetDescriptiveName() override;
+
+private:
+	void CountAllocation();
+
+	FMalloc* const Inner;
+	const uint32 ThreadId;
+	int32 Allocations;
+};
+
+/*
+* Game world created for the duration of an automation test
+*/
+class FGrapplingHookTestWorld
+{
+public:
+	FGrapplingHookTestWorld();
+	~FGrapplingHookTestWorld();
+
+	UWorld* GetWorld() const;
+	/* Spawns a character with a cable and a grappling hook component initialized from it
+	*/
+	UGrapplingHookComponent* SpawnGrappler(const FVector& Location);
+	/* Spawns a static box of the given size (engine cube scaled), used as floor, wall or grapple target
+	*/
+	AActor* SpawnBox(const FVector& Location, const FVector& Size);
+	/* Ticks the world the given number of frames
+	*/
+	void Tick(const float DeltaTime, const int32 Frames = 1);
+
+private:
+	UWorld* World;
+};
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,200 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GrapplingHookTimerWheel.h"
+
+namespace
+{
+	static const float WheelResolution = 0.01f;
+	//One delay per wheel level (64, 64^2 and 64^3 ticks are the level spans at this resolution)
+	static const float LevelDelays[] = { 0.3f, 5.f, 100.f, 5000.f };
+	static const int32 NumLevelDelays = ARRAY_COUNT(LevelDelays);
+
+	FSimpleDelegate RecordFireTime(const FGrapplingHookTimerWheel& Wheel, double& OutFireTime, int32& OutFireCount)
+	{
+		return FSimpleDelegate::CreateLambda([&Wheel, &OutFireTime, &OutFireCount]()
+		{
+			OutFireTime = Wheel.GetTime();
+			++OutFireCount;
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookTimerWheelCascadeTest, "GrapplingHook.TimerWheel.Cascade", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookTimerWheelCascadeTest::RunTest(const FString& Parameters)
+{
+	//Stepped frame by frame, every timer is cascaded down from its level and fires on its own tick
+	{
+		FGrapplingHookTimerWheel Wheel(WheelResolution);
+		double FireTimes[NumLevelDelays];
+		int32 FireCounts[NumLevelDelays];
+		for (int32 Index = 0; Index < NumLevelDelays; ++Index)
+		{
+			FireTimes[Index] = -1.0;
+			FireCounts[Index] = 0;
+			Wheel.SetTimer(RecordFireTime(Wheel, FireTimes[Index], FireCounts[Index]), LevelDelays[Index]);
+		}
+		TestEqual(TEXT("Scheduled timers"), Wheel.GetNumActiveTimers(), NumLevelDelays);
+
+		const float Step = 1.f / 60.f;
+		while (Wheel.GetTime() < LevelDelays[NumLevelDelays - 1] + 1.f)
+		{
+			Wheel.Advance(Step);
+		}
+		for (int32 Index = 0; Index < NumLevelDelays; ++Index)
+		{
+			TestEqual(FString::Printf(TEXT("%.1f s timer fired once"), LevelDelays[Index]), FireCounts[Index], 1);
+			//Never early, and late by at most the frame that crossed the expire tick
+			TestTrue(FString::Printf(TEXT("%.1f s timer fired at %.4f s"), LevelDelays[Index], FireTimes[Index]),
+				FireTimes[Index] >= LevelDelays[Index] - KINDA_SMALL_NUMBER && FireTimes[Index] <= LevelDelays[Index] + Step + WheelResolution);
+		}
+		TestEqual(TEXT("Expired timers are released"), Wheel.GetNumActiveTimers(), 0);
+	}
+
+	//A single long advance crosses every level boundary at once, timers still fire in expiry order
+	{
+		FGrapplingHookTimerWheel Wheel(WheelResolution);
+		TArray<int32> Order;
+		for (int32 Index = NumLevelDelays - 1; Index >= 0; --Index)
+		{
+			Wheel.SetTimer(FSimpleDelegate::CreateLambda([&Order, Index]() { Order.Add(Index); }), LevelDelays[Index]);
+		}
+		Wheel.Advance(LevelDelays[NumLevelDelays - 1] + 1.f);
+		TestEqual(TEXT("All timers fired in a single advance"), Order.Num(), NumLevelDelays);
+		for (int32 Index = 0; Index < Order.Num(); ++Index)
+		{
+			TestEqual(FString::Printf(TEXT("Timer %d fired in expiry order"), Index), Order[Index], Index);
+		}
+	}
+
+	//Timers scheduled later than the current tick of a higher level slot are not fired with it
+	{
+		FGrapplingHookTimerWheel Wheel(WheelResolution);
+		Wheel.Advance(0.63f);
+		double FireTime = -1.0;
+		int32 FireCount = 0;
+		Wheel.SetTimer(RecordFireTime(Wheel, FireTime, FireCount), 0.02f);
+		Wheel.Advance(0.01f);
+		TestEqual(TEXT("Timer crossing a level 0 wrap did not fire early"), FireCount, 0);
+		Wheel.Advance(0.02f);
+		TestEqual(TEXT("Timer crossing a level 0 wrap fired"), FireCount, 1);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookTimerWheelCancelTest, "GrapplingHook.TimerWheel.Cancel", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookTimerWheelCancelTest::RunTest(const FString& Parameters)
+{
+	FGrapplingHookTimerWheel Wheel(WheelResolution);
+	double FireTimes[NumLevelDelays];
+	int32 FireCounts[NumLevelDelays];
+	FGrapplingHookTimerHandle Handles[NumLevelDelays];
+	for (int32 Index = 0; Index < NumLevelDelays; ++Index)
+	{
+		FireTimes[Index] = -1.0;
+		FireCounts[Index] = 0;
+		Handles[Index] = Wheel.SetTimer(RecordFireTime(Wheel, FireTimes[Index], FireCounts[Index]), LevelDelays[Index]);
+	}
+
+	//Cancelled before any cascade, and after the higher level timers were cascaded down at least once
+	Wheel.ClearTimer(Handles[0]);
+	TestFalse(TEXT("Cleared handle is invalidated"), Handles[0].IsValid());
+	Wheel.Advance(90.f);
+	TestEqual(TEXT("Level 1 timer fired"), FireCounts[1], 1);
+	const FGrapplingHookTimerHandle StaleHandle = Handles[2];
+	Wheel.ClearTimer(Handles[3]);
+	Wheel.ClearTimer(Handles[2]);
+	TestEqual(TEXT("No timer left after cancels"), Wheel.GetNumActiveTimers(), 0);
+
+	//The released slot is reused, the stale handle must not reach the new timer
+	double ReusedFireTime = -1.0;
+	int32 ReusedFireCount = 0;
+	const FGrapplingHookTimerHandle Reused = Wheel.SetTimer(RecordFireTime(Wheel, ReusedFireTime, ReusedFireCount), 1.f);
+	TestFalse(TEXT("Stale handle is not active"), Wheel.IsTimerActive(StaleHandle));
+	FGrapplingHookTimerHandle StaleCopy = StaleHandle;
+	Wheel.ClearTimer(StaleCopy);
+	TestTrue(TEXT("Clearing a stale handle keeps the reused timer"), Wheel.IsTimerActive(Reused));
+
+	Wheel.Advance(LevelDelays[NumLevelDelays - 1]);
+	TestEqual(TEXT("Cancelled level 0 timer did not fire"), FireCounts[0], 0);
+	TestEqual(TEXT("Cancelled level 2 timer did not fire"), FireCounts[2], 0);
+	TestEqual(TEXT("Cancelled level 3 timer did not fire"), FireCounts[3], 0);
+	TestEqual(TEXT("Reused timer fired"), ReusedFireCount, 1);
+
+	//Clearing from inside a callback cancels a timer expiring later in the same advance
+	FGrapplingHookTimerHandle Second;
+	int32 SecondFireCount = 0;
+	Wheel.SetTimer(FSimpleDelegate::CreateLambda([&Wheel, &Second]() { Wheel.ClearTimer(Second); }), 0.05f);
+	Second = Wheel.SetTimer(FSimpleDelegate::CreateLambda([&SecondFireCount]() { ++SecondFireCount; }), 0.1f);
+	Wheel.Advance(1.f);
+	TestEqual(TEXT("Timer cleared by a timer of the same advance did not fire"), SecondFireCount, 0);
+	TestEqual(TEXT("No timer left"), Wheel.GetNumActiveTimers(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookTimerWheelRearmTest, "GrapplingHook.TimerWheel.Rearm", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookTimerWheelRearmTest::RunTest(const FString& Parameters)
+{
+	FGrapplingHookTimerWheel Wheel(WheelResolution);
+
+	//A level 2 timer moved down to level 0, and a level 0 timer moved up to level 3
+	double ShortenedFireTime = -1.0;
+	int32 ShortenedFireCount = 0;
+	const FGrapplingHookTimerHandle Shortened = Wheel.SetTimer(RecordFireTime(Wheel, ShortenedFireTime, ShortenedFireCount), 100.f);
+	double ExtendedFireTime = -1.0;
+	int32 ExtendedFireCount = 0;
+	const FGrapplingHookTimerHandle Extended = Wheel.SetTimer(RecordFireTime(Wheel, ExtendedFireTime, ExtendedFireCount), 0.2f);
+	Wheel.Advance(0.1f);
+	TestTrue(TEXT("Shortened timer re-armed"), Wheel.SetTimeLeft(Shortened, 0.4f));
+	TestTrue(TEXT("Extended timer re-armed"), Wheel.SetTimeLeft(Extended, 3000.f));
+	TestFalse(TEXT("Re-arm with a non positive time is refused"), Wheel.SetTimeLeft(Shortened, 0.f));
+
+	float TimeLeft = 0.f;
+	float TimeElapsed = 0.f;
+	TestTrue(TEXT("Timer info of the re-armed timer"), Wheel.GetTimerInfo(Shortened, TimeLeft, TimeElapsed));
+	TestEqual(TEXT("Time left after re-arm"), TimeLeft, 0.4f, 0.001f);
+	TestEqual(TEXT("Elapsed time kept across re-arm"), TimeElapsed, 0.1f, 0.001f);
+
+	const float Step = 1.f / 60.f;
+	while (Wheel.GetTime() < 3200.f)
+	{
+		Wheel.Advance(Step);
+	}
+	TestEqual(TEXT("Shortened timer fired once"), ShortenedFireCount, 1);
+	TestTrue(FString::Printf(TEXT("Shortened timer fired at %.4f s"), ShortenedFireTime), ShortenedFireTime >= 0.5f - KINDA_SMALL_NUMBER && ShortenedFireTime <= 0.5f + Step + WheelResolution);
+	TestEqual(TEXT("Extended timer fired once"), ExtendedFireCount, 1);
+	TestTrue(FString::Printf(TEXT("Extended timer fired at %.4f s"), ExtendedFireTime), ExtendedFireTime >= 3000.1f - 0.01f && ExtendedFireTime <= 3000.1f + Step + WheelResolution);
+	TestFalse(TEXT("Expired timers cannot be re-armed"), Wheel.SetTimeLeft(Shortened, 1.f));
+
+	//A timer expired in the current advance and re-armed by an earlier callback is not fired with it
+	FGrapplingHookTimerHandle Second;
+	double SecondFireTime = -1.0;
+	int32 SecondFireCount = 0;
+	Wheel.SetTimer(FSimpleDelegate::CreateLambda([&Wheel, &Second]() { Wheel.SetTimeLeft(Second, 1.f); }), 0.05f);
+	Second = Wheel.SetTimer(RecordFireTime(Wheel, SecondFireTime, SecondFireCount), 0.1f);
+	const double RearmTime = Wheel.GetTime();
+	Wheel.Advance(0.2f);
+	TestEqual(TEXT("Timer re-armed during its expiring advance did not fire"), SecondFireCount, 0);
+	Wheel.Advance(1.5f);
+	TestEqual(TEXT("Timer re-armed during its expiring advance fired later"), SecondFireCount, 1);
+	TestTrue(TEXT("Re-armed timer fired after its new time"), SecondFireTime >= RearmTime + 1.2f - KINDA_SMALL_NUMBER);
+
+	//Looping timers are re-armed by the wheel itself
+	int32 LoopCount = 0;
+	FGrapplingHookTimerHandle Loop = Wheel.SetTimer(FSimpleDelegate::CreateLambda([&LoopCount]() { ++LoopCount; }), 0.1f, true);
+	for (int32 Frame = 0; Frame < 65; ++Frame)
+	{
+		Wheel.Advance(Step);
+	}
+	TestEqual(TEXT("Looping timer fired every interval"), LoopCount, 10);
+	TestTrue(TEXT("Looping timer still active"), Wheel.IsTimerActive(Loop));
+	Wheel.ClearTimer(Loop);
+	TestEqual(TEXT("No timer left"), Wheel.GetNumActiveTimers(), 0);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,83 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/GrapplingHookTestAccess.h"
+#include "GrapplingHookComponent.h"
+#include "ProjectileHook.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookTrajectoryRuntimeTest, "GrapplingHook.Trajectory.MatchesRuntime", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FGrapplingHookTrajectoryRuntimeTest::RunTest(const FString& Parameters)
+{
+	static const float Step = 1.f / 30.f;
+	//Both paths are integrated in fixed point, only the float conversions of the owner location may differ
+	static const float Tollerance = 0.1f;
+
+	const FVector OwnerLocation(0.f, 0.f, 300.f);
+	const EGrapplingHookState States[] = { EGrapplingHookState::GS_Launch, EGrapplingHookState::GS_Swing };
+	const EGrapplingHookActivation Activations[] = { EGrapplingHookActivation::GA_Launch, EGrapplingHookActivation::GA_Swing };
+	const FVector Targets[] = { FVector(1200.f, 300.f, 900.f), FVector(600.f, 0.f, 1100.f) };
+	for (int32 Index = 0; Index < 2; ++Index)
+	{
+		FGrapplingHookTestWorld TestWorld;
+		UGrapplingHookComponent* const Grappler = TestWorld.SpawnGrappler(OwnerLocation);
+		if (!TestNotNull(TEXT("Grappler"), Grappler))
+		{
+			return false;
+		}
+		Grappler->Activation = static_cast<uint8>(Activations[Index]);
+		Grappler->bDeterministic = true;
+		Grappler->DeterministicTimeStep = Step;
+		//Every simulated step is kept
+		Grappler->TrajectoryPreviewMinSpacing = 0.f;
+		Grappler->TrajectoryPreviewMaxTime = 2.f;
+
+		//Nothing blocks the owner path, the preview does not predict collisions
+		AActor* const Anchor = TestWorld.SpawnBox(Targets[Index], FVector(20.f));
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AProjectileHook* const Hook = TestWorld.GetWorld()->SpawnActor<AProjectileHook>(AProjectileHook::StaticClass(), Targets[Index], FRotator::ZeroRotator, SpawnParams);
+		if (!TestNotNull(TEXT("Anchor"), Anchor) || !TestNotNull(TEXT("Hook"), Hook))
+		{
+			return false;
+		}
+		Anchor->SetActorEnableCollision(false);
+		Hook->SetActorEnableCollision(false);
+
+		TArray<FVector> Points;
+		EGrapplingHookState PreviewState = EGrapplingHookState::GS_Missed;
+		const bool bPreview = Grappler->GetTrajectoryPreviewTo(Targets[Index], -FVector::UpVector, Points, PreviewState);
+		TestTrue(TEXT("Trajectory preview succeeded"), bPreview);
+		TestEqual(TEXT("Predicted state"), PreviewState, States[Index]);
+
+		//Same grapple run by the deterministic simulation, from the hook landing
+		TArray<FGrapplingHookInstance>& Hooks = FGrapplingHookTestAccess::GetHooks(Grappler);
+		Hooks[0].Hook = Hook;
+		FGrapplingHookTestAccess::LandHook(Grappler, 0, States[Index], Anchor->GetRootComponent(), Targets[Index]);
+		const AActor* const Owner = Grappler->GetOwner();
+		TArray<FVector> Recorded;
+		Recorded.Add(Owner->GetActorLocation());
+		while (Recorded.Num() < Points.Num() && Hooks[0].CurrentState == States[Index])
+		{
+			FGrapplingHookTestAccess::StepDeterministic(Grappler, Step);
+			Recorded.Add(Owner->GetActorLocation());
+		}
+
+		//A launch preview ends on the step the runtime launch reaches its target
+		TestEqual(FString::Printf(TEXT("%s preview steps"), Index == 0 ? TEXT("Launch") : TEXT("Swing")), Points.Num(), Recorded.Num());
+		float MaxError = 0.f;
+		for (int32 Point = 0; Point < FMath::Min(Points.Num(), Recorded.Num()); ++Point)
+		{
+			MaxError = FMath::Max(MaxError, FVector::Distance(Points[Point], Recorded[Point]));
+		}
+		TestTrue(FString::Printf(TEXT("%s preview follows the runtime path (max error %.3f)"), Index == 0 ? TEXT("Launch") : TEXT("Swing"), MaxError), MaxError <= Tollerance);
+	}
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
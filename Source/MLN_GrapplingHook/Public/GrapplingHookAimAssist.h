@@ -0,0 +1,129 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+/*
+* Ray of an aim assist pattern, in the aim frame (X is the aim direction)
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookAimRay
+{
+	FVector LocalDirection;
+	/* Ring of the ray, 0 is the aim direction
+	*/
+	int32 Ring;
+};
+
+/*
+* Cone of rays around the aim direction used by the aim assist (see UGrapplingHookComponent::RequestAimAssist).
+* Ring 0 is the aim direction alone, the other rings are evenly spaced up to the cone half angle.
+* A sweep traces all the rings in a single batch or, if requested, one ring at a time outward stopping at the first ring that found a possible valid hit.
+* The latest sweep and its best hit are kept, a request with an unchanged aim reuses them instead of tracing again
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookAimAssist
+{
+public:
+	static const int32 MaxRings = 16;
+	static const int32 MaxRaysPerRing = 64;
+
+	FGrapplingHookAimAssist();
+
+	/* Rebuilds the pattern if the configuration changed (the sweep in progress is discarded)
+	*@param ConeDegrees Half angle of the cone
+	*@param Rings Number of rings around the aim direction
+	*@param RaysPerRing Number of rays of every ring
+	*/
+	void BuildPattern(const float ConeDegrees, const int32 Rings, const int32 RaysPerRing);
+	/* Returns the number of rays of the pattern
+	*/
+	int32 GetNumRays() const;
+	/* Returns the number of rings of the pattern, ring 0 included
+	*/
+	int32 GetNumRings() const;
+	/* Returns the index of the first ray of the given ring, rays are sorted by ring (GetNumRays for GetNumRings)
+	*/
+	int32 GetRingStart(const int32 Ring) const;
+	/* Returns the world direction of a ray
+	*@param AimFrame Frame of the aim direction (see MakeAimFrame)
+	*/
+	FVector GetRayDirection(const int32 RayIndex, const FMatrix& AimFrame) const;
+	/* Returns the frame used to orient the pattern along the given aim direction
+	*/
+	static FMatrix MakeAimFrame(const FVector& Direction);
+
+	/* Returns true if the latest sweep was requested with the same distance and complexity, an aim within the given tollerances and is not older than ReuseTime
+	*/
+	bool CanReuse(const FVector& Start, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, const double Time, const float ReuseDistance, const float ReuseDegrees, const float ReuseTime) const;
+	/* Starts a new sweep with all the rings, or with ring 0 alone if ring by ring. The results of the previous sweep still pending are discarded
+	*/
+	void BeginSweep(const FVector& Start, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, const double Time, const bool bRingByRing);
+	/* Continues a ring by ring sweep with the next ring
+	*@return False if the sweep already traced the last ring of the pattern
+	*/
+	bool BeginNextRing();
+	/* Returns the first ring of the traces submitted last by the sweep
+	*/
+	int32 GetSweepFirstRing() const;
+	/* Returns the outermost ring traced by the sweep so far
+	*/
+	int32 GetSweepRing() const;
+	/* Returns the user data of the trace of the given ray in the current sweep
+	*/
+	uint32 GetTraceUserData(const int32 RayIndex) const;
+	/* Stores the result of a trace of the rings submitted last (results of discarded sweeps are ignored)
+	*@param Hit Blocking hit of the trace, nullptr if nothing was hit
+	*@return True if the trace completed the submitted rings
+	*/
+	bool StoreTraceResult(const uint32 UserData, const FHitResult* const Hit);
+	/* Returns the hit of the given ray in the current sweep, nullptr if nothing was hit or its ring is not complete
+	*/
+	const FHitResult* GetRayHit(const int32 RayIndex) const;
+	const FVector& GetSweepStart() const;
+	const FVector& GetSweepDirection() const;
+	float GetSweepMaxDistance() const;
+	bool IsSweepTraceComplex() const;
+
+	/* Stores the best candidate of the latest completed sweep (nullptr if no candidate was found)
+	*/
+	void SetSelection(const FHitResult* const Hit, const bool bPossibleValidHit);
+	/* Returns the best candidate of the latest completed sweep
+	*@return False if no candidate was found
+	*/
+	bool GetSelection(FHitResult& OutHit, bool& bOutPossibleValidHit) const;
+
+private:
+	TArray<FGrapplingHookAimRay> Rays;
+	/* First ray of every ring, plus the number of rays
+	*/
+	TArray<int32> RingStarts;
+	float BuiltConeDegrees;
+	int32 BuiltRings;
+	int32 BuiltRaysPerRing;
+
+	/* Hits of the current sweep, allocated with the pattern
+	*/
+	TArray<FHitResult> Hits;
+	TArray<bool> RayHits;
+	FVector SweepStart;
+	FVector SweepDirection;
+	float SweepMaxDistance;
+	bool bSweepTraceComplex;
+	double SweepTime;
+	/* Identifier of the current sweep, stored in the trace user data
+	*/
+	uint16 SweepId;
+	/* Rings of the traces submitted last by the current sweep, from SweepFirstRing to SweepRing
+	*/
+	int32 SweepFirstRing;
+	int32 SweepRing;
+	/* Traces of the submitted rings not completed yet
+	*/
+	int32 PendingRays;
+	bool bSweepStarted;
+
+	FHitResult SelectedHit;
+	bool bSelection;
+	bool bSelectionPossibleValidHit;
+};
@@ -0,0 +1,118 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "GrapplingHookBenchmark.generated.h"
+
+class UWorld;
+class FGrapplingHookBenchmarkRun;
+
+USTRUCT()
+/*
+* Tick function used by the benchmark to time the physics tick groups
+*/
+struct FGrapplingHookBenchmarkTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	FGrapplingHookBenchmarkTickFunction()
+		: OutTime(nullptr)
+	{
+	}
+
+	/* Time (FPlatformTime::Seconds) written when the tick function is executed
+	*/
+	double* OutTime;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+template<>
+struct TStructOpsTypeTraits<FGrapplingHookBenchmarkTickFunction> : public TStructOpsTypeTraitsBase2<FGrapplingHookBenchmarkTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/*
+* Measures of a single benchmark step (fixed number of grapplers)
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookBenchmarkStep
+{
+	FGrapplingHookBenchmarkStep();
+
+	/* Number of grapplers spawned
+	*/
+	int32 Grapplers;
+	/* Value of GrapplingHook.UpdateWorkers during the step (0: all the task graph workers)
+	*/
+	int32 Workers;
+	/* Number of frames measured (warm up frames excluded)
+	*/
+	int32 Frames;
+	/* Time spent spawning and initializing the grapplers (milliseconds)
+	*/
+	double SpawnMs;
+	/* Sum and maximum of the frame times (milliseconds)
+	*/
+	double FrameMsSum;
+	double FrameMsMax;
+	/* Sum and maximum of the game thread times (milliseconds)
+	*/
+	double GameThreadMsSum;
+	double GameThreadMsMax;
+	/* Sum and maximum of the times between the start and the end of the physics tick groups (milliseconds)
+	*/
+	double PhysicsMsSum;
+	double PhysicsMsMax;
+	/* Sum and maximum of the times of the grappling hook update compute phase (milliseconds)
+	*/
+	double ComputeMsSum;
+	double ComputeMsMax;
+	/* Used physical memory after the spawn and at the end of the measured frames (bytes)
+	*/
+	uint64 MemoryStart;
+	uint64 MemoryEnd;
+	/* Time of the garbage collection after the grapplers are destroyed (milliseconds)
+	*/
+	double GCMs;
+	/* Grapple inputs scripted during the measured frames
+	*/
+	int32 Launches;
+	int32 Stops;
+};
+
+/*
+* Headless scalability benchmark, started with the console command GrapplingHook.Benchmark.
+* For every requested count, characters with a grappling hook component are spawned and scripted through launch, pull, swing and retract cycles
+* (LaunchGrapple, AddSwingingForce, StopGrapple), then frame, game thread, physics, memory and garbage collection costs are written to
+* Saved/GrapplingHook/Benchmark_<date>.json. Every count can be repeated for several values of GrapplingHook.UpdateWorkers to measure the scaling of the compute phase
+* with the core count. Example: -nullrhi -ExecCmds="GrapplingHook.Benchmark 1000 300 1 1,2,4,8,16"
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookBenchmark
+{
+public:
+	/* Starts a benchmark in the given world, stopping the running one (if any)
+	*@param Counts Number of grapplers of every step
+	*@param FramesPerStep Frames measured for every step
+	*@param bQuitWhenDone If true the engine exits once the results are written
+	*@param Workers Values of GrapplingHook.UpdateWorkers measured for every count (empty: the current value only)
+	*/
+	static void Start(UWorld* const World, const TArray<int32>& Counts, const int32 FramesPerStep, const bool bQuitWhenDone, const TArray<int32>& Workers = TArray<int32>());
+	/* Stops the running benchmark, destroying its actors. Results measured so far are written
+	*/
+	static void Stop();
+	/* Returns true if a benchmark is running
+	*/
+	static bool IsRunning();
+
+private:
+	static bool OnTicker(float DeltaTime);
+	/* Writes the results of the given run
+	*/
+	static void Write(const FGrapplingHookBenchmarkRun& Run);
+};
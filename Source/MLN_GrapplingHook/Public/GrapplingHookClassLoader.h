@@ -0,0 +1,34 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPtr.h"
+
+class AProjectileHook;
+struct FStreamableHandle;
+
+/*
+* Asynchronously loads the projectile hook classes used by the grappling hook components.
+* A class is loaded once through the streamable manager and shared by all the components referencing it, it stays loaded until the module shuts down
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookClassLoader
+{
+public:
+	/* Starts the async load of the given class if it was not requested yet (or if its previous load failed). Returns true if the class is already loaded
+	*/
+	static bool Request(const TSoftClassPtr<AProjectileHook>& HookClass);
+	/* Releases all the loaded classes
+	*/
+	static void ReleaseAll();
+
+private:
+	/* Returns true if the given handle finished without loading its class (missing asset, canceled request)
+	*/
+	static bool IsFailedLoad(const TSharedPtr<FStreamableHandle>& Handle);
+	/* Creates the class default object (and its default subobjects) of the loaded class, so the first spawn does not pay for it
+	*/
+	static void OnClassLoaded(const FSoftObjectPath Path);
+
+	static TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> Handles;
+};
@@ -4,6 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "GrapplingHookTimerWheel.h"
+#include "GrapplingHookEasing.h"
+#include "GrapplingHookPhysicsPool.h"
+#include "GrapplingHookFixedPoint.h"
+#include "GrapplingHookAimAssist.h"
+#include "GrapplingHookTrajectory.h"
+#include "WorldCollision.h"
+#include "PhysicsEngine/BodyInstance.h"
 #include "GrapplingHookComponent.generated.h"
 
 UENUM(BlueprintType, Blueprintable, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
@@ -74,6 +82,12 @@ enum class EGrapplingHookState : uint8
 	/* The grapple is being launched
 	*/
 	GS_Extending UMETA(DisplayName = "Extending"),
+	/* The character and the grappled object (too heavy to be pulled) are being pulled towards each other
+	*/
+	GS_Tug UMETA(DisplayName = "Tug"),
+	/* Number of states
+	*/
+	GS_MAX UMETA(Hidden),
 };
 
 UENUM(BlueprintType, Blueprintable)
@@ -114,23 +128,361 @@ enum class EGrapplingHookError : uint8
 	/* The update failed due to missing core elements (Owner, Cable, Hook)
 	*/
 	GE_UpdateCore UMETA(DisplayName = "Failed Update Core"),
+	/* The Tug update failed due to missing core elements (Owner, Owner movement component, GrappledObject)
+	*/
+	GE_TugUpdateCore UMETA(DisplayName = "Failed Tug Update Core"),
+	/* The spawn of the AProjectileHook did not succeed because HookClass is not set or is still loading
+	*/
+	GE_HookSpawnClassNotLoaded UMETA(DisplayName = "Failed Hook Spawn Class Not Loaded"),
+	/* The component tick was disabled and the hooks were reset after too many consecutive update core failures (see MaxConsecutiveCoreFailures)
+	*/
+	GE_CoreFailureTickDisabled UMETA(DisplayName = "Core Failure Tick Disabled"),
+	/* Number of errors
+	*/
+	GE_MAX UMETA(Hidden),
 };
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGrappleActivated, EGrapplingHookState, State, UPrimitiveComponent*, GrappledObject);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGrappleStateChanged, EGrapplingHookState, OldState, EGrapplingHookState, NewState);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnHookStateChanged, int32, HookIndex, EGrapplingHookState, OldState, EGrapplingHookState, NewState);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGrappleInterrupted, EGrapplingHookState, State);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnGrappleBreaked);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnGrappleReady);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnGrappleMissed);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGrappleDisabled, float, Cooldown);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGrappleError, EGrapplingHookError, Error);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnGrappleErrorAggregated, EGrapplingHookError, Error, int32, Occurrences);
 
 class AProjectileHook;
 class ACharacter;
 class UCableComponent;
 class UPrimitiveComponent;
+class USceneComponent;
 class UPhysicsConstraintComponent;
 class UPhysicsHandleComponent;
 class UAudioComponent;
+class UCurveFloat;
+struct FGrapplingHookUpdateBatch;
+struct FGrapplingHookStateTable;
+struct FGrapplingHookSnapshot;
+
+/*
+* Component wide parameters used by the grapple update compute phase
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookUpdateParams
+{
+	FGrapplingHookUpdateParams();
+
+	/* See UGrapplingHookComponent::LaunchSpeed
+	*/
+	float LaunchSpeed;
+	/* Height offset added to the grapple end location in Launch mode (see UGrapplingHookComponent::OffsetZPercentage)
+	*/
+	float LaunchOffsetZ;
+	/* See UGrapplingHookComponent::BreakDistance
+	*/
+	float BreakDistance;
+	/* See UGrapplingHookComponent::RetractDistanceTollerance
+	*/
+	float RetractDistanceTollerance;
+	/* See UGrapplingHookComponent::PullDistanceTollerance
+	*/
+	float PullDistanceTollerance;
+	/* See UGrapplingHookComponent::PullDistanceInterrupt
+	*/
+	float PullDistanceInterrupt;
+	/* Easing used by the retract phase (baked from UGrapplingHookComponent::RetractCurve)
+	*/
+	const FGrapplingHookEasingTable* RetractEasing;
+	/* See UGrapplingHookComponent::bDeterministic
+	*/
+	bool bDeterministic;
+};
+
+/*
+* Result of the grapple update compute phase of a single hook, applied on the game thread by the owning component
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookUpdateResult
+{
+	FGrapplingHookUpdateResult();
+
+	/* Owner launch velocity contribution (Launch)
+	*/
+	FVector LaunchVelocity;
+	/* New hook location (Retracting)
+	*/
+	FVector RetractLocation;
+	/* New hook rotation (Retracting)
+	*/
+	FQuat RetractRotation;
+	/* Pull handle target location (Pull)
+	*/
+	FVector PullTargetLocation;
+	/* Retract clock after this update (Retracting)
+	*/
+	uint32 RetractClock;
+	/* Grapple length when the inputs were gathered
+	*/
+	float GrappleLength;
+	/* Delta time the result was computed with
+	*/
+	float DeltaTime;
+	/* Frame the result was computed in
+	*/
+	uint64 Frame;
+	/* Hook state the result was computed for
+	*/
+	EGrapplingHookState State;
+	/* False if the grapple start location was not valid
+	*/
+	bool bValidStart;
+	/* False if the grapple end location was not valid
+	*/
+	bool bValidEnd;
+	/* True if the grapple length surpasses the break distance
+	*/
+	bool bBreak;
+	/* True if the retract phase is over after this update
+	*/
+	bool bRetractOver;
+	/* True if the pulled object is close enough to interrupt the pull
+	*/
+	bool bPullOver;
+};
+
+/*
+* Snapshot of a single hook gathered on the game thread. Computing the update only reads this data, so it can run on any thread
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookUpdateInput
+{
+	FGrapplingHookUpdateInput();
+
+	/* Computes the update of the hook (pure function of the snapshot)
+	*/
+	void Compute(const FGrapplingHookUpdateParams& Params, FGrapplingHookUpdateResult& OutResult) const;
+	/* Computes the state dependent part of the update in fixed point, the snapshot is quantized first (see UGrapplingHookComponent::bDeterministic)
+	*/
+	void ComputeDeterministic(const FGrapplingHookUpdateParams& Params, FGrapplingHookUpdateResult& OutResult) const;
+	/* Returns the rotation looking from Start to Target (same as UKismetMathLibrary::FindLookAtRotation)
+	*/
+	static FQuat GetLookAtQuat(const FVector& Start, const FVector& Target);
+
+	/* Grapple (cable) start world location
+	*/
+	FVector StartLocation;
+	/* Grapple (cable) end world location
+	*/
+	FVector EndLocation;
+	/* Cable forward vector
+	*/
+	FVector CableForward;
+	/* Owner world location
+	*/
+	FVector OwnerLocation;
+	/* Hook actor world location
+	*/
+	FVector HookLocation;
+	/* Location of the hook when the retracting phase started
+	*/
+	FVector RetractStartLocation;
+	/* Retract clock before this update
+	*/
+	uint32 RetractClock;
+	/* Retract clock rate of the current retracting phase
+	*/
+	float RetractClockRate;
+	/* Distance between grapple start location and the pulled object collision (Pull only)
+	*/
+	float PulledObjectDistance;
+	/* Delta time of the update (owner time dilation included)
+	*/
+	float DeltaTime;
+	/* Frame the snapshot was gathered in
+	*/
+	uint64 Frame;
+	/* Index of the component parameters inside the update batch
+	*/
+	int32 ParamsIndex;
+	/* Index of the hook inside its component
+	*/
+	int32 HookIndex;
+	/* Hook state when the snapshot was gathered
+	*/
+	EGrapplingHookState State;
+	/* False if the grapple start location was not valid
+	*/
+	bool bValidStart;
+	/* False if the grapple end location was not valid
+	*/
+	bool bValidEnd;
+};
+
+/*
+* Span of a hook cable checked by the rope collision pass, with the contact found by its latest sweep (see UGrapplingHookComponent::bRopeCollision)
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookRopeContact
+{
+	FGrapplingHookRopeContact();
+
+	/* Span of cable particles checked by the latest sweep (world locations)
+	*/
+	FVector SpanStart;
+	FVector SpanEnd;
+	/* Collision free location of the rope at the contact (impact point pushed out by the rope radius)
+	*/
+	FVector Location;
+	/* Surface normal at the contact
+	*/
+	FVector Normal;
+	/* Component hit by the latest sweep
+	*/
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+	/* True if the latest sweep of the span hit something
+	*/
+	bool bContact;
+	/* True once the span was swept at least once
+	*/
+	bool bSwept;
+};
+
+/*
+* State of a single hook of the grappling hook component (one for every hook the component can fire, see HookCount)
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookInstance
+{
+	FGrapplingHookInstance();
+
+	/* The Projectile Hook used
+	*/
+	AProjectileHook* Hook;
+	/* Cable used by this hook (will be attached to ProjectileHook)
+	*/
+	UCableComponent* Cable;
+	/* The currently grappled object
+	*/
+	UPrimitiveComponent* GrappledObject;
+	/* Component the landed hook is anchored to, the grapple end follows it (weak: the instance is not seen by the garbage collector)
+	*/
+	TWeakObjectPtr<USceneComponent> Anchor;
+	/* Grapple end location relative to Anchor
+	*/
+	FVector AnchorRelativeLocation;
+	/* Grapple end world location, refreshed once per frame from Anchor
+	*/
+	FVector AnchorLocation;
+	/* Location of the hook when the retracting phase started
+	*/
+	FVector RetractStartLocation;
+	/* Current retract clock (see FGrapplingHookRetractClock)
+	*/
+	uint32 RetractClock;
+	/* Retract clock rate of the current retracting phase (based on grapple length)
+	*/
+	float RetractClockRate;
+	/* Rope length used by the swing solver, set on swing activation
+	*/
+	float RopeLength;
+	/* Rope length used by the deterministic swing integrator
+	*/
+	FGrapplingHookFixed DeterministicRopeLength;
+	/* Location of the object pulled by the deterministic pull integrator
+	*/
+	FGrapplingHookFixedVector DeterministicPulledLocation;
+	/* True while GrappledObject is moved by the deterministic pull integrator
+	*/
+	bool bDeterministicPulled;
+	/* Location and velocity of the extending hook stepped by the deterministic hook flight (see UGrapplingHookComponent::UpdateDeterministicHookFlight)
+	*/
+	FGrapplingHookFixedVector DeterministicHookLocation;
+	FGrapplingHookFixedVector DeterministicHookVelocity;
+	/* Timer handle used for the hook cooldown phase (scheduled in the world grappling hook timer wheel)
+	*/
+	FGrapplingHookTimerHandle CooldownTimerHandle;
+	/* Current hook state
+	*/
+	EGrapplingHookState CurrentState;
+	/* Hook state before retracting phase commenced, used internally to determine which cooldown to use at the end of retracting phase
+	*/
+	EGrapplingHookState PreRetractingState;
+	/* True if the swing phase of this hook has already been activated
+	*/
+	bool bActivatedSwing;
+	/* Time when the current state was entered (only set while the telemetry is enabled, 0 otherwise)
+	*/
+	double StateEnterTime;
+	/* True if Cable was created by the component (see UGrapplingHookComponent::bLazySubobjects)
+	*/
+	bool bLazyCable;
+	/* Latest result of the update compute phase
+	*/
+	FGrapplingHookUpdateResult Update;
+	/* Cable spans checked by the rope collision pass (see UGrapplingHookComponent::bRopeCollision)
+	*/
+	TArray<FGrapplingHookRopeContact> RopeContacts;
+	/* First span swept by the next rope collision pass (spans are swept round robin when the pass budget is lower than their number)
+	*/
+	int32 RopeCollisionCursor;
+	/* Cables rendering Cable through its rope contacts, one between every two consecutive route points (created on first use, hidden when unused, see UGrapplingHookComponent::UpdateRopeRoute)
+	*/
+	TArray<UCableComponent*> RopeRouteCables;
+	/* True while Cable is hidden from the frame and rendered by RopeRouteCables
+	*/
+	bool bRopeRouted;
+	/* Main pass and shadow flags of Cable before it was hidden by the rope route, restored with it
+	*/
+	bool bRopeRouteMainPass;
+	bool bRopeRouteCastShadow;
+};
+
+/*
+* Rope of a swinging hook as seen by the physics substeps (gathered on the game thread before the physics simulation)
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookSwingRope
+{
+	/* Grapple start location relative to the owner capsule body
+	*/
+	FVector LocalStart;
+	/* Grapple end world location
+	*/
+	FVector Anchor;
+	/* Maximum rope length (changed by the substeps while reeling)
+	*/
+	float Length;
+	/* Index of the swinging hook
+	*/
+	int32 HookIndex;
+	/* True if the rope is simulated by UGrapplingHookComponent::SwingConstraint
+	*/
+	bool bConstrained;
+};
+
+/*
+* Rope of a swinging hook as seen by the deterministic owner integration (see UGrapplingHookComponent::StepDeterministicOwner)
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookFixedRope
+{
+	/* Grapple end location
+	*/
+	FGrapplingHookFixedVector Anchor;
+	/* Maximum distance of the owner location from Anchor
+	*/
+	FGrapplingHookFixed Length;
+};
+
+/*
+* Aggregated reports of a single error code
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookErrorRecord
+{
+	FGrapplingHookErrorRecord();
+
+	/* Timer wheel time of the latest OnGrappleError broadcast of this error
+	*/
+	double LastBroadcastTime;
+	/* Reports received since the latest broadcast
+	*/
+	int32 PendingCount;
+};
+
 UCLASS(BlueprintType, Blueprintable, ClassGroup=(Grapple), meta=(BlueprintSpawnableComponent) )
 /*
 * Component to manage and attuate the grappling hook mechanic
@@ -138,21 +490,27 @@ UCLASS(BlueprintType, Blueprintable, ClassGroup=(Grapple), meta=(BlueprintSpawna
 class MLN_GRAPPLINGHOOK_API UGrapplingHookComponent : public UActorComponent
 {
 	GENERATED_BODY()
-private:
-	float CurrentRetractDuration;
-	FVector RetractStartLocation;
-	bool bActivatedSwing;
+
+	friend struct FGrapplingHookTestAccess;
 public:
 
 	UPROPERTY(BlueprintAssignable, Category = "Config|Dispatchers")
-	/* Event invoked when an error occurs
+	/* Event invoked when an error occurs. Reports of the same error are rate limited, see ErrorReportInterval
 	*/
 	FOnGrappleError OnGrappleError;
 	UPROPERTY(BlueprintAssignable, Category = "Config|Dispatchers")
+	/* Event invoked together with OnGrappleError, with the number of reports of the error aggregated since its previous broadcast
+	*/
+	FOnGrappleErrorAggregated OnGrappleErrorAggregated;
+	UPROPERTY(BlueprintAssignable, Category = "Config|Dispatchers")
 	/* Event invoked when the grappling hook state changes
 	*/
 	FOnGrappleStateChanged OnGrappleStateChanged;
 	UPROPERTY(BlueprintAssignable, Category = "Config|Dispatchers")
+	/* Event invoked when the state of a single hook changes (same as OnGrappleStateChanged, with the index of the hook)
+	*/
+	FOnHookStateChanged OnHookStateChanged;
+	UPROPERTY(BlueprintAssignable, Category = "Config|Dispatchers")
 	/* Event invoked when the grappling hook is activated by hitting a valid object (after the extension phase)
 	*/
 	FOnGrappleActivated OnGrappleActivated;
@@ -190,15 +548,9 @@ protected:
 	/* "Owner" of the grappling hook, Launch and Swing mechanics will be used on this
 	*/
 	ACharacter* Owner;
-	/* Cable used by the grappling hook (will be attached to ProjectileHook)
-	*/
-	UCableComponent* Cable;
-	/* The currently grappled object
-	*/
-	UPrimitiveComponent* GrappledObject;
-	/* The Projectile Hook used
+	/* State of every hook managed by this component
 	*/
-	AProjectileHook* Hook;
+	TArray<FGrapplingHookInstance> Hooks;
 
 	/* Physics constraint used on Owner to simulate the swinging mechanic
 	*/
@@ -209,10 +561,128 @@ protected:
 	/* If true the CurrentSwingingForce will be considered as an acceleration change
 	*/
 	bool bAccelChange;
+	/* True while Owner capsule is simulating physics because at least one hook is swinging
+	*/
+	bool bSwingPhysicsActive;
+	/* True if SwingConstraint is leased from the world physics pool
+	*/
+	bool bPooledSwingConstraint;
+	/* Swinging force applied in every physics substep of the current frame
+	*/
+	FVector SubstepSwingingForce;
+	/* If true SubstepSwingingForce is an acceleration change
+	*/
+	bool bSubstepAccelChange;
+	/* Ropes enforced in every physics substep of the current frame (only used by multiple swinging hooks)
+	*/
+	TArray<FGrapplingHookSwingRope> SubstepSwingRopes;
+	/* Custom physics delegate registered on the owner capsule body every tick while swinging with bSubstepSwing
+	*/
+	FCalculateCustomPhysics SubstepSwingDelegate;
+	/* Reel input accumulated this tick by ReelRope
+	*/
+	float CurrentReelInput;
+	/* Rope length change speed applied in every physics substep of the current frame (negative shortens)
+	*/
+	float SubstepReelSpeed;
+	/* Rope length range used by the physics substeps of the current frame
+	*/
+	float SubstepMinRopeLength;
+	float SubstepMaxRopeLength;
+	/* True if PullHandle is leased from the world physics pool
+	*/
+	bool bPooledPullHandle;
+	/* True if Audio was created by the component (see bLazySubobjects)
+	*/
+	bool bLazyAudio;
+	/* Timer handle used to destroy the lazily created subobjects once idle (scheduled in the world grappling hook timer wheel)
+	*/
+	FGrapplingHookTimerHandle LazyIdleTimerHandle;
+	/* True while a launch input is buffered
+	*/
+	bool bLaunchBuffered;
+	/* Hook requested by the buffered launch (INDEX_NONE for the first hook ready)
+	*/
+	int32 BufferedLaunchHookIndex;
+	/* World time after which the buffered launch is discarded
+	*/
+	double BufferedLaunchExpireTime;
+	/* World real time of the launch input waiting for its hook launch, negative if none
+	*/
+	double LaunchInputTime;
+	/* Frame of the launch input waiting for its hook launch
+	*/
+	uint64 LaunchInputFrame;
+	/* Latency of the latest launch input (milliseconds), negative if none was measured yet
+	*/
+	float LastLaunchLatencyMs;
+	/* Latency of the latest launch input (frames)
+	*/
+	int32 LastLaunchLatencyFrames;
+	/* Index of the hook currently bound to SwingConstraint (INDEX_NONE if the constraint is not in use)
+	*/
+	int32 ConstrainedHookIndex;
+	/* Owner location and velocity integrated by the deterministic simulation while Owner is launching or swinging
+	*/
+	FGrapplingHookFixedVector DeterministicOwnerLocation;
+	FGrapplingHookFixedVector DeterministicOwnerVelocity;
+	/* Ropes of the swinging hooks gathered by every deterministic owner step
+	*/
+	TArray<FGrapplingHookFixedRope> DeterministicRopes;
+	/* True while Owner is moved by the deterministic simulation (its movement component is deactivated)
+	*/
+	bool bDeterministicOwnerDriven;
+	/* State hash of the latest deterministic simulation frame
+	*/
+	uint32 DeterministicStateHash;
+	/* Number of deterministic simulation frames
+	*/
+	uint32 DeterministicFrame;
+	/* Frame time not simulated yet by the fixed DeterministicTimeStep
+	*/
+	FGrapplingHookFixed DeterministicTimeAccumulator;
+	/* Timers of the deterministic simulation, advanced by its steps instead of the world time (created on first use)
+	*/
+	mutable TUniquePtr<FGrapplingHookTimerWheel> DeterministicTimerWheel;
+	/* Ray pattern, latest sweep and best hit of the aim assist
+	*/
+	FGrapplingHookAimAssist AimAssist;
+	/* Delegate of the aim assist asynchronous traces, bound on first use
+	*/
+	FTraceDelegate AimAssistTraceDelegate;
+	/* Aim ray of GetTrajectoryPreview, traced asynchronously like the aim assist (single ray pattern)
+	*/
+	FGrapplingHookAimAssist TrajectoryAim;
+	/* Delegate of the trajectory aim asynchronous traces, bound on first use
+	*/
+	FTraceDelegate TrajectoryAimTraceDelegate;
+	/* Latest trajectory preview
+	*/
+	FGrapplingHookTrajectory TrajectoryPreview;
+	/* Cable particle locations read by the rope collision pass
+	*/
+	TArray<FVector> RopeCollisionParticles;
 
 	/* Physics handle used to simulate the Pull mechanic
 	*/
 	UPhysicsHandleComponent* PullHandle;
+	/* Index of the hook currently using PullHandle (INDEX_NONE if the handle is not in use)
+	*/
+	int32 PullHookIndex;
+
+	/* State machine table matching the current Activation mask (see GetStateTable)
+	*/
+	const FGrapplingHookStateTable* StateTable;
+	/* True while RefreshStateTable interrupts the hooks left in the states of disabled features with the previous table
+	*/
+	bool bRefreshingStateTable;
+
+	/* RetractCurve baked in a lookup table
+	*/
+	FGrapplingHookEasingTable RetractEasing;
+	/* True while the deferred begin play initialization is queued
+	*/
+	bool bInitializationPending;
 
 	/* Audio component used to play sounds
 	*/
@@ -222,28 +692,45 @@ protected:
 	*/
 	AActor* NoiseInstigator;
 
-	/* Timer handle used for the grapple cooldown phase
+	/* Timer handle used for the grounded interruption grace period after grapple activation (scheduled in the world grappling hook timer wheel)
 	*/
-	FTimerHandle CooldownTimerHandle;
-	/* Timer handle used for the ground check after grapple activation
+	FGrapplingHookTimerHandle GroundedGraceTimerHandle;
+	/* Timer handle used for the single grounded check after grapple activation (scheduled in the world grappling hook timer wheel)
 	*/
-	FTimerHandle GroundCheckTimerHandle;
-
-	/* Current grapple state
+	FGrapplingHookTimerHandle GroundCheckTimerHandle;
+	/* Aggregated reports of every error code
 	*/
-	EGrapplingHookState CurrentState;
-	/* Grapple state before retracting phase commenced, used internally to determine which cooldown to use at the end of retracting phase
+	FGrapplingHookErrorRecord ErrorRecords[static_cast<int32>(EGrapplingHookError::GE_MAX)];
+	/* Timer handle used to broadcast the reports still pending at the end of the aggregation interval
 	*/
-	EGrapplingHookState PreRetractingState;
-
-	/* Current retract timer
+	FGrapplingHookTimerHandle ErrorFlushTimerHandle;
+	/* Number of consecutive ticks with update core failures
+	*/
+	int32 ConsecutiveCoreFailures;
+	/* True if an update core failure was reported during the current tick
 	*/
-	float RetractTime;
+	bool bCoreFailureThisTick;
+	/* True if the grace period after grapple activation is over and owner landing events will interrupt Launch/Swing
+	*/
+	bool bGroundedInterruptArmed;
+	/* Character whose landed and movement mode changed events are currently bound
+	*/
+	ACharacter* BoundOwner;
 
 public:	
 	UGrapplingHookComponent();
 	void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+	void OnRegister() override;
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	void PostLoad() override;
+	/* Performs the begin play initialization (see bInitializeCoreOnBeginPlay and bInitializeNonCoreOnBeginPlay), owner components are looked up through the world component cache
+	*/
+	void InitializeFromOwner();
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Config|Grapple", meta = (ClampMin = 1, UIMin = 1, UIMax = 4))
+	/* Number of independent hooks managed by this component (applied on Initialize). Every hook needs its own cable (see SetHookCable)
+	*/
+	int32 HookCount;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Miss", meta = (ClampMin = 0.f, UIMin = 0.f))
 	/* Cooldown time used after a missed grapple
 	*/
@@ -286,6 +773,18 @@ public:
 	/* Cooldown time used after a succesfull grapple in Pull mode
 	*/
 	float PullCooldown;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Tug")
+	/* If true (and Pull feature is enabled) objects heavier than PullMaxObjectMass will be tugged: character and object accelerate towards each other based on their inverse masses
+	*/
+	bool bTugHeavyObjects;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Tug", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Force applied by the grapple to both ends when in Tug mode
+	*/
+	float TugForce;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Tug", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Cooldown time used after a succesfull grapple in Tug mode
+	*/
+	float TugCooldown;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Swing", meta = (ClampMin = 0.f, UIMin = 0.f))
 	/* Cooldown time used after a succesfull grapple in Swing mode
 	*/
@@ -294,6 +793,23 @@ public:
 	/* Multiplier applied to forces by AddSwingingForce
 	*/
 	float SwingingStrength;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Swing")
+	/* if true swinging forces and the rope lengths of multiple swinging hooks are applied in every physics substep of the owner capsule instead of once per tick,
+	* making the swing independent from the frame rate
+	*/
+	bool bSubstepSwing;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Swing", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Maximum speed at which ReelRope shortens the swinging ropes (cm/s)
+	*/
+	float ReelInSpeed;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Swing", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Maximum speed at which ReelRope lengthens the swinging ropes (cm/s). Ropes are never longer than BreakDistance
+	*/
+	float ReelOutSpeed;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Swing", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Minimum length of a swinging rope reeled in
+	*/
+	float MinRopeLength;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Swing", meta = (ClampMin = 0.f, ClampMax = 180.f, UIMin = 0.f, UIMax = 180.f))
 	/* Value used to determine how much deviation in angle from SwingSurfaceNormal is permitted.
 	*/
@@ -306,18 +822,128 @@ public:
 	/* Total duration for full grapple Retract effect
 	*/
 	float RetractDuration;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Config|Grapple|Retract")
+	/* Optional easing curve of the retract phase (time range is normalized to the retract duration). If not set the retract is linear
+	*@note The curve is baked in a lookup table on load and begin play, use SetRetractCurve to change it at runtime
+	*/
+	UCurveFloat* RetractCurve;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Retract", meta = (ClampMin = 1.f, UIMin = 1.f))
 	/* Threshold for grapple length. When grapple reaches a length less than this value the retract phase will be considered over
 	*/
 	float RetractDistanceTollerance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Deterministic")
+	/* if true the grapple is simulated in fixed point for lockstep games: launch, retract, swing and pull are integrated by the component instead of
+	* the character movement and PhysX (Owner and pulled objects are teleported to the simulated locations) and a state hash is produced every frame (see GetDeterministicStateHash).
+	* Inputs (locations, normals, forces) are quantized when read, so equal inputs give bit identical results on every machine.
+	* The hook flight is stepped in fixed point as well. The owner and hook sweeps only decide whether a move is blocked and by which component: the contact points
+	* are never read back, a blocked move stops at the last free fixed point location
+	*@note Tug is not available in this mode, swing ropes are measured from the owner location
+	*/
+	bool bDeterministic;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Deterministic", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Time step of every deterministic simulation frame (0 uses the frame delta time, quantized).
+	* The frame time is accumulated and the simulation runs as many whole steps as it holds (none or several per tick), the cooldowns and grace periods
+	* are counted in simulation time as well
+	*/
+	float DeterministicTimeStep;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Stats", meta = (ClampMin = 0.f, UIMin = 0.f))
-	/* Delay after grapple activation after which if the character is launching and is grounded the grapple will be interrupted
+	/* Delay after grapple activation after which if the character is still grounded (a Launch/Swing that did not leave the ground) the grapple will be interrupted.
+	* It is a single check, performed when the grounded interruption grace period is over if that ends later (0 checks at the end of the grace period)
 	*/
 	float GroundedCheckDelay;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Stats", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Grace period after grapple activation. Once over, as soon as the character lands or its movement mode becomes grounded Launch/Swing will be interrupted
+	*@note Grounding is event driven (owner Landed and MovementModeChanged events), no polling is performed
+	*/
+	float GroundedInterruptGracePeriod;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Inputs", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Time a launch input received while no hook is ready stays valid. The launch is performed on the frame an hook becomes ready (0 drops the input)
+	*/
+	float InputBufferWindow;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Inputs")
+	/* if true StopGrapple also discards the buffered launch input
+	*/
+	bool bStopCancelsBufferedLaunch;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Inputs")
+	/* if true launching while no hook is ready re-fires a swinging or launching hook toward the new target, reusing its hook actor and cable
+	* (no retract, cooldown or respawn, the owner velocity is kept)
+	*/
+	bool bChainHooks;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Assist", meta = (ClampMin = 0.f, ClampMax = 89.f, UIMin = 0.f, UIMax = 89.f))
+	/* Half angle of the cone of rays cast around the aim direction by the aim assist (see RequestAimAssist and IsAimingHitValidCone)
+	*/
+	float AimAssistConeDegrees;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Assist", meta = (ClampMin = 0, ClampMax = 16, UIMin = 0, UIMax = 16))
+	/* Number of rings of rays around the aim direction, evenly spaced up to AimAssistConeDegrees (0 casts the aim direction ray only)
+	*/
+	int32 AimAssistRings;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Assist", meta = (ClampMin = 1, ClampMax = 64, UIMin = 1, UIMax = 64))
+	/* Number of rays of every ring
+	*/
+	int32 AimAssistRaysPerRing;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Assist")
+	/* If true RequestAimAssist traces one ring per frame, outward, and stops at the first ring that found a possible valid hit: fewer traces when the aim direction
+	* hits, one more frame of latency for every outer ring traced. If false all the rings are traced in a single batch
+	*/
+	bool bAimAssistRingByRing;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Assist", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Start location movement within which RequestAimAssist reuses the latest sweep instead of tracing again
+	*/
+	float AimAssistReuseDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Assist", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Aim direction change (degrees) within which RequestAimAssist reuses the latest sweep instead of tracing again.
+	* Keep it below the ring spacing (AimAssistConeDegrees / AimAssistRings), the rays of a reused sweep are off by up to this angle
+	*/
+	float AimAssistReuseDegrees;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Assist", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Maximum age (seconds) of a reused sweep, moving targets are traced again at least this often
+	*/
+	float AimAssistReuseTime;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Preview", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Maximum simulated time of a trajectory preview (see GetTrajectoryPreview)
+	*/
+	float TrajectoryPreviewMaxTime;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Preview", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Minimum distance between two points of a trajectory preview, simulated steps closer than this to the last point are not kept
+	*/
+	float TrajectoryPreviewMinSpacing;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Preview", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Owner and target movement within which the latest trajectory preview is reused (a swing preview is moved along with the owner while the owner position relative to the target stays within it)
+	*/
+	float TrajectoryPreviewReuseDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Aiming|Preview", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Owner and target movement within which the latest launch preview is moved to the new locations instead of simulated again (the launch path is linear in both)
+	*/
+	float TrajectoryPreviewShiftDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Cable")
+	/* if true the cables are checked against the world by a few sphere sweeps along their particles (capsules between span ends) instead of the cable per particle collision.
+	* Contacts of the previous frames are reused while the cable does not move, every moved span is swept again against the world (see GetRopeContacts and bRopeContactCableCollision)
+	*/
+	bool bRopeCollision;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Cable", meta = (ClampMin = 1, ClampMax = 16, UIMin = 1, UIMax = 16))
+	/* Number of spans every cable is divided in, also the maximum number of sweeps per cable per frame
+	*/
+	int32 RopeCollisionSpans;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Cable", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Camera distance of every rope collision LOD: every LOD halves the sweeps per frame (at least one), spans are swept round robin.
+	* Cables not rendered recently are not swept (0 disables the distance LOD)
+	*/
+	float RopeCollisionLODDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Cable", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Span movement within which the contact of the latest sweep is reused without any query
+	*/
+	float RopeCollisionReuseDistance;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Grapple|Cable")
+	/* if true the cable particle collision is enabled while the rope collision pass finds a contact, so that the cable particles are resolved around it.
+	* The particle collision of the engine cable queries the world for every particle every substep, its cost is not bounded by RopeCollisionSpans.
+	* If false (default) the cost stays bounded to the pass sweeps: while there are contacts the cable is hidden from the frame and rendered by straight cables stretched between the grapple start, the contacts and the grapple end
+	*/
+	bool bRopeContactCableCollision;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Stats")
-	/* Projectile hook class used
+	/* Projectile hook class used, loaded asynchronously when the component is registered
+	*@note Use SetHookClass to change it at runtime, hooks cannot be launched until the class is loaded (see IsHookClassLoaded)
 	*/
-	TSubclassOf<AProjectileHook> HookClass;
+	TSoftClassPtr<AProjectileHook> HookClass;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Stats", meta = (Bitmask, BitmaskEnum = "EGrapplingHookActivation"))
 	/* Mask that represent all the enabled features in the grappling hook
 	*/
@@ -326,6 +952,25 @@ public:
 	/* List of trace types that will invalidate the grapple mechanic if hit
 	*/
 	TArray<TEnumAsByte<ECollisionChannel>> BlockingObjects;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Detection")
+	/* List of object types the hook passes through (irrelevant geometry is neither hit nor tested in narrow phase).
+	*@note BlockingObjects always stop the hook
+	*/
+	TArray<TEnumAsByte<ECollisionChannel>> HookIgnoredObjects;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Detection")
+	/* Object types that can be pulled (Pull mode). The hook passes through the object types not used by any enabled feature
+	*@note Empty means every object type
+	*/
+	TArray<TEnumAsByte<ECollisionChannel>> PullableObjects;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Detection")
+	/* Object types the character can swing on or be launched to (Swing and Launch modes). The hook passes through the object types not used by any enabled feature
+	*@note Empty means every object type
+	*/
+	TArray<TEnumAsByte<ECollisionChannel>> SwingableObjects;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Detection")
+	/* if true the hook ignores all trace channels, so traces performed by other systems skip it
+	*/
+	bool bHookIgnoresTraceChannels;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Stats")
 	/* Distance after which the grapple will automatically disjoint
 	*/
@@ -358,6 +1003,14 @@ public:
 	/* Tag associated with noise events
 	*/
 	FName NoiseTag;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Debug", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Minimum time between two OnGrappleError broadcasts of the same error, the reports received in between are counted and broadcasted together by OnGrappleErrorAggregated (0 broadcasts every report)
+	*/
+	float ErrorReportInterval;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Debug", meta = (ClampMin = 0, UIMin = 0))
+	/* Number of consecutive ticks with update core failures after which the hooks are reset and the tick is disabled until the next grapple activation (0 never disables the tick)
+	*/
+	int32 MaxConsecutiveCoreFailures;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Initialization")
 	/* if true grappling hook will attempt to initialize its core components at begin play (Character owner and Cable)
 	*/
@@ -366,6 +1019,31 @@ public:
 	/* if true grappling hook will attempt to initialize its non core components at begin play (Audio component, Physics Constraint and Physics Handle)
 	*/
 	bool bInitializeNonCoreOnBeginPlay;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Initialization")
+	/* if true and no swing constraint or pull handle is set, one is leased from the world physics pool while swinging or pulling and returned afterwards
+	*/
+	bool bUsePhysicsPool;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Initialization|Lazy")
+	/* if true missing cables and audio component are created on first use (LaunchGrapple, sounds) and destroyed after LazyIdleTime with all hooks ready.
+	* Physics handles and constraints are leased on use when bUsePhysicsPool is set
+	*/
+	bool bLazySubobjects;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Initialization|Lazy", meta = (ClampMin = 0.f, UIMin = 0.f))
+	/* Time all hooks must stay ready before the lazily created subobjects are destroyed (0 keeps them)
+	*/
+	float LazyIdleTime;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Initialization|Lazy")
+	/* Class of the cables created by the lazy mode (use a Blueprint subclass to configure them)
+	*/
+	TSubclassOf<UCableComponent> LazyCableClass;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Initialization|Lazy")
+	/* Socket of the owner mesh the lazy cables are attached to (the owner root component is used if the socket does not exist)
+	*/
+	FName LazyCableSocket;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Config|Initialization")
+	/* if true the begin play initialization is queued and performed during a later world update, spreading the work of mass spawns across frames (see GrapplingHook.DeferredInitializationsPerFrame)
+	*/
+	bool bDeferInitialization;
 protected:
 	virtual void BeginPlay() override;
 
@@ -373,9 +1051,49 @@ public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	UFUNCTION(BlueprintCallable, Category = "Config|Grapple")
-	/* Detaches the grappled object (if any)
+	/* Detaches the grappled objects (if any)
 	*/
 	void DetachGrappledObject();
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Stats")
+	/* Returns true if HookClass is loaded and hooks can be spawned
+	*/
+	bool IsHookClassLoaded() const;
+	UFUNCTION(BlueprintCallable, Category = "Config|Stats")
+	/* Sets the projectile hook class used and starts its async load
+	*/
+	void SetHookClass(const TSoftClassPtr<AProjectileHook>& InHookClass);
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Debug")
+	/* Returns an estimate of the memory (bytes) not allocated by this component because its subobjects are currently lazily released or pooled
+	*/
+	int32 GetLazyMemorySaved() const;
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Debug")
+	/* Returns the lease counters of the physics pool of this component world
+	*/
+	FGrapplingHookPhysicsPoolStats GetPhysicsPoolStats() const;
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Initialization")
+	/* Returns true if the begin play initialization was deferred and has not been performed yet
+	*/
+	bool IsInitializationPending() const;
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple|Retract")
+	/* Returns the easing curve used by the retract phase
+	*/
+	UCurveFloat* GetRetractCurve() const;
+	UFUNCTION(BlueprintCallable, Category = "Config|Grapple|Retract")
+	/* Sets the easing curve used by the retract phase and bakes it (nullptr for a linear retract)
+	*/
+	void SetRetractCurve(UCurveFloat* const InCurve);
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple")
+	/* Returns the number of hooks managed by this component
+	*/
+	int32 GetHookCount() const;
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple")
+	/* Returns the cable used by the given hook
+	*/
+	UCableComponent* GetHookCable(const int32 HookIndex) const;
+	UFUNCTION(BlueprintCallable, Category = "Config|Initialization")
+	/* Sets the cable used by the given hook (the cable of the first hook is set by Initialize)
+	*/
+	void SetHookCable(const int32 HookIndex, UCableComponent* const InCable);
 	UFUNCTION(BlueprintCallable, Category = "Config|Flags")
 	/* Adds the given Flags to the current Activation flag, which determines which features are enabled
 	*/
@@ -409,9 +1127,9 @@ public:
 	*/
 	void SetActivationFlag(const EGrapplingHookActivation InFlags);
 	UFUNCTION(BlueprintCallable, Category = "Config|Initialization")
-	/* Sets the core components of the grappling hook (minimum requirement to function)
+	/* Sets the core components of the grappling hook (minimum requirement to function) and resizes the hooks to HookCount
 	*@param InOwner Owner of the grappling hook (all features will be based on it)
-	*@param InCable Cable component attached to hook projectile when grapple is active
+	*@param InCable Cable component attached to the first hook projectile when grapple is active
 	*/
 	void Initialize(ACharacter* const InOwner, UCableComponent* const InCable);
 	UFUNCTION(BlueprintCallable, Category = "Config|Grapple|Swing")
@@ -420,12 +1138,24 @@ public:
 	*@param bInAccelChange If true the accumulated swinging force from now on will be considered as an acceleration change
 	*/
 	void AddSwingingForce(const FVector& Force, const bool bInAccelChange);
+	UFUNCTION(BlueprintCallable, Category = "Config|Grapple|Swing")
+	/* Accumulates reel input applied to all the swinging ropes this tick (then resetted). Ropes are reeled every physics substep without rebuilding the swing constraint
+	*@param Input Positive values reel in (up to ReelInSpeed at 1), negative values reel out (up to ReelOutSpeed at -1)
+	*/
+	void ReelRope(const float Input);
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple|Swing")
+	/* Returns the current rope length of the given swinging hook (0 if it is not swinging)
+	*/
+	float GetRopeLength(const int32 HookIndex) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Debug")
 	/* Returns the error message for the given error
 	*@param Error The given error to get info about
 	*@return Error message
 	*/
 	FString GetErrorInfo(const EGrapplingHookError Error) const;
+	/* Returns the static error message for the given error (no allocation)
+	*/
+	static const TCHAR* GetErrorMessage(const EGrapplingHookError Error);
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Stats")
 	/*
 	* Calculate the velocity to be applied to the owner when in Launch mode
@@ -437,13 +1167,13 @@ public:
 	*/
 	FVector GetOwnerLaunchVelocity(const float DeltaTime, const float Speed, const FVector& TargetLocation, const FVector& StartLocation) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple")
-	/* Returns the current hook object
+	/* Returns the current hook object of the given hook
 	*/
-	AProjectileHook* GetHook() const;
+	AProjectileHook* GetHook(const int32 HookIndex = 0) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple")
-	/* Returns the current grappled object
+	/* Returns the current grappled object of the given hook
 	*/
-	UPrimitiveComponent* GetGrappledObject() const;
+	UPrimitiveComponent* GetGrappledObject(const int32 HookIndex = 0) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple|Pull")
 	/* Returns the current Pull Handle component used by pull feature
 	*/
@@ -477,64 +1207,97 @@ public:
 	*/
 	void SetNoiseInstigator(AActor* const Instigator);
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Stats")
-	/* Returns the grapple (cable) start world location
+	/* Returns the grapple (cable) start world location of the given hook
 	*/
-	FVector GetGrappleStartLocation(bool& bOutValid) const;
+	FVector GetGrappleStartLocation(bool& bOutValid, const int32 HookIndex = 0) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Stats")
-	/* Returns the grapple (cable) end world location
+	/* Returns the grapple (cable) end world location of the given hook
 	*/
-	FVector GetGrappleEndLocation(bool& bOutValid) const;
+	FVector GetGrappleEndLocation(bool& bOutValid, const int32 HookIndex = 0) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Stats")
-	/* Returns the grapple (cable) end world location with the given OffsetZPercentage added (used in Launch mode)
+	/* Returns the grapple (cable) end world location of the given hook with the given OffsetZPercentage added (used in Launch mode)
 	*/
-	FVector GetGrappleEndLocationWithLaunchOffset(bool& bOutValid) const;
+	FVector GetGrappleEndLocationWithLaunchOffset(bool& bOutValid, const int32 HookIndex = 0) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Stats")
-	/* Returns true if the grappling hook is currently active (neither ready nor disabled)
+	/* Returns true if any hook of the grappling hook is currently active (neither ready nor disabled)
 	*/
 	bool IsGrappleActive() const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Stats")
-	/* Returns the current grappling status
+	/* Returns the current grappling status of the given hook
 	*/
-	EGrapplingHookState GetCurrentState() const;
+	EGrapplingHookState GetCurrentState(const int32 HookIndex = 0) const;
 
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Stats")
-	/* Returns the current grappling hook length (it may be very different from CableComponent Length)
+	/* Returns the current grappling hook length of the given hook (it may be very different from CableComponent Length)
 	*/
-	float GetGrappleLength(bool& bOutValid) const;
+	float GetGrappleLength(bool& bOutValid, const int32 HookIndex = 0) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Stats")
-	/* Returns the current cooldown timer info
+	/* Returns the current cooldown timer info of the given hook
 	 *@param OutTimeLeft the amount of seconds left to the timer
 	 *@param OutTimeElapsed the amount of seconds passed since timer creation
 	 *@return true if timer is valid
 	*/
-	bool GetCooldownTimerInfo(float& OutTimeLeft, float& OutTimeElapsed) const;
+	bool GetCooldownTimerInfo(float& OutTimeLeft, float& OutTimeElapsed, const int32 HookIndex = 0) const;
 	UFUNCTION(BlueprintCallable, Category = "Config|Sound")
 	/* Performs a sound if possible as StartGrappleLocation and reports a noise event if enabled
 	 *@param Sound  Sound to perform
 	*/
 	void PlaySound(USoundBase* const Sound);
 	UFUNCTION(BlueprintCallable, Category = "Config|Grapple")
-	/* Processes the collision and decides which is the most appropriate new state for the grappling hook based on hit data
+	/* Processes the collision and decides which is the most appropriate new state for the given hook based on hit data
 	 *@param HitNormal Hit surface normal
 	 *@param UPrimitiveComponent Hit component
+	 *@param HookIndex Hook that landed
 	*/
-	void HookLanded(const FVector HitNormal, UPrimitiveComponent* const HitComponent);
+	void HookLanded(const FVector HitNormal, UPrimitiveComponent* const HitComponent, const int32 HookIndex = 0);
 	UFUNCTION(BlueprintCallable, Category = "Config|Inputs")
-	/* Launches the grapple by activating the extending phase if possible
+	/* Launches the first ready hook by activating the extending phase if possible, otherwise the launch is buffered (see InputBufferWindow)
 	*/
 	void LaunchGrapple();
 	UFUNCTION(BlueprintCallable, Category = "Config|Inputs")
-	/* Interrupts the grapple by activating the retracting phase if necessary
+	/* Launches the given hook by activating the extending phase if possible, otherwise the launch is buffered (see InputBufferWindow)
+	*/
+	void LaunchGrappleAt(const int32 HookIndex);
+	UFUNCTION(BlueprintCallable, Category = "Config|Inputs")
+	/* Interrupts all hooks by activating the retracting phase if necessary (a buffered launch is discarded if bStopCancelsBufferedLaunch)
 	*/
 	void StopGrapple();
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Inputs")
+	/* Returns true if a launch input is buffered and still valid
+	*/
+	bool IsLaunchBuffered() const;
+	UFUNCTION(BlueprintCallable, Category = "Config|Inputs")
+	/* Discards the buffered launch input (if any)
+	*/
+	void ClearBufferedLaunch();
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Debug")
+	/* Returns the latency between the latest launch input and the launch of its hook
+	*@param OutMilliseconds Latency in milliseconds
+	*@param OutFrames Latency in frames
+	*@return False if no launch input resulted in a launch yet
+	*/
+	bool GetLastLaunchLatency(float& OutMilliseconds, int32& OutFrames) const;
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Debug")
+	/* Returns the state hash of the latest deterministic simulation frame (see bDeterministic), machines in sync produce the same hash for the same frame
+	*@param OutFrame Number of deterministic frames simulated so far
+	*/
+	int32 GetDeterministicStateHash(int32& OutFrame) const;
+	UFUNCTION(BlueprintCallable, Category = "Config|Inputs")
+	/* Interrupts the given hook by activating the retracting phase if necessary
+	*/
+	void StopGrappleAt(const int32 HookIndex);
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple|Launch")
-	/* Returns true if grapple is in launch mode and owner is not grounded
+	/* Returns true if any hook is in launch mode and owner is not grounded
 	*/
 	bool IsOwnerLaunchingMidair() const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple|Pull")
-	/* Returns true if grappled object is a valid pullable object
+	/* Returns true if the object grappled by the given hook is a valid pullable object
+	*/
+	bool IsGrappledObjectPullable(const int32 HookIndex = 0) const;
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple|Tug")
+	/* Returns true if the object grappled by the given hook is a valid tuggable object (movable, simulating physics and too heavy to be pulled)
 	*/
-	bool IsGrappledObjectPullable() const;
+	bool IsGrappledObjectTuggable(const int32 HookIndex = 0) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple|Swing")
 	/* Returns the current swinging force
 	 *@param bOutAccelChange True if the swinging force is used as a change of acceleration
@@ -558,6 +1321,70 @@ public:
 	 *@param bTraceComplex Whetever Linetrace should track complex collisions
 	*/
 	virtual bool IsAimingHitValid(const FVector& StartLocation, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, FHitResult& OutHit, bool& bPossibleValidHit) const;
+	UFUNCTION(BlueprintCallable, Category = "Config|Aiming")
+	/* Cone sweep variant of IsAimingHitValid: rays are cast ring by ring around the aim direction (see AimAssistConeDegrees) and the best hit is returned.
+	* Hits that may result in a valid grapple are preferred, then the ones closer to the aim direction. Outer rings are not cast once a ring found a possible valid hit
+	 *return True if an object was hit
+	 *@param bPossibleValidHit True if ipotetic grapple usage may result in a valid hit
+	 *@param OutHit Best hit result
+	 *@param StartLocation Linetrace start location
+	 *@param Direction Aim direction
+	 *@param MaxDistance Linetrace max distance
+	 *@param bTraceComplex Whetever Linetrace should track complex collisions
+	*/
+	virtual bool IsAimingHitValidCone(const FVector& StartLocation, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, FHitResult& OutHit, bool& bPossibleValidHit);
+	UFUNCTION(BlueprintCallable, Category = "Config|Aiming")
+	/* Submits the aim assist cone sweep as asynchronous traces, all the rings in a single batch whose best hit is available from the next frame (see GetAimAssistHit).
+	* With bAimAssistRingByRing the aim direction is traced first, then an outer ring every frame as long as no possible valid hit was found.
+	* If the aim did not change more than AimAssistReuseDistance and AimAssistReuseDegrees since the latest sweep no trace is submitted
+	 *@param StartLocation Linetrace start location
+	 *@param Direction Aim direction
+	 *@param MaxDistance Linetrace max distance
+	 *@param bTraceComplex Whetever Linetrace should track complex collisions
+	*/
+	void RequestAimAssist(const FVector& StartLocation, const FVector& Direction, const float MaxDistance, const bool bTraceComplex);
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Aiming")
+	/* Returns the best hit of the latest completed aim assist sweep (scored as IsAimingHitValidCone)
+	 *return False if the sweep hit nothing or no sweep completed yet
+	 *@param OutHit Best hit result
+	 *@param bPossibleValidHit True if ipotetic grapple usage may result in a valid hit
+	*/
+	bool GetAimAssistHit(FHitResult& OutHit, bool& bPossibleValidHit) const;
+	UFUNCTION(BlueprintCallable, Category = "Config|Aiming")
+	/* Predicts the owner path of a grapple launched now along the given aim (see GetTrajectoryPreviewTo).
+	* The aim ray is traced asynchronously and reused while the aim is within AimAssistReuseDistance and AimAssistReuseDegrees:
+	* the preview follows the latest completed trace, one frame behind the aim (the first call returns False)
+	 *return False if the aim does not hit a valid target
+	 *@param OutPoints Predicted path, starting at the owner location
+	 *@param OutState Predicted hook state (GS_Launch or GS_Swing)
+	 *@param StartLocation Linetrace start location
+	 *@param Direction Aim direction
+	 *@param MaxDistance Linetrace max distance
+	 *@param bTraceComplex Whetever Linetrace should track complex collisions
+	*/
+	bool GetTrajectoryPreview(const FVector& StartLocation, const FVector& Direction, const float MaxDistance, const bool bTraceComplex, TArray<FVector>& OutPoints, EGrapplingHookState& OutState);
+	UFUNCTION(BlueprintCallable, Category = "Config|Aiming")
+	/* Predicts the owner path of a grapple landing on the given target, simulated with the runtime launch update and swing rope solver at the current frame time step
+	* (the deterministic owner integration in deterministic mode, the physics substeps of bSubstepSwing otherwise).
+	* The latest preview is cached: it is moved along with the owner while the owner and target stay within TrajectoryPreviewReuseDistance (relative to each other for a swing)
+	* and a launch preview is moved within TrajectoryPreviewShiftDistance
+	*@note Pull and tug depend on the grappled object and are not predicted
+	 *return False if the target can not be grappled or Owner is not set
+	 *@param TargetLocation Grapple end location (aim hit location)
+	 *@param TargetNormal Surface normal at TargetLocation
+	 *@param OutPoints Predicted path, starting at the owner location
+	 *@param OutState Predicted hook state (GS_Launch or GS_Swing)
+	*/
+	bool GetTrajectoryPreviewTo(const FVector& TargetLocation, const FVector& TargetNormal, TArray<FVector>& OutPoints, EGrapplingHookState& OutState);
+	/* Returns the path of the latest trajectory preview, without copying it (empty if the latest preview failed)
+	*/
+	const TArray<FVector>& GetTrajectoryPreviewPoints() const;
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Grapple")
+	/* Returns the collision free locations of the given hook cable contacts, from the grapple start to the grapple end (see bRopeCollision)
+	 *@param OutLocations Contact locations
+	 *@return Number of contacts
+	*/
+	int32 GetRopeContacts(TArray<FVector>& OutLocations, const int32 HookIndex = 0) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Config|Flags")
 	/* Returns true if the given Flag is present amongst the given Flags
 	 *@param Flags Collection of Flags to test
@@ -614,62 +1441,458 @@ public:
 	*@return The resulting Flag diff
 	*/
 	uint8 DiffUFlags(const uint8 First, const uint8 Second) const;
+
+	/* Captures the given hook in a snapshot (cheap enough to be taken every frame, see FGrapplingHookSnapshotRing)
+	*@return False if the hook does not exist
+	*/
+	bool CaptureHookSnapshot(const int32 HookIndex, FGrapplingHookSnapshot& OutSnapshot) const;
+	/* Rebuilds the hook, its cable and the swing/pull constraints from the given snapshot without replaying the state machine (no launch, landing or retract events).
+	 * Restoring the state the hook is already in does not allocate, leaving a state runs its exit handler
+	*@return False if the hook does not exist, the snapshot anchor was destroyed or the hook could not be spawned
+	*/
+	bool RestoreHookSnapshot(const int32 HookIndex, const FGrapplingHookSnapshot& Snapshot);
+	/* Captures all the hooks, one snapshot per hook
+	*@param OutSnapshots Snapshots written
+	*@param MaxSnapshots Maximum number of snapshots written
+	*@return Number of snapshots written
+	*/
+	int32 CaptureSnapshot(FGrapplingHookSnapshot* const OutSnapshots, const int32 MaxSnapshots) const;
+	/* Restores the hooks from the given snapshots, one snapshot per hook (see RestoreHookSnapshot)
+	*@return False if any hook could not be restored
+	*/
+	bool RestoreSnapshot(const FGrapplingHookSnapshot* const Snapshots, const int32 NumSnapshots);
+
+	/* Appends the update inputs of all the active hooks to the given batch (game thread only, used by the world update compute phase)
+	*@param DeltaTime World delta time, the owner time dilation is applied as done by the component tick
+	*/
+	void GatherUpdateBatch(const float DeltaTime, FGrapplingHookUpdateBatch& Batch);
+	/* Stores the computed update of the given hook, it will be applied during the next component tick
+	*/
+	void SetHookUpdate(const int32 HookIndex, const FGrapplingHookUpdateResult& InUpdate);
 protected:
-	/* Sends the grappling hook into disabled state and starts the cooldown. If GA_Cooldown feature is not enabled the grapple will go directly to Ready
-	*@param Cooldown  Time to wait before grapple is GS_Ready
+	/* Sends the given hook into disabled state and starts the cooldown. If GA_Cooldown feature is not enabled the hook will go directly to Ready
+	*@param HookIndex Hook to disable
+	*@param Cooldown  Time to wait before hook is GS_Ready
 	*/
-	void RestartCooldown(const float Cooldown);
-	/* Sets the given states as the current state. Invokes the state changed event if necessary
+	void RestartCooldown(const int32 HookIndex, const float Cooldown);
+	/* Sets the given states as the current state of the given hook. Invokes the state changed events if necessary
+	*@param HookIndex Hook to change
 	*@param NewState New state to be used
 	*/
-	void SetCurrentState(const EGrapplingHookState NewState);
+	void SetCurrentState(const int32 HookIndex, const EGrapplingHookState NewState);
+	/* Reports an error. OnGrappleError is broadcasted at most once every ErrorReportInterval for each error, OnGrappleErrorAggregated with the number of reports aggregated
+	*@param Error Error to report
+	*/
+	void ReportError(const EGrapplingHookError Error);
+	/* Broadcasts the given error with its pending reports
+	*/
+	void BroadcastError(const EGrapplingHookError Error);
+	/* Broadcasts the errors with pending reports whose aggregation interval is over, the timer is re-armed for the others (bound to the aggregation timer)
+	*/
+	void FlushErrors();
 
 	UFUNCTION()
-	/* Sets the grappling hook as Ready to be used
+	/* Sets all the hooks as Ready to be used
 	*/
 	void OnEnableGrapple();
+	/* Sets the given hook as Ready to be used
+	*/
+	void OnEnableHook(const int32 HookIndex);
 
-	/* Ends retract phase, activating cooldown phase if necessary
+	/* Ends retract phase of the given hook, activating cooldown phase if necessary
+	*/
+	void EndRetractPhase(const int32 HookIndex);
+	/* Interrupts the swing phase of the given hook, owner physics are restored when no hook is swinging anymore
+	*/
+	void InterruptSwing(const int32 HookIndex);
+	/* Updates the swing phase of all swinging hooks. A single swinging hook uses SwingConstraint, multiple swinging hooks are solved together in one pass
+	*/
+	void UpdateSwing(const float Deltatime);
+	/* Activates the swing phase of the given hook. Returns True if Swing was successfully activated
+	*/
+	bool ActivateSwing(const int32 HookIndex);
+	/* Binds SwingConstraint to the given hook anchor
+	*/
+	void ConstrainSwing(const int32 HookIndex);
+	/* Releases SwingConstraint from the hook using it (if any)
+	*/
+	void ReleaseSwingConstraint();
+	/* Leases a swing constraint from the world physics pool if none is set (see bUsePhysicsPool). Returns true if SwingConstraint is valid
+	*/
+	bool AcquireSwingConstraint();
+	/* Leases a pull handle from the world physics pool if none is set (see bUsePhysicsPool). Returns true if PullHandle is valid
+	*/
+	bool AcquirePullHandle();
+	/* Returns SwingConstraint to the world physics pool if it was leased
 	*/
-	void EndRetractPhase();
-	/* Interrupts the swing phase
+	void ReturnPooledSwingConstraint();
+	/* Returns PullHandle to the world physics pool if it was leased
 	*/
-	void InterruptSwing();
-	/* Updates the swing phase
+	void ReturnPooledPullHandle();
+	/* Launches the given hook if it is ready (the first ready hook if HookIndex is INDEX_NONE)
+	*@return False if no hook was ready
 	*/
-	void UpdateSwing();
-	/* Activates the swing phase. Returns True if Swing was successfully activated
+	bool TryLaunchHook(const int32 HookIndex);
+	/* Spawns the hook and activates its extending phase
 	*/
-	bool ActivateSwing();
-	/* Interrupts the pull phase
+	void LaunchHook(const int32 HookIndex);
+	/* Spawns an hook actor from the cable of the given hook (not stored in the hook)
+	*@return nullptr if the hook could not be spawned
 	*/
-	void InterruptPull();
-	/* Activates the pull feature
+	AProjectileHook* SpawnHook(const int32 HookIndex);
+	/* Re-fires the given hook if it is swinging or launching and chaining is enabled (the first one found if HookIndex is INDEX_NONE)
+	*@return False if no hook could be chained
 	*/
-	void ActivatePull();
-	/* Update the owner position in launch mode
+	bool TryChainHook(const int32 HookIndex);
+	/* Leaves the current state of the given hook and extends its hook actor again from the cable
+	*/
+	void ChainHook(const int32 HookIndex);
+	/* Cleans up the current state of the given hook as an interruption would, without retract and cooldown
+	*/
+	void LeaveHookState(const int32 HookIndex);
+	/* Starts the extending phase of the given hook, its hook actor moving from the cable
+	*/
+	void StartExtending(const int32 HookIndex);
+	/* Ends the grounded interruption if no hook is launching or swinging anymore
+	*/
+	void DisarmGroundedInterrupt();
+	/* Launches the given hook, just made ready, if a valid launch input is buffered for it
+	*/
+	void ConsumeBufferedLaunch(const int32 HookIndex);
+	/* Builds the collision responses of a launched hook from the detection configuration (BlockingObjects, HookIgnoredObjects, bHookIgnoresTraceChannels)
+	* and from the object types of the enabled features (PullableObjects, SwingableObjects)
+	*/
+	void BuildHookCollisionResponses(FCollisionResponseContainer& OutResponses) const;
+	/* Returns true if the object type of the grappled object of the given hook is in the given list (or if the list is empty)
+	*/
+	bool IsGrappledObjectTypeIn(const int32 HookIndex, const TArray<TEnumAsByte<ECollisionChannel>>& ObjectTypes) const;
+	/* Creates the cable of the given hook if it is missing (see bLazySubobjects)
+	*/
+	void CreateLazyCable(const int32 HookIndex);
+	/* Creates the audio component if it is missing (see bLazySubobjects)
+	*/
+	void CreateLazyAudio();
+	/* Schedules the destruction of the lazily created subobjects if all hooks are ready
+	*/
+	void ScheduleLazyRelease();
+	/* Destroys the lazily created subobjects if all hooks are still ready (bound to the idle timer)
+	*/
+	void OnLazyIdleTimeEnd();
+	/* Destroys all the lazily created subobjects
+	*/
+	void DestroyLazySubobjects();
+	/* Enforces the rope lengths of all the swinging hooks on the owner capsule in a single pass
+	*/
+	void SolveSwingRopes(const float Deltatime);
+	/* Fills OutRopes with the ropes of all the swinging hooks
+	*/
+	void GatherSwingRopes(const FTransform& BodyTransform, TArray<FGrapplingHookSwingRope>& OutRopes) const;
+	/* Returns the given velocity of a body constrained by the given ropes
+	*/
+	static FVector SolveSwingRopeVelocity(const FTransform& BodyTransform, const FVector& Velocity, const TArray<FGrapplingHookSwingRope>& Ropes, const float Deltatime);
+	/* Changes the length of the gathered ropes by SubstepReelSpeed, conserving the angular momentum of taut ropes being shortened
+	*/
+	void ReelSwingRopes(const FTransform& BodyTransform, FVector& InOutVelocity, const float Deltatime);
+	/* Speeds up the tangential part of the given velocity if the given rope is taut and shortened to NewLength (conserves the angular momentum around its anchor)
+	*/
+	static void ConserveReeledMomentum(const FTransform& BodyTransform, const FGrapplingHookSwingRope& Rope, const float NewLength, FVector& InOutVelocity);
+	/* Reels then solves the gathered ropes for a single step, returns the new velocity of the owner body (safe to call from the physics substeps)
+	*/
+	FVector StepSwingRopes(const FTransform& BodyTransform, const FVector& Velocity, const float Deltatime);
+	/* Stores the lengths reeled by the previous frame and latches the reel input of this frame for the substeps
+	*/
+	void BeginSwingReel();
+	/* Copies the reeled lengths of the gathered ropes back to their hooks, moves the swing constraint frame along its reeled rope and applies its speed-up (game thread only)
+	*/
+	void StoreReeledRopeLengths();
+	/* Moves the frame of SwingConstraint on the owner body by the rope length change (game thread only)
+	*/
+	void ReelSwingConstraint(const float OldLength, const float NewLength);
+	/* Returns the rope length change speed of the accumulated reel input
+	*/
+	float GetReelSpeed() const;
+	/* Physics substep callback of the owner capsule body, applies the swinging force and the rope lengths gathered this tick
+	*/
+	void SubstepSwing(float Deltatime, FBodyInstance* BodyInstance);
+	/* Returns the number of hooks currently swinging with their swing phase activated
+	*@param OutLastIndex Index of the last swinging hook found
+	*/
+	int32 GetNumSwingingHooks(int32& OutLastIndex) const;
+	/* Interrupts the pull phase of the given hook
+	*/
+	void InterruptPull(const int32 HookIndex);
+	/* Activates the pull feature for the given hook
+	*/
+	void ActivatePull(const int32 HookIndex);
+	/* Update the owner position in launch mode, combining all launching hooks
 	*/
 	void UpdateOwnerLaunch(const float Deltatime);
-	/* Update the grapple in retract mode
+	/* Returns the delta time used by the hooks update, the fixed step in deterministic mode
+	*/
+	float GetSimulationDeltaTime(const float DeltaTime) const;
+	/* Adds the given frame time to DeterministicTimeAccumulator and returns the number of deterministic steps to run this tick
+	*/
+	int32 ConsumeDeterministicSteps(const float DeltaTime);
+	/* Runs a single deterministic simulation step: hooks, owner, timers and state hash
+	*@param bFirstStep False for the further steps of a tick, whose hook updates can not come from the batched compute phase
+	*/
+	void StepDeterministic(const float StepTime, const bool bFirstStep);
+	/* Returns the time used by the gameplay windows (launch input buffer), the deterministic timers time in deterministic mode
+	*/
+	double GetSimulationTime() const;
+	/* Integrates the owner launch and swing in fixed point (deterministic mode replacement of UpdateOwnerLaunch and UpdateSwing)
+	*/
+	void UpdateDeterministicOwner(const float Deltatime);
+	/* Single step of the deterministic owner integration, shared by UpdateDeterministicOwner and the trajectory preview:
+	* the velocity is accelerated, the location moved by it, then every rope is solved (see SolveDeterministicRope)
+	*/
+	static void StepDeterministicOwner(FGrapplingHookFixedVector& InOutLocation, FGrapplingHookFixedVector& InOutVelocity, const FGrapplingHookFixedVector& Acceleration, const TArray<FGrapplingHookFixedRope>& Ropes, const FGrapplingHookFixed Step);
+	/* Stops the projectile movement of the given extending hook and seeds its deterministic flight from the hook location and forward vector
+	*/
+	void StartDeterministicHookFlight(const int32 HookIndex);
+	/* Moves the extending hooks in fixed point by a single step (deterministic mode replacement of the projectile movement), landing the blocked ones
+	* and missing the ones past BreakDistance
+	*/
+	void UpdateDeterministicHookFlight(const float Deltatime);
+	/* Stops the given hook at the given simulated location and lands it on the given component (a miss if null)
+	*/
+	void LandDeterministicHook(const int32 HookIndex, const FGrapplingHookFixedVector& Location, const FVector& HitNormal, UPrimitiveComponent* const HitComponent);
+	/* Sweeps the given component along a fixed point move with its own collision settings, ignoring the owner.
+	* If the move is blocked InOutEnd is set to the last free location found on the move by bisection (the hit location is never read back) and the quantized
+	* hit normal and component are returned, so the simulated location only depends on which queries are blocked
+	*@return True if the move is blocked
+	*/
+	bool SweepDeterministic(const UPrimitiveComponent* const Component, const FGrapplingHookFixedVector& Start, FGrapplingHookFixedVector& InOutEnd, FVector& OutHitNormal, UPrimitiveComponent*& OutHitComponent) const;
+	/* Returns the deterministic owner acceleration while swinging with the given swinging force: the force (divided by the owner mass unless bAccelChange) plus gravity
+	*/
+	FGrapplingHookFixedVector GetDeterministicSwingAcceleration(const FVector& SwingingForce) const;
+	/* Keeps the given location on the rope sphere of the given anchor, removing the outward velocity of a taut rope
+	*/
+	static void SolveDeterministicRope(FGrapplingHookFixedVector& InOutLocation, FGrapplingHookFixedVector& InOutVelocity, const FGrapplingHookFixedVector& Anchor, const FGrapplingHookFixed RopeLength);
+	/* Starts driving the owner with the deterministic simulation, seeding it from the owner current location and velocity
+	*/
+	void AcquireDeterministicOwner();
+	/* Gives the owner back to its movement component with the simulated velocity, if no hook is launching or swinging anymore
+	*/
+	void ReleaseDeterministicOwner();
+	/* Hashes the simulation state at the end of a deterministic frame
+	*/
+	void UpdateDeterministicHash();
+	/* Builds the collision queries of the aiming traces
+	*/
+	void GetAimingQueryParams(const bool bTraceComplex, FCollisionObjectQueryParams& OutObjectParams, FCollisionQueryParams& OutParams) const;
+	/* Returns the aim assist score of the given hit, lower is better: angular deviation from the aim direction in degrees, plus 180 if the hit may not result in a valid grapple
+	*/
+	float ScoreAimingHit(const FVector& StartLocation, const FVector& Direction, const FHitResult& Hit, bool& bOutPossibleValidHit) const;
+	/* Simulates TrajectoryPreview for a launch toward its target, with the same update the launching hooks use
+	*@param StartOffset Grapple start location relative to the owner location
+	*/
+	void SimulateLaunchPreview(const FVector& StartOffset);
+	/* Simulates TrajectoryPreview for a swing around its target, with the same rope solver and substeps the swinging hooks use
+	*@param StartOffset Grapple start location relative to the owner location
+	*/
+	void SimulateSwingPreview(const FVector& StartOffset);
+	/* Deterministic mode variant of SimulateLaunchPreview, integrated by StepDeterministicOwner
+	*/
+	void SimulateDeterministicLaunchPreview(const FVector& StartOffset);
+	/* Deterministic mode variant of SimulateSwingPreview, integrated by StepDeterministicOwner
+	*/
+	void SimulateDeterministicSwingPreview();
+	/* Returns the number of physics substeps the swing rope solver runs in a frame of the given duration (1 unless bSubstepSwing is set and the physics substepping is enabled)
+	*@param OutSubstepTime Duration of every substep
+	*/
+	int32 GetSwingSubsteps(const float Deltatime, float& OutSubstepTime) const;
+	/* Checks the cables of the ticking hooks against the world (see bRopeCollision)
+	*/
+	void UpdateRopeCollision();
+	/* Sweeps up to MaxSweeps spans of the given hook cable, reusing the contacts of the spans that did not move
+	*/
+	void UpdateRopeCollision(const int32 HookIndex, const int32 MaxSweeps);
+	/* Routes the rendered cable of the given hook through its rope contacts: a route cable is stretched between every two consecutive points from Start to End through the contacts.
+	* Cable is hidden from the frame while routed and shown again once there is no contact left
+	*/
+	void UpdateRopeRoute(const int32 HookIndex, const FVector& Start, const FVector& End);
+	/* Returns the route cable of the given hook at the given index, created if missing (null if it cannot be created)
+	*/
+	UCableComponent* GetRopeRouteCable(const int32 HookIndex, const int32 RouteIndex);
+	/* Hides the route cables of the given hook and renders its cable again
+	*/
+	void ClearRopeRoute(const int32 HookIndex);
+	/* Returns the number of sweeps allowed this frame to the given cable (0 if it is not swept), based on its distance from the local cameras
 	*/
-	void UpdateRetractGrapple(const float Deltatime);
-	/* Update the grappled object for Pull feature, returning True if the grapple should be interrupted
+	int32 GetRopeCollisionBudget(const UCableComponent* const Cable) const;
+	/* Clears the rope collision contacts and the rope route of the given hook and disables its cable particle collision
 	*/
-	bool UpdatePulledObject();
-	/* Initializes fields when grapple finished its extending phase
+	void ResetRopeCollision(const int32 HookIndex);
+	/* Submits the asynchronous traces of the rings of the given aim sweep (AimAssist or TrajectoryAim) not traced yet, in a single batch
 	*/
-	UPrimitiveComponent* StartActiveGrapplePhase(UPrimitiveComponent* const InGrappledObject);
-	/* Decides which state to set the grappling hook after an Hook collision
+	void SubmitAimAssistRays(FGrapplingHookAimAssist& Sweep, FTraceDelegate& Delegate);
+	/* Stores the result of an aim assist asynchronous trace. Once its ring is complete, either submits the next ring or selects the best hit
+	*/
+	void OnAimAssistTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+	/* Stores the result of the trajectory aim asynchronous trace as the TrajectoryAim selection
+	*/
+	void OnTrajectoryAimTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+	/* Update the given hook in retract mode
+	*/
+	void UpdateRetractGrapple(const int32 HookIndex, const float Deltatime);
+	/* Update the object grappled by the given hook for Pull feature, returning True if the grapple should be interrupted
+	*/
+	bool UpdatePulledObject(const int32 HookIndex, const float Deltatime);
+	/* Interrupts the tug phase of the given hook
+	*/
+	void InterruptTug(const int32 HookIndex);
+	/* Solves the two body grapple constraint between owner and the object grappled by the given hook for Tug feature, returning True if the grapple should be interrupted
+	*/
+	bool UpdateTug(const int32 HookIndex, const float Deltatime);
+	/* Anchors the grapple end of the given hook to the given component at its current location, the owner ticks after the component owner from now on
+	*/
+	void SetAnchor(const int32 HookIndex, USceneComponent* const InAnchor);
+	/* Releases the anchor of the given hook
+	*/
+	void ClearAnchor(const int32 HookIndex);
+	/* Refreshes the grapple end of all the anchored hooks (one transform per hook), moving the swing constraint anchor along
+	*/
+	void RefreshAnchors();
+	/* Initializes fields of the given hook when it finished its extending phase
+	*/
+	UPrimitiveComponent* StartActiveGrapplePhase(const int32 HookIndex, UPrimitiveComponent* const InGrappledObject);
+	/* Decides which state to set the given hook after an Hook collision
+	*@param HookIndex Hook that collided
 	*@param HitNormal Impact world normal
 	*@param InGrappledObject Impacted object
 	*@param bHit False if hit was not valid
 	*/
-	void ValutateCollision(const FVector& HitNormal, UPrimitiveComponent* const InGrappledObject, const bool bHit);
+	void ValutateCollision(const int32 HookIndex, const FVector& HitNormal, UPrimitiveComponent* const InGrappledObject, const bool bHit);
+	/* Returns true if any hook is in one of the states that need the component tick
+	*/
+	bool IsAnyHookTicking() const;
+	/* Returns true if the deterministic timer wheel has timers left to fire (it is only advanced by the deterministic steps of the tick)
+	*/
+	bool HasPendingDeterministicTimers() const;
+	/* Returns true if any hook is in the given state
+	*/
+	bool IsAnyHookInState(const EGrapplingHookState State) const;
+	/* Returns the index of the given hook actor (INDEX_NONE if not found)
+	*/
+	int32 FindHookIndex(const AProjectileHook* const InHook) const;
+	/* Returns the state machine table matching the current Activation mask, picking a new one if the mask changed
+	*/
+	const FGrapplingHookStateTable& GetStateTable();
+	/* Picks the state machine table matching the current Activation mask
+	*/
+	void RefreshStateTable();
+	/* Returns the state machine table of the given Activation mask. Common masks (all, launch only, swing + retracting + cooldown) use tables specialized at compile time
+	*/
+	static const FGrapplingHookStateTable& FindStateTable(const uint8 Mask);
+	/* Fills the given table with the handlers of the features enabled in the given Activation mask
+	*/
+	static void BuildStateTable(const uint8 Mask, FGrapplingHookStateTable& OutTable);
+	/* Returns the state machine table specialized at compile time for the given Activation mask
+	*/
+	template<uint8 Mask>
+	static const FGrapplingHookStateTable& GetSpecializedStateTable();
+	/* Enter handler of the specialized tables, disabled features are compiled out
+	*/
+	template<uint8 Mask>
+	EGrapplingHookState EnterLandedState(const int32 HookIndex, const FVector& HitNormal);
+	/* Runs the checks shared by all the update handlers of the given hook. Returns false if the hook has no update handler in its state
+	*/
+	bool BeginHookUpdate(const int32 HookIndex, const float DeltaTime);
+	/* Hooks update handler of the specialized tables, calls the update handler of every hook directly (disabled features are compiled out)
+	*/
+	template<uint8 Mask>
+	void UpdateHooksSpecialized(const float DeltaTime);
+	/* Calls the update handler of the given hook state directly, states of disabled features are routed to UpdateInvalidState at compile time
+	*/
+	template<uint8 Mask>
+	void DispatchHookUpdate(const int32 HookIndex, const float DeltaTime);
+	/* Exit handler of the specialized tables, disabled features are compiled out
+	*/
+	template<uint8 Mask>
+	void ExitHookSpecialized(const int32 HookIndex);
+	/* Hooks update handler of the non specialized tables, calls the update handler of every hook through the Update table
+	*/
+	void UpdateHooksDynamic(const float DeltaTime);
+	/* Calls the update handler of the given hook state through the Update table
+	*/
+	void DispatchHookUpdateDynamic(const int32 HookIndex, const float DeltaTime);
+	/* Exit handler of the non specialized tables, calls the exit handler of the given hook state through the Exit table
+	*/
+	void ExitHookDynamic(const int32 HookIndex);
+	/* Enter handler of the non specialized tables, tests the current Activation mask
+	*/
+	EGrapplingHookState EnterLandedStateDynamic(const int32 HookIndex, const FVector& HitNormal);
+	/* Returns the state the given hook enters after landing on a valid object with the given Activation mask (GS_Missed if none)
+	*/
+	EGrapplingHookState SelectLandedState(const int32 HookIndex, const FVector& HitNormal, const uint8 Mask);
+	/* Update handler of GS_Launch (launching hooks are combined in UpdateOwnerLaunch)
+	*/
+	void UpdateLaunchState(const int32 HookIndex, const float DeltaTime);
+	/* Update handler of GS_Pull
+	*/
+	void UpdatePullState(const int32 HookIndex, const float DeltaTime);
+	/* Update handler of GS_Tug
+	*/
+	void UpdateTugState(const int32 HookIndex, const float DeltaTime);
+	/* Update handler of GS_Swing (swinging hooks are solved together in UpdateSwing)
+	*/
+	void UpdateSwingState(const int32 HookIndex, const float DeltaTime);
+	/* Update handler of GS_Retracting
+	*/
+	void UpdateRetractState(const int32 HookIndex, const float DeltaTime);
+	/* Update handler of states that should not be active (missed hooks, disabled features), interrupts the hook
+	*/
+	void UpdateInvalidState(const int32 HookIndex, const float DeltaTime);
+	/* Exit handler of GS_Extending
+	*/
+	void ExitExtendingState(const int32 HookIndex);
+	/* Returns the parameters used by the update compute phase
+	*/
+	FGrapplingHookUpdateParams GetUpdateParams() const;
+	/* Gathers the snapshot of the given hook used by the update compute phase
+	*/
+	void GatherHookUpdateInput(const int32 HookIndex, const float DeltaTime, FGrapplingHookUpdateInput& OutInput) const;
+	/* Returns the update of the given hook for this frame. If the world compute phase did not produce it (or hook state changed since then) it is computed right away
+	*/
+	const FGrapplingHookUpdateResult& GetHookUpdate(const int32 HookIndex, const float DeltaTime);
+	UFUNCTION()
+	/* Function binded to the hooks OnHookStoppedBy event
+	*/
+	void OnHookStopped(const FVector HitNormal, UPrimitiveComponent* const HitComponent, AProjectileHook* const StoppedHook);
 	/* Reset component state, invalidating all undergoing logic
 	*/
 	void ResetComponentState();
-	UFUNCTION()
+	/* Returns the timer wheel of the current world used for all grapple timers (nullptr if no world was found), the component own deterministic timers in deterministic mode
+	*/
+	FGrapplingHookTimerWheel* GetTimerWheel() const;
 	/* Checks whetever the owner is grounded while Launch/Swing phase is active. If it is the case then the grapple will be interrupted
 	*/
 	void OnCheckGrounded();
+	/* Runs the grounded check after grapple activation, unless the grace period is not over yet (the check is then performed at its end)
+	*/
+	void OnGroundedCheckDelayEnd();
+	/* Ends the grounded interruption grace period, from now on owner landing will interrupt Launch/Swing
+	*/
+	void OnGroundedGracePeriodEnd();
+	/* Interrupts Launch/Swing if the grounded interruption is armed
+	*/
+	void InterruptOnGrounded();
+	/* Interrupts all the hooks in Launch/Swing state
+	*/
+	void InterruptLaunchAndSwing();
+	/* Binds the landed and movement mode changed events of the current Owner
+	*/
+	void BindOwnerEvents();
+	/* Unbinds the events previously bound to the owner
+	*/
+	void UnbindOwnerEvents();
+	UFUNCTION()
+	/* Function binded to Owner LandedDelegate
+	*/
+	void OnOwnerLanded(const FHitResult& Hit);
+	UFUNCTION()
+	/* Function binded to Owner MovementModeChangedDelegate
+	*/
+	void OnOwnerMovementModeChanged(ACharacter* Character, EMovementMode PrevMovementMode, uint8 PreviousCustomMode);
 };
@@ -0,0 +1,97 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UClass;
+class UActorComponent;
+class UAudioComponent;
+class UCableComponent;
+class UPhysicsHandleComponent;
+class UPhysicsConstraintComponent;
+
+/*
+* Owner components used by a grappling hook component when it is initialized at begin play
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookOwnerComponents
+{
+	FGrapplingHookOwnerComponents();
+
+	/* Cable components of the owner, in component order
+	*/
+	TArray<UCableComponent*> Cables;
+	/* First audio component of the owner
+	*/
+	UAudioComponent* Audio;
+	/* First physics handle component of the owner
+	*/
+	UPhysicsHandleComponent* Handle;
+	/* First physics constraint component of the owner
+	*/
+	UPhysicsConstraintComponent* Constraint;
+};
+
+/*
+* Caches where the owner components of a grappling hook component are, per owning actor class and grappling hook component name.
+* The first actor of a class is scanned, the following ones resolve their components with a direct lookup in the owned components set.
+* Cached entries are validated (component count, name and class) so actors whose components differ from the cached layout are scanned again
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookComponentCache
+{
+public:
+	/* Fills OutComponents with the components of the given owner
+	*@param GrapplerName Name of the grappling hook component (its template name for components created by the actor class)
+	*/
+	void Resolve(const AActor* const Owner, const FName GrapplerName, FGrapplingHookOwnerComponents& OutComponents);
+	/* Removes all cached entries
+	*/
+	void Reset();
+
+private:
+	/* Position of a component inside the owned components set of an actor
+	*/
+	struct FSlot
+	{
+		FSlot()
+			: Index(INDEX_NONE)
+		{
+		}
+		FSlot(const int32 InIndex, const FName InName)
+			: Index(InIndex)
+			, Name(InName)
+		{
+		}
+
+		int32 Index;
+		FName Name;
+	};
+	/* Positions of the owner components of an actor class
+	*/
+	struct FLayout
+	{
+		FLayout()
+			: NumComponents(0)
+		{
+		}
+
+		int32 NumComponents;
+		TArray<FSlot> Cables;
+		FSlot Audio;
+		FSlot Handle;
+		FSlot Constraint;
+	};
+
+	/* Resolves the components from a cached layout, returns false if the layout does not match the components
+	*/
+	static bool ResolveLayout(const FLayout& Layout, const TSet<UActorComponent*>& Components, FGrapplingHookOwnerComponents& OutComponents);
+	/* Scans the components, filling both the layout and OutComponents
+	*/
+	static void BuildLayout(const TSet<UActorComponent*>& Components, FLayout& OutLayout, FGrapplingHookOwnerComponents& OutComponents);
+	/* Returns the component in the given slot if it is still of the given class, nullptr otherwise
+	*/
+	static UActorComponent* GetSlotComponent(const FSlot& Slot, const TSet<UActorComponent*>& Components, const UClass* const Class, bool& bOutValid);
+
+	TMap<TPair<const UClass*, FName>, FLayout> Layouts;
+};
@@ -0,0 +1,98 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCurveFloat;
+
+/*
+* 16.16 fixed point clock used by the retract phase. The clock goes from 0 to One over the retract duration
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookRetractClock
+{
+	static const uint32 FracBits = 16;
+	static const uint32 One = 1u << FracBits;
+
+	/* Returns the clock rate (units per second) of a phase with the given duration
+	*/
+	static FORCEINLINE float GetRate(const float Duration)
+	{
+		return static_cast<float>(One) / FMath::Max(Duration, KINDA_SMALL_NUMBER);
+	}
+	/* Returns the given clock advanced by DeltaTime, saturated at One. The step is rounded, a truncated step would make every retract slower than its duration
+	*/
+	static FORCEINLINE uint32 Advance(const uint32 Clock, const float Rate, const float DeltaTime)
+	{
+		const float Step = Rate * DeltaTime;
+		const uint32 Left = One - FMath::Min(Clock, One);
+		return Step >= static_cast<float>(Left) ? One : Clock + static_cast<uint32>(FMath::RoundToInt(FMath::Max(Step, 0.f)));
+	}
+};
+
+/*
+* Easing curve baked in a small lookup table, evaluated with a single lerp between two samples.
+* Without a curve the easing is linear and no table is read
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookEasingTable
+{
+	static const uint32 SampleBits = 5;
+	static const int32 NumSamples = 1 << SampleBits;
+
+	FGrapplingHookEasingTable();
+
+	/* Samples the given curve over its time range (a null curve resets the table to linear easing)
+	*/
+	void Bake(const UCurveFloat* const Curve);
+	/* Returns the curve the table was baked from (nullptr if linear)
+	*/
+	const UCurveFloat* GetBakedCurve() const;
+
+	/* Returns the eased alpha at the given retract clock
+	*/
+	FORCEINLINE float Evaluate(const uint32 Clock) const
+	{
+		if (bLinear)
+		{
+			return FMath::Min(Clock, FGrapplingHookRetractClock::One) * (1.f / FGrapplingHookRetractClock::One);
+		}
+		if (Clock >= FGrapplingHookRetractClock::One)
+		{
+			return Samples[NumSamples];
+		}
+		static const uint32 IndexShift = FGrapplingHookRetractClock::FracBits - SampleBits;
+		static const uint32 FracMask = (1u << IndexShift) - 1;
+		const uint32 Index = Clock >> IndexShift;
+		const float Frac = (Clock & FracMask) * (1.f / (1u << IndexShift));
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Frac);
+	}
+	/* Returns the eased alpha at the given retract clock in 16.16 fixed point, integer only (used by the deterministic simulation)
+	*/
+	FORCEINLINE int32 EvaluateFixed(const uint32 Clock) const
+	{
+		if (bLinear)
+		{
+			return static_cast<int32>(FMath::Min(Clock, FGrapplingHookRetractClock::One));
+		}
+		if (Clock >= FGrapplingHookRetractClock::One)
+		{
+			return FixedSamples[NumSamples];
+		}
+		static const uint32 IndexShift = FGrapplingHookRetractClock::FracBits - SampleBits;
+		static const uint32 FracMask = (1u << IndexShift) - 1;
+		const uint32 Index = Clock >> IndexShift;
+		const int64 Frac = Clock & FracMask;
+		//Divided rather than shifted: descending curves give a negative delta, and right shifts of negative values are implementation defined
+		return FixedSamples[Index] + static_cast<int32>(((FixedSamples[Index + 1] - static_cast<int64>(FixedSamples[Index])) * Frac) / (static_cast<int64>(1) << IndexShift));
+	}
+
+private:
+	/* Curve values at NumSamples + 1 evenly spaced times (first and last are the curve range bounds)
+	*/
+	float Samples[NumSamples + 1];
+	/* Samples in 16.16 fixed point
+	*/
+	int32 FixedSamples[NumSamples + 1];
+	const UCurveFloat* BakedCurve;
+	bool bLinear;
+};
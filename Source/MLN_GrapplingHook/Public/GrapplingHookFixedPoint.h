@@ -0,0 +1,239 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+* 48.16 fixed point scalar used by the deterministic simulation (see UGrapplingHookComponent::bDeterministic).
+* Every operation is integer only, so results are bit identical on every platform and compiler
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookFixed
+{
+	static const int32 FracBits = 16;
+	static const int64 OneRaw = int64(1) << FracBits;
+
+	FGrapplingHookFixed()
+		: Raw(0)
+	{
+	}
+
+	static FORCEINLINE FGrapplingHookFixed FromRaw(const int64 InRaw)
+	{
+		FGrapplingHookFixed Value;
+		Value.Raw = InRaw;
+		return Value;
+	}
+	/* Converts the given float, truncating toward zero (exact scaling, the result does not depend on the float environment)
+	*/
+	static FORCEINLINE FGrapplingHookFixed FromFloat(const float Value)
+	{
+		return FromRaw(static_cast<int64>(static_cast<double>(Value) * OneRaw));
+	}
+	static FORCEINLINE FGrapplingHookFixed FromInt(const int32 Value)
+	{
+		return FromRaw(static_cast<int64>(Value) * OneRaw);
+	}
+	FORCEINLINE float ToFloat() const
+	{
+		return static_cast<float>(static_cast<double>(Raw) / OneRaw);
+	}
+
+	FORCEINLINE FGrapplingHookFixed operator+(const FGrapplingHookFixed Other) const
+	{
+		return FromRaw(Raw + Other.Raw);
+	}
+	FORCEINLINE FGrapplingHookFixed operator-(const FGrapplingHookFixed Other) const
+	{
+		return FromRaw(Raw - Other.Raw);
+	}
+	FORCEINLINE FGrapplingHookFixed operator-() const
+	{
+		return FromRaw(-Raw);
+	}
+	FORCEINLINE FGrapplingHookFixed operator*(const FGrapplingHookFixed Other) const
+	{
+		return FromRaw(MulRaw(Raw, Other.Raw));
+	}
+	FORCEINLINE FGrapplingHookFixed operator/(const FGrapplingHookFixed Other) const
+	{
+		return FromRaw(DivRaw(Raw, Other.Raw));
+	}
+	FORCEINLINE FGrapplingHookFixed& operator+=(const FGrapplingHookFixed Other)
+	{
+		Raw += Other.Raw;
+		return *this;
+	}
+	FORCEINLINE FGrapplingHookFixed& operator-=(const FGrapplingHookFixed Other)
+	{
+		Raw -= Other.Raw;
+		return *this;
+	}
+	FORCEINLINE bool operator==(const FGrapplingHookFixed Other) const { return Raw == Other.Raw; }
+	FORCEINLINE bool operator!=(const FGrapplingHookFixed Other) const { return Raw != Other.Raw; }
+	FORCEINLINE bool operator<(const FGrapplingHookFixed Other) const { return Raw < Other.Raw; }
+	FORCEINLINE bool operator<=(const FGrapplingHookFixed Other) const { return Raw <= Other.Raw; }
+	FORCEINLINE bool operator>(const FGrapplingHookFixed Other) const { return Raw > Other.Raw; }
+	FORCEINLINE bool operator>=(const FGrapplingHookFixed Other) const { return Raw >= Other.Raw; }
+
+	static FORCEINLINE FGrapplingHookFixed Min(const FGrapplingHookFixed A, const FGrapplingHookFixed B)
+	{
+		return A.Raw < B.Raw ? A : B;
+	}
+	static FORCEINLINE FGrapplingHookFixed Max(const FGrapplingHookFixed A, const FGrapplingHookFixed B)
+	{
+		return A.Raw > B.Raw ? A : B;
+	}
+	static FORCEINLINE FGrapplingHookFixed Clamp(const FGrapplingHookFixed Value, const FGrapplingHookFixed MinValue, const FGrapplingHookFixed MaxValue)
+	{
+		return Min(Max(Value, MinValue), MaxValue);
+	}
+	/* Square root (0 for negative values)
+	*/
+	static FGrapplingHookFixed Sqrt(const FGrapplingHookFixed Value);
+	/* Cosine of an angle in degrees, evaluated with a polynomial (no trigonometric function of the platform is used)
+	*/
+	static FGrapplingHookFixed CosDegrees(const FGrapplingHookFixed Degrees);
+
+	/* Product of two raw values, truncated toward zero. Computed on the magnitudes (right shifts of negative values are implementation defined)
+	* and split so that the intermediate products stay in 64 bits for world scale values
+	*/
+	static FORCEINLINE int64 MulRaw(const int64 A, const int64 B)
+	{
+		const uint64 UA = Magnitude(A);
+		const uint64 UB = Magnitude(B);
+		const uint64 Product = (UA >> FracBits) * UB + (((UA & (OneRaw - 1)) * UB) >> FracBits);
+		return (A < 0) != (B < 0) ? -static_cast<int64>(Product) : static_cast<int64>(Product);
+	}
+	/* Quotient of two raw values, truncated toward zero (0 if B is 0). The fractional bits are produced by long division, so no intermediate value
+	* is scaled by OneRaw and nothing overflows for any divisor
+	*/
+	static FORCEINLINE int64 DivRaw(const int64 A, const int64 B)
+	{
+		if (B == 0)
+		{
+			return 0;
+		}
+		const uint64 UA = Magnitude(A);
+		const uint64 UB = Magnitude(B);
+		uint64 Quotient = UA / UB;
+		uint64 Remainder = UA % UB;
+		for (int32 Bit = 0; Bit < FracBits; ++Bit)
+		{
+			//Remainder < UB <= 2^63, doubling it stays in 64 bits
+			Remainder <<= 1;
+			Quotient <<= 1;
+			if (Remainder >= UB)
+			{
+				Remainder -= UB;
+				Quotient |= 1;
+			}
+		}
+		return (A < 0) != (B < 0) ? -static_cast<int64>(Quotient) : static_cast<int64>(Quotient);
+	}
+	/* Absolute value of a raw value (defined for the minimum int64 too)
+	*/
+	static FORCEINLINE uint64 Magnitude(const int64 Value)
+	{
+		return Value < 0 ? uint64(0) - static_cast<uint64>(Value) : static_cast<uint64>(Value);
+	}
+
+	int64 Raw;
+};
+
+/*
+* Vector of FGrapplingHookFixed
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookFixedVector
+{
+	FGrapplingHookFixedVector()
+	{
+	}
+	FGrapplingHookFixedVector(const FGrapplingHookFixed InX, const FGrapplingHookFixed InY, const FGrapplingHookFixed InZ)
+		: X(InX)
+		, Y(InY)
+		, Z(InZ)
+	{
+	}
+
+	static FORCEINLINE FGrapplingHookFixedVector FromVector(const FVector& Vector)
+	{
+		return FGrapplingHookFixedVector(FGrapplingHookFixed::FromFloat(Vector.X), FGrapplingHookFixed::FromFloat(Vector.Y), FGrapplingHookFixed::FromFloat(Vector.Z));
+	}
+	FORCEINLINE FVector ToVector() const
+	{
+		return FVector(X.ToFloat(), Y.ToFloat(), Z.ToFloat());
+	}
+
+	FORCEINLINE FGrapplingHookFixedVector operator+(const FGrapplingHookFixedVector& Other) const
+	{
+		return FGrapplingHookFixedVector(X + Other.X, Y + Other.Y, Z + Other.Z);
+	}
+	FORCEINLINE FGrapplingHookFixedVector operator-(const FGrapplingHookFixedVector& Other) const
+	{
+		return FGrapplingHookFixedVector(X - Other.X, Y - Other.Y, Z - Other.Z);
+	}
+	FORCEINLINE FGrapplingHookFixedVector operator*(const FGrapplingHookFixed Scale) const
+	{
+		return FGrapplingHookFixedVector(X * Scale, Y * Scale, Z * Scale);
+	}
+	FORCEINLINE FGrapplingHookFixedVector operator/(const FGrapplingHookFixed Scale) const
+	{
+		return FGrapplingHookFixedVector(X / Scale, Y / Scale, Z / Scale);
+	}
+	FORCEINLINE FGrapplingHookFixedVector& operator+=(const FGrapplingHookFixedVector& Other)
+	{
+		X += Other.X;
+		Y += Other.Y;
+		Z += Other.Z;
+		return *this;
+	}
+	FORCEINLINE FGrapplingHookFixedVector& operator-=(const FGrapplingHookFixedVector& Other)
+	{
+		X -= Other.X;
+		Y -= Other.Y;
+		Z -= Other.Z;
+		return *this;
+	}
+
+	static FORCEINLINE FGrapplingHookFixed DotProduct(const FGrapplingHookFixedVector& A, const FGrapplingHookFixedVector& B)
+	{
+		return A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+	}
+	FORCEINLINE FGrapplingHookFixed SizeSquared() const
+	{
+		return DotProduct(*this, *this);
+	}
+	FORCEINLINE FGrapplingHookFixed Size() const
+	{
+		return FGrapplingHookFixed::Sqrt(SizeSquared());
+	}
+
+	FGrapplingHookFixed X;
+	FGrapplingHookFixed Y;
+	FGrapplingHookFixed Z;
+};
+
+/*
+* FNV-1a hash of fixed point values, used to detect desyncs between deterministic simulations
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookStateHash
+{
+	static const uint32 Seed = 2166136261u;
+
+	/* Returns the given hash combined with the bytes of Value (little endian, independent from the platform byte order)
+	*/
+	static FORCEINLINE uint32 Combine(uint32 Hash, const int64 Value)
+	{
+		const uint64 Bits = static_cast<uint64>(Value);
+		for (int32 Byte = 0; Byte < 8; ++Byte)
+		{
+			Hash = (Hash ^ static_cast<uint32>((Bits >> (Byte * 8)) & 0xFF)) * 16777619u;
+		}
+		return Hash;
+	}
+	static FORCEINLINE uint32 Combine(const uint32 Hash, const FGrapplingHookFixedVector& Value)
+	{
+		return Combine(Combine(Combine(Hash, Value.X.Raw), Value.Y.Raw), Value.Z.Raw);
+	}
+};
@@ -0,0 +1,115 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "GrapplingHookPhysicsPool.generated.h"
+
+class AActor;
+class UWorld;
+class UPhysicsHandleComponent;
+class UPhysicsConstraintComponent;
+
+USTRUCT(BlueprintType)
+/*
+* Lease counters of a grappling hook physics pool
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookPhysicsPoolStats
+{
+	GENERATED_BODY()
+
+	FGrapplingHookPhysicsPoolStats();
+
+	UPROPERTY(BlueprintReadOnly, Category = "Config|Debug")
+	/* Swing constraints currently leased
+	*/
+	int32 ActiveConstraints;
+	UPROPERTY(BlueprintReadOnly, Category = "Config|Debug")
+	/* Swing constraints ready to be leased
+	*/
+	int32 FreeConstraints;
+	UPROPERTY(BlueprintReadOnly, Category = "Config|Debug")
+	/* Highest number of swing constraints leased at the same time
+	*/
+	int32 PeakConstraints;
+	UPROPERTY(BlueprintReadOnly, Category = "Config|Debug")
+	/* Pull handles currently leased
+	*/
+	int32 ActiveHandles;
+	UPROPERTY(BlueprintReadOnly, Category = "Config|Debug")
+	/* Pull handles ready to be leased
+	*/
+	int32 FreeHandles;
+	UPROPERTY(BlueprintReadOnly, Category = "Config|Debug")
+	/* Highest number of pull handles leased at the same time
+	*/
+	int32 PeakHandles;
+};
+
+/*
+* Swing constraints and pull handles shared by all the grappling hook components of a world.
+* Components without their own constraint or handle lease one when a swing or pull starts and return it when it ends,
+* so idle characters do not carry any physics component. Pooled components are owned by a transient actor spawned on demand
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookPhysicsPool
+{
+public:
+	explicit FGrapplingHookPhysicsPool(UWorld* const InWorld);
+
+	/* Creates free constraints and handles until the pool holds at least the given amounts (see GrapplingHook.PhysicsPool.Prewarm)
+	*/
+	void Prewarm(const int32 NumConstraints, const int32 NumHandles);
+	/* Prewarms the pool to the amounts set by GrapplingHook.PhysicsPool.Prewarm
+	*/
+	void Prewarm();
+	/* Leases a swing constraint, returns nullptr if none could be created
+	*/
+	UPhysicsConstraintComponent* LeaseConstraint();
+	/* Returns a leased swing constraint to the pool, releasing its constrained components
+	*/
+	void ReturnConstraint(UPhysicsConstraintComponent* const Constraint);
+	/* Leases a pull handle, returns nullptr if none could be created
+	*/
+	UPhysicsHandleComponent* LeaseHandle();
+	/* Returns a leased pull handle to the pool, releasing its grabbed component
+	*/
+	void ReturnHandle(UPhysicsHandleComponent* const Handle);
+	/* Returns the current lease counters
+	*/
+	FGrapplingHookPhysicsPoolStats GetStats() const;
+
+private:
+	/* Free components and lease counters of a component type
+	*/
+	template<typename ComponentType>
+	struct TEntries
+	{
+		TEntries()
+			: Active(0)
+			, Peak(0)
+		{
+		}
+
+		TArray<ComponentType*> Free;
+		int32 Active;
+		int32 Peak;
+	};
+
+	/* Returns the actor owning the pooled components, spawning it if needed
+	*/
+	AActor* GetPoolActor();
+	/* Creates and registers a new component owned by the pool actor
+	*/
+	template<typename ComponentType>
+	ComponentType* CreateComponent();
+	template<typename ComponentType>
+	ComponentType* Lease(TEntries<ComponentType>& Entries);
+	template<typename ComponentType>
+	void Return(TEntries<ComponentType>& Entries, ComponentType* const Component);
+
+	UWorld* World;
+	TWeakObjectPtr<AActor> PoolActor;
+	TEntries<UPhysicsConstraintComponent> Constraints;
+	TEntries<UPhysicsHandleComponent> Handles;
+};
@@ -0,0 +1,124 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class USceneComponent;
+class UGrapplingHookComponent;
+
+/*
+* Plain snapshot of a single hook, enough to rebuild the hook actor, its cable and the swing/pull constraints without replaying the state machine
+* (see UGrapplingHookComponent::CaptureHookSnapshot and UGrapplingHookComponent::RestoreHookSnapshot)
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookSnapshot
+{
+	/* The swing phase of the hook was already activated
+	*/
+	static const uint8 FlagActivatedSwing = 1;
+	/* The hook was anchored, the snapshot can not be restored if Anchor was destroyed since then
+	*/
+	static const uint8 FlagAnchored = 1 << 1;
+
+	FGrapplingHookSnapshot();
+
+	/* Stores the given unit direction quantized on 16 bits per axis
+	*/
+	void SetDirection(const FVector& InDirection);
+	/* Returns the stored hook direction
+	*/
+	FVector GetDirection() const;
+
+	/* Component the hook was anchored to (null if the hook was not anchored)
+	*/
+	TWeakObjectPtr<USceneComponent> Anchor;
+	/* Hook location, relative to Anchor if set, world location otherwise
+	*/
+	FVector Location;
+	/* Location of the hook when the retracting phase started
+	*/
+	FVector RetractStartLocation;
+	/* Retract clock (see FGrapplingHookRetractClock)
+	*/
+	uint32 RetractClock;
+	/* Retract clock rate of the retracting phase
+	*/
+	float RetractClockRate;
+	/* Rope length of the swinging hook
+	*/
+	float RopeLength;
+	/* Seconds left to the cooldown (0 if no cooldown was running)
+	*/
+	float CooldownRemaining;
+	/* Hook forward vector, quantized (see SetDirection)
+	*/
+	int16 Direction[3];
+	/* Hook state (EGrapplingHookState)
+	*/
+	uint8 State;
+	/* Hook state before the retracting phase (EGrapplingHookState)
+	*/
+	uint8 PreRetractingState;
+	/* Combination of the Flag constants
+	*/
+	uint8 Flags;
+
+	friend MLN_GRAPPLINGHOOK_API FArchive& operator<<(FArchive& Ar, FGrapplingHookSnapshot& Snapshot);
+};
+static_assert(sizeof(FGrapplingHookSnapshot) <= 64, "Snapshots are taken every frame, keep them in a cache line");
+
+/*
+* Fixed size ring buffer of component snapshots, one frame per capture. All the memory is allocated by Init so capturing and restoring never allocate
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookSnapshotRing
+{
+public:
+	FGrapplingHookSnapshotRing();
+
+	/* Allocates the buffer, discarding all the frames captured so far
+	*@param InNumFrames Number of frames kept, the oldest frame is overwritten once the buffer is full
+	*@param InHooksPerFrame Maximum number of hooks captured every frame (see UGrapplingHookComponent::GetHookCount)
+	*/
+	void Init(const int32 InNumFrames, const int32 InHooksPerFrame);
+	/* Discards all the frames captured so far, the buffer is kept
+	*/
+	void Reset();
+	/* Captures a new frame from the given component
+	*/
+	void Capture(const UGrapplingHookComponent& Component);
+	/* Restores the given component to a captured frame
+	*@param FramesAgo 0 restores the latest captured frame
+	*@return False if the frame was not captured or could not be fully restored
+	*/
+	bool Restore(UGrapplingHookComponent& Component, const int32 FramesAgo) const;
+	/* Restores the given component to a captured frame and discards all the frames captured after it, the next capture follows the restored frame
+	*@param FramesAgo 0 restores the latest captured frame
+	*@return False if the frame was not captured or could not be fully restored
+	*/
+	bool Rewind(UGrapplingHookComponent& Component, const int32 FramesAgo);
+	/* Returns the number of captured frames
+	*/
+	int32 Num() const;
+	/* Returns the snapshots of a captured frame (nullptr if the frame was not captured)
+	*@param FramesAgo 0 is the latest captured frame
+	*@param OutNumHooks Number of snapshots of the frame
+	*/
+	const FGrapplingHookSnapshot* GetFrame(const int32 FramesAgo, int32& OutNumHooks) const;
+
+private:
+	/* Returns the buffer index of a captured frame
+	*/
+	int32 GetFrameIndex(const int32 FramesAgo) const;
+
+	TArray<FGrapplingHookSnapshot> Snapshots;
+	/* Number of snapshots of every frame
+	*/
+	TArray<int32> FrameHooks;
+	int32 NumFrames;
+	int32 HooksPerFrame;
+	/* Buffer index of the next captured frame
+	*/
+	int32 Head;
+	int32 Count;
+};
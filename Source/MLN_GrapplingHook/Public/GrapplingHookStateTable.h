@@ -0,0 +1,72 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GrapplingHookComponent.h"
+
+/*
+* Handlers of the grappling hook state machine, indexed by EGrapplingHookState.
+* Activation features are resolved when the table is built (states of disabled features are routed to the stop handler),
+* so no Activation bit is tested while the hooks are updated. Common Activation masks use tables specialized at compile time (see UGrapplingHookComponent::FindStateTable):
+* their UpdateHooks and ExitHook handlers call the state handlers directly, with the handlers of disabled features compiled out
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookStateTable
+{
+	/* Handler executed every tick for an hook in a given state
+	*/
+	typedef void (UGrapplingHookComponent::*FUpdateHandler)(const int32 HookIndex, const float DeltaTime);
+	/* Handler executed when an hook in a given state is interrupted
+	*/
+	typedef void (UGrapplingHookComponent::*FExitHandler)(const int32 HookIndex);
+	/* Handler returning the state an hook enters after landing
+	*/
+	typedef EGrapplingHookState (UGrapplingHookComponent::*FEnterHandler)(const int32 HookIndex, const FVector& HitNormal);
+	/* Handler executed every tick to update all the hooks
+	*/
+	typedef void (UGrapplingHookComponent::*FUpdateHooksHandler)(const float DeltaTime);
+
+	static const int32 NumStates = static_cast<int32>(EGrapplingHookState::GS_MAX);
+
+	FGrapplingHookStateTable();
+
+	/* Update handler of every state (nullptr if hooks in that state are not updated)
+	*/
+	FUpdateHandler Update[NumStates];
+	/* Exit handler of every state (nullptr if nothing has to be done on interruption)
+	*/
+	FExitHandler Exit[NumStates];
+	/* Cooldown property used when the retract phase started from a given state ends (nullptr if no cooldown is used)
+	*/
+	float UGrapplingHookComponent::* Cooldown[NumStates];
+	/* True if an hook in a given state can be interrupted
+	*/
+	bool bInterruptible[NumStates];
+	/* False for the states of the features disabled in the Activation mask
+	*/
+	bool bEnabled[NumStates];
+	/* Handler updating all the hooks, once per tick
+	*/
+	FUpdateHooksHandler UpdateHooks;
+	/* Handler executed when an hook is interrupted (runs the exit handler of its state)
+	*/
+	FExitHandler ExitHook;
+	/* Handler used when an hook lands on a valid object
+	*/
+	FEnterHandler Enter;
+	/* Activation mask the table was built for
+	*/
+	uint8 Activation;
+	/* True if the table was specialized at compile time for its Activation mask
+	*/
+	bool bSpecialized;
+	/* GA_Extending feature enabled
+	*/
+	bool bExtending;
+	/* GA_Retracting feature enabled
+	*/
+	bool bRetracting;
+	/* GA_Cooldown feature enabled
+	*/
+	bool bCooldown;
+};
@@ -0,0 +1,135 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GrapplingHookComponent.h"
+
+/*
+* Fixed bucket histogram. Bucket 0 counts zero values, bucket N counts values in [2^(N-1), 2^N), the last bucket also counts all greater values
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookTelemetryHistogram
+{
+	static const int32 NumBuckets = 16;
+
+	/* Returns the bucket of the given value
+	*/
+	static FORCEINLINE int32 GetBucket(const uint32 Value)
+	{
+		return Value == 0 ? 0 : FMath::Min(static_cast<int32>(FMath::FloorLog2(Value)) + 1, NumBuckets - 1);
+	}
+
+	int64 Buckets[NumBuckets];
+	/* Number of values recorded
+	*/
+	int64 Count;
+	/* Sum of the values recorded
+	*/
+	int64 Sum;
+};
+
+/*
+* Telemetry counters, every thread recording events owns a copy of this struct (only made of int64 values so copies can be summed element wise)
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookTelemetryCounters
+{
+	static const int32 NumStates = static_cast<int32>(EGrapplingHookState::GS_MAX);
+	static const int32 NumErrors = static_cast<int32>(EGrapplingHookError::GE_MAX);
+
+	/* Time spent in each state (milliseconds)
+	*/
+	FGrapplingHookTelemetryHistogram StateTime[NumStates];
+	/* Number of times each state was entered
+	*/
+	int64 StateEnters[NumStates];
+	/* Number of times each error was reported
+	*/
+	int64 Errors[NumErrors];
+	/* Number of hooks launched
+	*/
+	int64 Launches;
+	/* Number of hooks that missed all valid targets
+	*/
+	int64 Misses;
+	/* Number of grapples broken by the break distance
+	*/
+	int64 Breaks;
+	/* Grapple length when the hook lands on a valid target (centimeters)
+	*/
+	FGrapplingHookTelemetryHistogram LaunchDistance;
+	/* Measured cooldown waits, from the start of a cooldown to the hook being ready again (milliseconds)
+	*/
+	FGrapplingHookTelemetryHistogram CooldownWait;
+	/* Latency between a launch input and the launch of its hook (milliseconds)
+	*/
+	FGrapplingHookTelemetryHistogram LaunchLatency;
+	/* Latency between a launch input and the launch of its hook (frames)
+	*/
+	FGrapplingHookTelemetryHistogram LaunchLatencyFrames;
+};
+
+/*
+* Session telemetry of all the grappling hook components, enabled with GrapplingHook.Telemetry.
+* Events are recorded in per thread counters without locks, the counters of all threads are summed and written
+* to Saved/GrapplingHook/ (JSON and/or CSV, see GrapplingHook.Telemetry.Format) every GrapplingHook.Telemetry.FlushInterval seconds and on engine pre exit
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookTelemetry
+{
+public:
+	/* Allocates the thread storage and starts the periodic flush (called by the module)
+	*/
+	static void Startup();
+	/* Waits for the pending writes and releases all counters (called by the module, the session is flushed on engine pre exit)
+	*/
+	static void Shutdown();
+	/* Returns true if events are being recorded
+	*/
+	static bool IsEnabled();
+
+	/* Records that a state was left after the given time
+	*/
+	static void RecordStateExit(const EGrapplingHookState State, const double Seconds);
+	/* Records that a state was entered
+	*/
+	static void RecordStateEnter(const EGrapplingHookState State);
+	/* Records an error report
+	*/
+	static void RecordError(const EGrapplingHookError Error);
+	/* Records an hook launch
+	*/
+	static void RecordLaunch();
+	/* Records a break
+	*/
+	static void RecordBreak();
+	/* Records the grapple length of an hook landed on a valid target
+	*/
+	static void RecordLaunchDistance(const float Distance);
+	/* Records the measured wait of a cooldown that ended
+	*/
+	static void RecordCooldown(const float Seconds);
+	/* Records the latency between a launch input and the launch of its hook
+	*/
+	static void RecordLaunchLatency(const double Seconds, const int32 Frames);
+
+	/* Writes the session counters to the telemetry files
+	*/
+	static void Flush();
+
+private:
+	/* Returns the counters of the calling thread, creating them on first use. Returns nullptr if the telemetry was not started
+	*/
+	static FGrapplingHookTelemetryCounters* GetThreadCounters();
+	/* Sums the counters of all threads
+	*/
+	static void Gather(FGrapplingHookTelemetryCounters& OutCounters);
+	static void RecordValue(FGrapplingHookTelemetryHistogram& Histogram, const uint32 Value);
+	static bool OnFlushTicker(float DeltaTime);
+	/* Flushes the session while the engine objects (enum names) are still available
+	*/
+	static void OnPreExit();
+	/* Writes the given counters to the telemetry files of the session, on a background thread
+	*/
+	static void Write(const FGrapplingHookTelemetryCounters& Counters);
+	static FString ToJson(const FGrapplingHookTelemetryCounters& Counters);
+	static FString ToCsv(const FGrapplingHookTelemetryCounters& Counters);
+};
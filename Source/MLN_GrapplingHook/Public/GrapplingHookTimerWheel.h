@@ -0,0 +1,141 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Handle to a timer scheduled in a FGrapplingHookTimerWheel
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookTimerHandle
+{
+	FGrapplingHookTimerHandle()
+		: Index(INDEX_NONE)
+		, Generation(0)
+	{
+	}
+	/* Returns true if the handle was set by a timer wheel (the timer may have expired since then)
+	*/
+	bool IsValid() const
+	{
+		return Index != INDEX_NONE;
+	}
+	/* Resets the handle, it will not refer to any timer anymore
+	*/
+	void Invalidate()
+	{
+		Index = INDEX_NONE;
+		Generation = 0;
+	}
+	bool operator==(const FGrapplingHookTimerHandle& Other) const
+	{
+		return Index == Other.Index && Generation == Other.Generation;
+	}
+	bool operator!=(const FGrapplingHookTimerHandle& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	/* Index of the timer slot inside the owning wheel
+	*/
+	int32 Index;
+	/* Generation of the timer slot when the handle was created, used to detect reused slots
+	*/
+	uint32 Generation;
+};
+
+/*
+* Hierarchical timing wheel owning the grappling hook timers (cooldowns, ground checks) of a single world.
+* Insert and cancel are O(1), expired timers are collected and fired in batch when the wheel is advanced and
+* time left/elapsed queries are a single array lookup (cheap enough to be polled every frame by HUDs)
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookTimerWheel
+{
+public:
+	/*
+	*@param InResolution Duration in seconds of a single wheel tick (timers expire with this granularity)
+	*/
+	explicit FGrapplingHookTimerWheel(const float InResolution = 0.01f);
+
+	/* Schedules a new timer
+	*@param Callback Delegate executed when the timer expires
+	*@param Delay Time in seconds before the timer expires. If not positive no timer is scheduled
+	*@param bLoop If true the timer is rescheduled with the same delay every time it expires
+	*@return Handle to the scheduled timer (invalid if no timer was scheduled)
+	*/
+	FGrapplingHookTimerHandle SetTimer(const FSimpleDelegate& Callback, const float Delay, const bool bLoop = false);
+	/* Cancels the given timer (if still active) and invalidates the handle
+	*/
+	void ClearTimer(FGrapplingHookTimerHandle& Handle);
+	/* Reschedules the given timer (if still active) to expire after the given time, keeping its callback
+	*@return False if the timer is not active or TimeLeft is not positive
+	*/
+	bool SetTimeLeft(const FGrapplingHookTimerHandle& Handle, const float TimeLeft);
+	/* Returns true if the given timer is still scheduled
+	*/
+	bool IsTimerActive(const FGrapplingHookTimerHandle& Handle) const;
+	/* Returns the given timer info
+	 *@param OutTimeLeft the amount of seconds left to the timer (-1 if timer is not active)
+	 *@param OutTimeElapsed the amount of seconds passed since timer creation (-1 if timer is not active)
+	 *@return true if timer is active
+	*/
+	bool GetTimerInfo(const FGrapplingHookTimerHandle& Handle, float& OutTimeLeft, float& OutTimeElapsed) const;
+	/* Advances the wheel time, firing all the expired timers
+	*/
+	void Advance(const float DeltaTime);
+	/* Returns the number of currently scheduled timers
+	*/
+	int32 GetNumActiveTimers() const;
+	/* Returns the wheel time in seconds
+	*/
+	double GetTime() const;
+
+private:
+	static const int32 SlotBits = 6;
+	static const int32 SlotsPerLevel = 1 << SlotBits;
+	static const int32 NumLevels = 4;
+
+	struct FTimer
+	{
+		FTimer()
+			: StartTime(0.0)
+			, ExpireTime(0.0)
+			, Interval(0.f)
+			, ExpireTick(0)
+			, Prev(INDEX_NONE)
+			, Next(INDEX_NONE)
+			, Slot(INDEX_NONE)
+			, Generation(0)
+			, bActive(false)
+		{
+		}
+
+		FSimpleDelegate Callback;
+		double StartTime;
+		double ExpireTime;
+		float Interval;
+		uint64 ExpireTick;
+		int32 Prev;
+		int32 Next;
+		int32 Slot;
+		uint32 Generation;
+		bool bActive;
+	};
+
+	double GetMaxDelay() const;
+	int32 AllocateTimer();
+	void ReleaseTimer(const int32 Index);
+	bool IsHandleActive(const FGrapplingHookTimerHandle& Handle) const;
+	void Schedule(const int32 Index, const uint64 MinTick);
+	void Link(const int32 Index, const int32 Slot);
+	void Unlink(const int32 Index);
+	void Cascade(const int32 Level);
+
+	TArray<FTimer> Timers;
+	TArray<int32> FreeTimers;
+	TArray<FGrapplingHookTimerHandle> Expired;
+	int32 Slots[NumLevels * SlotsPerLevel];
+	double Now;
+	uint64 CurrentTick;
+	float Resolution;
+	int32 NumActiveTimers;
+};
@@ -0,0 +1,54 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+* Predicted owner path of a launch or swing kept as a compact polyline, with the inputs it was simulated from (see UGrapplingHookComponent::GetTrajectoryPreview).
+* Every point stores the weight of the owner start location on it: paths linear in the start and target locations (launch) can be moved to new ones without simulating again
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookTrajectory
+{
+public:
+	FGrapplingHookTrajectory();
+
+	/* Discards the path and stores the inputs of the next simulation
+	*@param InState Predicted hook state (EGrapplingHookState)
+	*/
+	void Reset(const uint8 InState, const FVector& InOwnerLocation, const FVector& InOwnerVelocity, const FVector& InTarget, const float InTimeStep);
+	/* Discards the path, the next preview simulates again
+	*/
+	void Invalidate();
+	/* Appends a simulated point
+	*@param StartWeight Weight of the owner start location on the point (1 for the start point itself)
+	*@param MinSpacing Points closer than this to the last point are skipped, unless bForce
+	*/
+	void AddPoint(const FVector& Point, const float StartWeight, const float MinSpacing, const bool bForce);
+	/* Moves the path to new start and target locations: every point moves by StartWeight of the start delta and by the rest of the target delta
+	*/
+	void Shift(const FVector& InOwnerLocation, const FVector& InTarget);
+	/* Sets the simulated time covered by the path
+	*/
+	void SetDuration(const float InDuration);
+
+	bool IsValid() const;
+	uint8 GetState() const;
+	const FVector& GetOwnerLocation() const;
+	const FVector& GetOwnerVelocity() const;
+	const FVector& GetTarget() const;
+	float GetTimeStep() const;
+	float GetDuration() const;
+	const TArray<FVector>& GetPoints() const;
+
+private:
+	TArray<FVector> Points;
+	TArray<float> StartWeights;
+	FVector OwnerLocation;
+	FVector OwnerVelocity;
+	FVector Target;
+	float TimeStep;
+	float Duration;
+	uint8 State;
+	bool bValid;
+};
@@ -0,0 +1,143 @@
+// Copyright 2018 Matteo Lorenzo Nasci
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "GrapplingHookTimerWheel.h"
+#include "GrapplingHookComponent.h"
+#include "GrapplingHookComponentCache.h"
+#include "GrapplingHookPhysicsPool.h"
+#include "GrapplingHookWorldData.generated.h"
+
+class UWorld;
+class FGrapplingHookWorldData;
+
+/*
+* Flat arrays of the hook snapshots gathered from all the grappling hook components of a world and the results computed from them
+*/
+struct MLN_GRAPPLINGHOOK_API FGrapplingHookUpdateBatch
+{
+	/* Resets all arrays, keeping their memory
+	*/
+	void Reset();
+
+	/* Components gathered (same indices as Params)
+	*/
+	TArray<UGrapplingHookComponent*> Components;
+	/* Update parameters of each component gathered
+	*/
+	TArray<FGrapplingHookUpdateParams> Params;
+	/* Snapshot of every active hook
+	*/
+	TArray<FGrapplingHookUpdateInput> Inputs;
+	/* Result computed for every snapshot (same indices as Inputs)
+	*/
+	TArray<FGrapplingHookUpdateResult> Results;
+};
+
+USTRUCT()
+/*
+* Tick function used to update the grappling hook world services once per frame
+*/
+struct FGrapplingHookWorldTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	FGrapplingHookWorldTickFunction()
+		: Target(nullptr)
+	{
+	}
+
+	/* World data updated by this tick function
+	*/
+	FGrapplingHookWorldData* Target;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+template<>
+struct TStructOpsTypeTraits<FGrapplingHookWorldTickFunction> : public TStructOpsTypeTraitsBase2<FGrapplingHookWorldTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/*
+* Services shared by all the grappling hook components of a world (one instance per world, created on demand)
+*/
+class MLN_GRAPPLINGHOOK_API FGrapplingHookWorldData
+{
+public:
+	explicit FGrapplingHookWorldData(UWorld* const InWorld);
+	~FGrapplingHookWorldData();
+
+	/* Returns the data of the given world, creating it if necessary (unless the world is being torn down). Returns nullptr if World is not valid
+	*/
+	static FGrapplingHookWorldData* Get(UWorld* const World);
+	/* Returns the data of the given world if it was already created
+	*/
+	static FGrapplingHookWorldData* Find(const UWorld* const World);
+	/* Destroys the data of the given world (bound to world cleanup by the module)
+	*/
+	static void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	/* Destroys the data of all worlds
+	*/
+	static void ReleaseAll();
+
+	/* Returns the timer wheel used by all grapple cooldowns and checks of this world
+	*/
+	FGrapplingHookTimerWheel& GetTimerWheel();
+	/* Returns the cache of the owner components used by the grappling hook components of this world
+	*/
+	FGrapplingHookComponentCache& GetComponentCache();
+	/* Returns the pool of swing constraints and pull handles shared by the grappling hook components of this world
+	*/
+	FGrapplingHookPhysicsPool& GetPhysicsPool();
+	/* Returns the time spent by the last update compute phase (seconds, 0 if no hook was active)
+	*/
+	double GetLastComputeSeconds() const;
+	/* Queues the begin play initialization of the given component, performed by the world tick within a per frame budget (see GrapplingHook.DeferredInitializationsPerFrame)
+	*/
+	void QueueInitialization(UGrapplingHookComponent* const Grappler);
+	/* Registers the given component to the update compute phase. Its tick will run after the world data tick
+	*/
+	void RegisterGrappler(UGrapplingHookComponent* const Grappler);
+	/* Removes the given component from the update compute phase and from the initialization queue
+	*/
+	void UnregisterGrappler(UGrapplingHookComponent* const Grappler);
+	/* Updates all world services
+	*/
+	void Tick(const float DeltaTime);
+
+private:
+	/* Initializes the queued components, up to the per frame budget
+	*/
+	void UpdatePendingInitializations();
+	/* Gathers the snapshots of all registered components, computes their updates (in parallel on the task graph) and hands the results back to the components
+	*/
+	void UpdateGrapplers(const float DeltaTime);
+
+	UWorld* World;
+	FGrapplingHookWorldTickFunction TickFunction;
+	FGrapplingHookTimerWheel TimerWheel;
+	FGrapplingHookComponentCache ComponentCache;
+	FGrapplingHookPhysicsPool PhysicsPool;
+	/* Components waiting for their deferred initialization, in queue order (entries before PendingInitializationsHead were already dequeued)
+	*/
+	TArray<UGrapplingHookComponent*> PendingInitializations;
+	/* Index of the next component to initialize in PendingInitializations, the dequeued entries are removed once per frame
+	*/
+	int32 PendingInitializationsHead;
+	/* Components registered to the update compute phase
+	*/
+	TArray<UGrapplingHookComponent*> Grapplers;
+	/* Batch reused every frame by the update compute phase
+	*/
+	FGrapplingHookUpdateBatch Batch;
+	/* Time spent by the last update compute phase (seconds)
+	*/
+	double LastComputeSeconds;
+};
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogGrapplingHook, Log, All);
+
 class FMLN_GrapplingHookModule : public IModuleInterface
 {
 public:
@@ -12,4 +14,8 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	/** Handle to the world cleanup binding used to release per world grappling hook data */
+	FDelegateHandle WorldCleanupHandle;
 };
@@ -6,7 +6,9 @@
 #include "GameFramework/Actor.h"
 #include "ProjectileHook.generated.h"
 
+class AProjectileHook;
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHookStopped, FVector, HitNormal, UPrimitiveComponent*, HitComponent);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnHookStoppedBy, FVector, HitNormal, UPrimitiveComponent*, HitComponent, AProjectileHook*, Hook);
 
 class UProjectileMovementComponent;
 class UCableComponent;
@@ -27,6 +29,10 @@ public:
 	/* Event invoked when the Hook hit a valid object
 	*/
 	FOnHookStopped OnHookStopped;
+	UPROPERTY(BlueprintAssignable, Category = "Config|Dispatchers")
+	/* Same as OnHookStopped, with the hook that stopped (used by components managing multiple hooks)
+	*/
+	FOnHookStoppedBy OnHookStoppedBy;
 
 	float MaxDistance;
 
@@ -49,6 +55,15 @@ public:
 	/* Manually interrupts the projectile movement, optionally launching the OnHookStopped event
 	*/
 	virtual void InterruptProjectileMovement(const bool bLaunchStoppedEvent = false);
+	/* Moves the hook to the given transform and restarts its projectile movement along its forward vector (used to re-fire an hook already spawned)
+	*/
+	virtual void RestartProjectileMovement(const FTransform& Transform);
+	/* Stops the hook at the given transform as if it landed there, attaching it to the given component if any (used to restore a landed hook)
+	*/
+	virtual void PlaceStopped(const FTransform& Transform, USceneComponent* const Parent);
+	/* Sets the collision responses of the hook, the ignored actor is never hit while moving
+	*/
+	virtual void SetHookCollision(const FCollisionResponseContainer& Responses, AActor* const IgnoredActor);
 	virtual void Destroyed() override;
 protected:
 	UFUNCTION()